@@ -0,0 +1,161 @@
+/**
+ * @file examples/benchmarks/bench_broker_fanout.cpp
+ * @brief Publish fan-out of the broker's `TopicManagerActor`.
+ *
+ * @details
+ * The real `TopicManagerActor` runs on core 1, between two stand-ins for the
+ * `ServerActor`s of the broker:
+ *
+ * - `PublisherActor` (core 0) publishes `PublishEvent`s with a 64-byte body on one
+ *   topic, as a `ServerActor` does for a client's PUBLISH.
+ * - `SinkActor`s (core 2) subscribe their sessions to the topic, then count the
+ *   `SendMessageEvent`s the topic manager sends them.
+ *
+ * `broker/publish_fanout/subs:<N>` measures the time from the first publish to the last
+ * delivery of the last publish, with N subscribed sessions spread over up to four sinks.
+ * One iteration is one publish; the items are the deliveries. Subscription and engine
+ * start-up are not timed. Each QB core is pinned to the CPU of the same id, so the
+ * three cores do not share the harness's `--cpu`.
+ */
+
+#include <harness/Bench.h>
+#include <qb/main.h>
+#include <qb/uuid.h>
+#include "../core_io/message_broker/server/TopicManagerActor.h"
+
+namespace {
+
+const std::string TOPIC = "bench";
+
+struct SinkReadyEvent : public qb::Event {};
+struct SinkDoneEvent : public qb::Event {};
+
+/// Shared with the main thread, read after engine.join()
+struct Run {
+    double seconds = 0;
+    uint64_t deliveries = 0;
+};
+
+class SinkActor : public qb::Actor {
+    qb::ActorId _topic_manager;
+    qb::ActorId _publisher;
+    std::size_t _sessions;
+    uint64_t _expected;
+    std::size_t _responses = 0;
+    uint64_t _messages = 0;
+
+public:
+    SinkActor(qb::ActorId topic_manager, qb::ActorId publisher, std::size_t sessions, uint64_t publishes)
+        : _topic_manager(topic_manager), _publisher(publisher), _sessions(sessions),
+          _expected(publishes * sessions) {}
+
+    bool onInit() override {
+        registerEvent<SendMessageEvent>(*this);
+        for (std::size_t i = 0; i < _sessions; ++i)
+            push<SubscribeEvent>(_topic_manager, qb::generate_random_uuid(),
+                                 broker::Message(broker::MessageType::SUBSCRIBE, TOPIC));
+        return true;
+    }
+
+    void on(SendMessageEvent& evt) {
+        if (evt.message_data.type() != broker::MessageType::MESSAGE) {
+            if (++_responses == _sessions) push<SinkReadyEvent>(_publisher);
+        } else if (++_messages == _expected) {
+            push<SinkDoneEvent>(_publisher);
+            kill();
+        }
+    }
+};
+
+class PublisherActor : public qb::Actor {
+    qb::ActorId _topic_manager;
+    std::size_t _sinks;
+    uint64_t _publishes;
+    uint64_t _deliveries;
+    Run& _run;
+    qb::uuid _session = qb::generate_random_uuid();
+    std::size_t _ready = 0;
+    std::size_t _done = 0;
+    std::chrono::steady_clock::time_point _start;
+
+public:
+    PublisherActor(qb::ActorId topic_manager, std::size_t sinks, uint64_t publishes,
+                   uint64_t deliveries, Run& run)
+        : _topic_manager(topic_manager), _sinks(sinks), _publishes(publishes),
+          _deliveries(deliveries), _run(run) {}
+
+    bool onInit() override {
+        registerEvent<SinkReadyEvent>(*this);
+        registerEvent<SinkDoneEvent>(*this);
+        registerEvent<CreditEvent>(*this);
+        return true;
+    }
+
+    // Publishes all at once: the credits returned by the topic manager are not needed
+    void on(CreditEvent&) {}
+
+    void on(SinkReadyEvent&) {
+        if (++_ready < _sinks) return;
+        _start = std::chrono::steady_clock::now();
+        const std::string body(64, 'x');
+        for (uint64_t i = 0; i < _publishes; ++i) {
+            // Same layout as a parsed PUBLISH: "topic body", with views into the payload
+            broker::MessageContainer container(broker::MessageType::PUBLISH, TOPIC + " " + body);
+            auto payload = container.payload();
+            push<PublishEvent>(_topic_manager, _session, std::move(container),
+                               payload.substr(0, TOPIC.size()), payload.substr(TOPIC.size() + 1));
+        }
+    }
+
+    void on(SinkDoneEvent&) {
+        if (++_done < _sinks) return;
+        _run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        _run.deliveries = _deliveries;
+        push<qb::KillEvent>(_topic_manager);
+        kill();
+    }
+};
+
+void fanout(bench::State& state, std::size_t subscribers) {
+    state.pause();
+    const uint64_t publishes = state.iterations();
+    const std::size_t sinks = std::min<std::size_t>(subscribers, 4);
+    Run run;
+
+    qb::Main engine;
+    auto topic_manager = engine.addActor<TopicManagerActor>(1);
+    auto publisher = engine.addActor<PublisherActor>(0, topic_manager, sinks, publishes,
+                                                     publishes * subscribers, run);
+    for (std::size_t i = 0; i < sinks; ++i) {
+        // Sessions spread evenly, the first sinks taking the remainder
+        std::size_t sessions = subscribers / sinks + (i < subscribers % sinks ? 1 : 0);
+        engine.addActor<SinkActor>(2, topic_manager, publisher, sessions, publishes);
+    }
+    // Core threads inherit the harness pinning; the run is timed manually, so the
+    // calling thread can stay unpinned
+    bench::unpinThread();
+    for (qb::CoreId core : {0, 1, 2})
+        engine.core(core).setAffinity({core});
+    engine.start();
+    engine.join();
+
+    if (run.deliveries != publishes * subscribers) {
+        state.fail("engine stopped before all deliveries");
+        return;
+    }
+    state.setManualTime(run.seconds);
+    state.setItems(run.deliveries);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Suite suite("broker_fanout");
+    for (std::size_t subscribers : {1, 16, 256}) {
+        // Each run starts an engine: a fixed number of publishes instead of calibration
+        suite.add("broker/publish_fanout/subs:" + std::to_string(subscribers),
+                  [subscribers](bench::State& state) { fanout(state, subscribers); })
+            .iterations(subscribers >= 256 ? 2000 : 20000);
+    }
+    return suite.run(argc, argv);
+}
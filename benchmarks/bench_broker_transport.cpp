@@ -0,0 +1,219 @@
+/**
+ * @file examples/benchmarks/bench_broker_transport.cpp
+ * @brief Client transports of the message broker on one host: TCP loopback, Unix domain
+ *        socket and shared-memory rings.
+ *
+ * @details
+ * The broker's actors run in-process as in `broker_server`: `AcceptActor`s on core 0
+ * (TCP, `--unix` and `--shm` sockets), the `TopicManagerActor` on core 1 and one
+ * `ServerActor` on core 2. The benchmark thread is the client, subscribed to a topic
+ * of its own on each transport, and publishes 64-byte messages on it, so every publish
+ * comes back as one `MESSAGE`.
+ *
+ * - `broker/transport/<t>/rtt`: One publish in flight. One iteration is a publish and its
+ *   delivery back to the client, so the time per iteration is the round trip through
+ *   the broker.
+ * - `broker/transport/<t>/stream`: Up to 64 publishes in flight. Items are deliveries.
+ *
+ * `<t>` is `tcp`, `uds` or `shm`. The three transports go through the same actors and
+ * events, so the differences come from the transport. The TCP port is
+ * `QB_BENCH_BROKER_PORT` (default 18081); the Unix sockets are created in `/tmp`.
+ */
+
+#include <harness/Bench.h>
+#include <qb/main.h>
+#include "../core_io/message_broker/server/AcceptActor.h"
+#include "../core_io/message_broker/server/ServerActor.h"
+#include "../core_io/message_broker/server/TopicManagerActor.h"
+#include "../core_io/message_broker/shared/ShmTransport.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t WINDOW = 64;
+constexpr int RECEIVE_TIMEOUT_MS = 2000;
+
+/// Blocking client of the broker over a TCP or Unix stream socket
+class SocketClient {
+    int _fd = -1;
+    std::string _buffer;
+    std::string _frame;
+
+public:
+    ~SocketClient() {
+        if (_fd >= 0) ::close(_fd);
+    }
+
+    bool connectTcp(uint16_t port) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (!connect(AF_INET, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)))
+            return false;
+        int one = 1;
+        ::setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        return true;
+    }
+
+    bool connectUnix(const std::string& path) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        return connect(AF_UNIX, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+
+    bool send(broker::MessageType type, std::string_view payload) {
+        const broker::MessageHeader header{broker::PROTOCOL_MAGIC, broker::PROTOCOL_VERSION,
+                                           static_cast<uint8_t>(type),
+                                           static_cast<uint32_t>(payload.size())};
+        _frame.assign(reinterpret_cast<const char*>(&header), sizeof(header));
+        _frame.append(payload);
+        return ::send(_fd, _frame.data(), _frame.size(), MSG_NOSIGNAL) ==
+               static_cast<ssize_t>(_frame.size());
+    }
+
+    bool receive(broker::Message& msg, int timeout_ms) {
+        broker::MessageHeader header;
+        while (_buffer.size() < sizeof(header))
+            if (!fill(timeout_ms)) return false;
+        std::memcpy(&header, _buffer.data(), sizeof(header));
+        while (_buffer.size() < sizeof(header) + header.length)
+            if (!fill(timeout_ms)) return false;
+        msg.type = static_cast<broker::MessageType>(header.type);
+        msg.payload.assign(_buffer, sizeof(header), header.length);
+        _buffer.erase(0, sizeof(header) + header.length);
+        return true;
+    }
+
+private:
+    bool connect(int family, const sockaddr* addr, socklen_t size) {
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            _fd = ::socket(family, SOCK_STREAM, 0);
+            if (::connect(_fd, addr, size) == 0)
+                return true;
+            ::close(_fd);
+            _fd = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));  // broker starting
+        }
+        return false;
+    }
+
+    bool fill(int timeout_ms) {
+        pollfd pfd{_fd, POLLIN, 0};
+        if (::poll(&pfd, 1, timeout_ms) <= 0) return false;
+        char chunk[16384];
+        ssize_t n = ::recv(_fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        _buffer.append(chunk, static_cast<std::size_t>(n));
+        return true;
+    }
+};
+
+template <typename Client>
+bool subscribe(Client& client, const std::string& topic) {
+    broker::Message reply;
+    return client.send(broker::MessageType::SUBSCRIBE, topic) &&
+           client.receive(reply, RECEIVE_TIMEOUT_MS) && reply.type == broker::MessageType::RESPONSE;
+}
+
+template <typename Client>
+void rtt(bench::State& state, Client& client, const std::string& topic) {
+    const std::string payload = topic + " " + std::string(64, 'x');
+    broker::Message msg;
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        if (!client.send(broker::MessageType::PUBLISH, payload) ||
+            !client.receive(msg, RECEIVE_TIMEOUT_MS) || msg.type != broker::MessageType::MESSAGE) {
+            state.fail("no delivery on " + topic);
+            return;
+        }
+    }
+    state.setItems(state.iterations());
+}
+
+template <typename Client>
+void stream(bench::State& state, Client& client, const std::string& topic) {
+    const std::string payload = topic + " " + std::string(64, 'x');
+    const uint64_t count = state.iterations();
+    broker::Message msg;
+    uint64_t sent = 0;
+    for (uint64_t received = 0; received < count; ++received) {
+        for (; sent < count && sent - received < WINDOW; ++sent) {
+            if (!client.send(broker::MessageType::PUBLISH, payload)) {
+                state.fail("cannot publish on " + topic);
+                return;
+            }
+        }
+        if (!client.receive(msg, RECEIVE_TIMEOUT_MS) || msg.type != broker::MessageType::MESSAGE) {
+            state.fail("no delivery on " + topic);
+            return;
+        }
+    }
+    state.setItems(count);
+    state.setBytes(count * payload.size());
+}
+
+bool connectShm(broker::shm::Client& client, const std::string& path) {
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        if (client.connect(path))
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));  // broker starting
+    }
+    return false;
+}
+
+uint16_t port() {
+    const char* env = std::getenv("QB_BENCH_BROKER_PORT");
+    return static_cast<uint16_t>(env ? std::atoi(env) : 18081);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string base = "/tmp/qb_bench_broker_" + std::to_string(::getpid());
+    const std::string unix_path = base + ".sock";
+    const std::string shm_path = base + "_shm.sock";
+
+    qb::Main engine;
+    auto topic_manager = engine.addActor<TopicManagerActor>(1);
+    qb::ActorIdList servers{engine.addActor<ServerActor>(2, topic_manager)};
+    engine.addActor<AcceptActor>(0, qb::io::uri{"tcp://127.0.0.1:" + std::to_string(port())}, servers);
+    engine.addActor<AcceptActor>(0, qb::io::uri{"unix://" + unix_path}, servers);
+    engine.addActor<AcceptActor>(0, qb::io::uri{"unix://" + shm_path}, servers, true);
+    engine.start();
+
+    SocketClient tcp;
+    SocketClient uds;
+    broker::shm::Client shm;
+    bool ready = tcp.connectTcp(port()) && uds.connectUnix(unix_path) && connectShm(shm, shm_path) &&
+                 subscribe(tcp, "bench.tcp") && subscribe(uds, "bench.uds") &&
+                 subscribe(shm, "bench.shm");
+
+    int rc = 1;
+    if (ready) {
+        bench::Suite suite("broker_transport");
+        suite.add("broker/transport/tcp/rtt", [&](bench::State& s) { rtt(s, tcp, "bench.tcp"); });
+        suite.add("broker/transport/uds/rtt", [&](bench::State& s) { rtt(s, uds, "bench.uds"); });
+        suite.add("broker/transport/shm/rtt", [&](bench::State& s) { rtt(s, shm, "bench.shm"); });
+        suite.add("broker/transport/tcp/stream", [&](bench::State& s) { stream(s, tcp, "bench.tcp"); });
+        suite.add("broker/transport/uds/stream", [&](bench::State& s) { stream(s, uds, "bench.uds"); });
+        suite.add("broker/transport/shm/stream", [&](bench::State& s) { stream(s, shm, "bench.shm"); });
+        rc = suite.run(argc, argv);
+    } else {
+        std::cerr << "bench_broker_transport: cannot reach the broker (port " << port()
+                  << ", " << unix_path << ", " << shm_path << ")" << std::endl;
+    }
+
+    shm.close();
+    qb::Main::stop();
+    engine.join();
+    ::unlink(unix_path.c_str());
+    ::unlink(shm_path.c_str());
+    return rc;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file examples/benchmarks/bench_file_hash.cpp
+ * @brief Content hash of the file monitor (`core_io/file_monitor/hash.h`).
+ *
+ * @details
+ * `file_hash/content/<size>` hashes an in-memory buffer of 4 KiB, 64 KiB and 1 MiB, as
+ * `FileProcessor::extractMetadata()` does for every created or modified file once it
+ * has read it. The hash is a serial dependency chain (`h = h * 31 + byte`), so its
+ * throughput is bounded by the multiply latency rather than by memory bandwidth.
+ */
+
+#include <harness/Bench.h>
+#include <hash.h>
+#include <random>
+
+int main(int argc, char* argv[]) {
+    bench::Suite suite("file_hash");
+
+    for (std::size_t size : {std::size_t(4) << 10, std::size_t(64) << 10, std::size_t(1) << 20}) {
+        std::string label = size >= (1 << 20) ? std::to_string(size >> 20) + "MiB"
+                                               : std::to_string(size >> 10) + "KiB";
+        suite.add("file_hash/content/" + label, [size](bench::State& state) {
+            state.pause();
+            std::vector<char> content(size);
+            std::mt19937 rng(7);
+            for (auto& c : content) c = static_cast<char>(rng());
+            state.resume();
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                auto hash = contentHash(content.data(), content.size());
+                bench::doNotOptimize(hash);
+            }
+            state.setItems(state.iterations());
+            state.setBytes(state.iterations() * size);
+        });
+    }
+
+    return suite.run(argc, argv);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file examples/benchmarks/bench_fsm.cpp
+ * @brief Transition dispatch of the state machine example (`core/shared/TransitionTable.h`).
+ *
+ * @details
+ * The table has the shape of the coffee machine of `example8_state_machine.cpp`:
+ * 7 states × 8 inputs, every pair with a handler. The handlers only update a counter,
+ * so the results are the cost of the lookup and of the `std::function` call.
+ *
+ * - `fsm/dispatch/cycle`: the inputs of a full order (button, coin, brew finished,
+ *   dispense finished), each moving the machine to the next state.
+ * - `fsm/dispatch/random`: pseudo-random (state, input) pairs, which defeat the branch
+ *   predictor the way a mix of machines or inputs would.
+ */
+
+#include <harness/Bench.h>
+#include <TransitionTable.h>
+#include <array>
+#include <random>
+
+namespace {
+
+enum class MachineState { IDLE, SELECTING, PAYMENT, BREWING, DISPENSING, MAINTENANCE, ERROR };
+enum class InputEvent {
+    COIN_INSERTED,
+    BUTTON_PRESSED,
+    CANCEL,
+    MAINTENANCE_KEY,
+    ERROR_DETECTED,
+    RESET,
+    BREW_FINISHED,
+    DISPENSE_FINISHED
+};
+constexpr int STATES = 7;
+constexpr int INPUTS = 8;
+
+struct Input {
+    InputEvent event;
+    double amount;
+};
+
+struct Machine {
+    TransitionTable<MachineState, InputEvent, Input> table;
+    MachineState state = MachineState::IDLE;
+    uint64_t transitions = 0;
+
+    Machine() {
+        auto to = [this](MachineState next) {
+            return [this, next](const Input&) {
+                state = next;
+                ++transitions;
+            };
+        };
+        for (int s = 0; s < STATES; ++s)
+            for (int e = 0; e < INPUTS; ++e)
+                table[static_cast<MachineState>(s)][static_cast<InputEvent>(e)] =
+                    [this](const Input&) { ++transitions; };
+        table[MachineState::IDLE][InputEvent::BUTTON_PRESSED] = to(MachineState::SELECTING);
+        table[MachineState::SELECTING][InputEvent::COIN_INSERTED] = to(MachineState::PAYMENT);
+        table[MachineState::PAYMENT][InputEvent::COIN_INSERTED] = to(MachineState::BREWING);
+        table[MachineState::BREWING][InputEvent::BREW_FINISHED] = to(MachineState::DISPENSING);
+        table[MachineState::DISPENSING][InputEvent::DISPENSE_FINISHED] = to(MachineState::IDLE);
+    }
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Suite suite("fsm");
+
+    suite.add("fsm/dispatch/cycle", [](bench::State& state) {
+        state.pause();
+        Machine machine;
+        const std::array<Input, 5> order = {{{InputEvent::BUTTON_PRESSED, 0},
+                                             {InputEvent::COIN_INSERTED, 1.0},
+                                             {InputEvent::COIN_INSERTED, 1.0},
+                                             {InputEvent::BREW_FINISHED, 0},
+                                             {InputEvent::DISPENSE_FINISHED, 0}}};
+        state.resume();
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            const auto& input = order[i % order.size()];
+            machine.table.dispatch(machine.state, input.event, input);
+        }
+        bench::doNotOptimize(machine.transitions);
+        state.setItems(state.iterations());
+    });
+
+    suite.add("fsm/dispatch/random", [](bench::State& state) {
+        state.pause();
+        Machine machine;
+        std::mt19937 rng(42);
+        std::vector<std::pair<MachineState, Input>> pairs(4096);
+        for (auto& [s, input] : pairs) {
+            s = static_cast<MachineState>(rng() % STATES);
+            input = Input{static_cast<InputEvent>(rng() % INPUTS), 1.0};
+        }
+        state.resume();
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            const auto& [s, input] = pairs[i % pairs.size()];
+            machine.table.dispatch(s, input.event, input);
+        }
+        bench::doNotOptimize(machine.transitions);
+        state.setItems(state.iterations());
+    });
+
+    return suite.run(argc, argv);
+}
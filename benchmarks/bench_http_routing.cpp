@@ -0,0 +1,180 @@
+/**
+ * @file examples/benchmarks/bench_http_routing.cpp
+ * @brief Request routing of the qbm-http server used by the `qbm/http` examples.
+ *
+ * @details
+ * A `qb::http::Server<>` actor on core 0 serves the route table of
+ * `03_basic_routing.cpp` (static, `:param` and `*wildcard` routes) plus 40 generated
+ * `/api/v1/resource<N>/items/:id` routes, so the router has a realistic number of
+ * candidates. Every handler answers a fixed 2-byte body, so the differences between the
+ * benchmarks come from routing.
+ *
+ * The benchmark thread is the client: one keep-alive connection over loopback, one
+ * request in flight. One iteration is one request and its complete response, so the
+ * absolute figures include the loopback round trip and HTTP parsing; compare routes
+ * with each other, or a route with its baseline.
+ *
+ * - `http/route/static`: `GET /api`
+ * - `http/route/param`: `GET /users/42`
+ * - `http/route/param_last`: `GET /api/v1/resource39/items/7`, registered last
+ * - `http/route/wildcard`: `GET /files/docs/guide/intro.html`
+ * - `http/route/not_found`: `GET /no/such/route`, answered 404
+ *
+ * The server listens on 127.0.0.1, port `QB_BENCH_HTTP_PORT` (default 18080).
+ */
+
+#include <harness/Bench.h>
+#include <qb/main.h>
+#include <http/http.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+class RoutingBenchServer : public qb::Actor, public qb::http::Server<> {
+    std::string _uri;
+
+public:
+    explicit RoutingBenchServer(std::string uri) : _uri(std::move(uri)) {}
+
+    bool onInit() override {
+        auto ok = [](auto ctx) {
+            ctx->response().status() = qb::http::Status::OK;
+            ctx->response().body() = "ok";
+            ctx->complete(qb::http::AsyncTaskResult::COMPLETE);
+        };
+        router().get("/", ok);
+        router().get("/api", ok);
+        router().get("/users", ok);
+        router().post("/users", ok);
+        router().get("/users/:id", ok);
+        router().put("/users/:id", ok);
+        router().del("/users/:id", ok);
+        router().get("/hello/:name", ok);
+        router().get("/search", ok);
+        router().get("/files/*path", ok);
+        for (int i = 0; i < 40; ++i)
+            router().get("/api/v1/resource" + std::to_string(i) + "/items/:id", ok);
+        router().compile();
+
+        if (!listen({_uri})) {
+            std::cerr << "bench_http_routing: cannot listen on " << _uri << std::endl;
+            return false;
+        }
+        start();
+        return true;
+    }
+};
+
+/// Blocking keep-alive HTTP/1.1 client, enough for fixed-size responses
+class Client {
+    int _fd = -1;
+    std::string _buffer;
+
+public:
+    ~Client() {
+        if (_fd >= 0) ::close(_fd);
+    }
+
+    bool connect(uint16_t port) {
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            _fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (::connect(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+                int one = 1;
+                ::setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                return true;
+            }
+            ::close(_fd);
+            _fd = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));  // server starting
+        }
+        return false;
+    }
+
+    /// Sends the request and reads its response; returns the status code, or -1
+    int request(const std::string& raw) {
+        if (::send(_fd, raw.data(), raw.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(raw.size()))
+            return -1;
+        std::size_t header_end;
+        while ((header_end = _buffer.find("\r\n\r\n")) == std::string::npos)
+            if (!fill()) return -1;
+        std::size_t body = 0;
+        auto length = _buffer.find("ontent-Length:");  // matches Content-Length and content-length
+        if (length == std::string::npos) length = _buffer.find("ontent-length:");
+        if (length != std::string::npos && length < header_end)
+            body = std::strtoul(_buffer.c_str() + length + 14, nullptr, 10);
+        while (_buffer.size() < header_end + 4 + body)
+            if (!fill()) return -1;
+        int status = std::atoi(_buffer.c_str() + 9);  // "HTTP/1.1 200"
+        _buffer.erase(0, header_end + 4 + body);
+        return status;
+    }
+
+private:
+    bool fill() {
+        char chunk[4096];
+        ssize_t n = ::recv(_fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        _buffer.append(chunk, static_cast<std::size_t>(n));
+        return true;
+    }
+};
+
+uint16_t port() {
+    const char* env = std::getenv("QB_BENCH_HTTP_PORT");
+    return static_cast<uint16_t>(env ? std::atoi(env) : 18080);
+}
+
+void route(bench::State& state, Client& client, const std::string& path, int expected) {
+    const std::string raw = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    for (uint64_t i = 0; i < state.iterations(); ++i) {
+        int status = client.request(raw);
+        if (status != expected) {
+            state.fail(path + " answered " + std::to_string(status));
+            return;
+        }
+    }
+    state.setItems(state.iterations());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    qb::Main engine;
+    engine.addActor<RoutingBenchServer>(0, "tcp://127.0.0.1:" + std::to_string(port()));
+    engine.start();
+
+    Client client;
+    if (!client.connect(port())) {
+        std::cerr << "bench_http_routing: cannot connect to 127.0.0.1:" << port() << std::endl;
+        qb::Main::stop();
+        engine.join();
+        return 1;
+    }
+
+    bench::Suite suite("http_routing");
+    const std::vector<std::tuple<std::string, std::string, int>> routes = {
+        {"http/route/static", "/api", 200},
+        {"http/route/param", "/users/42", 200},
+        {"http/route/param_last", "/api/v1/resource39/items/7", 200},
+        {"http/route/wildcard", "/files/docs/guide/intro.html", 200},
+        {"http/route/not_found", "/no/such/route", 404},
+    };
+    for (const auto& [name, path, status] : routes) {
+        suite.add(name, [&client, path = path, status = status](bench::State& state) {
+            route(state, client, path, status);
+        });
+    }
+    int rc = suite.run(argc, argv);
+
+    qb::Main::stop();
+    engine.join();
+    return rc;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file examples/benchmarks/bench_orderbook.cpp
+ * @brief Matching engine order book of the trading example (`core/shared/OrderBook.h`).
+ *
+ * @details
+ * Every benchmark starts from a book with `DEPTH` price levels of `ORDERS_PER_LEVEL`
+ * resting orders on each side, around a spread of 99.99 / 100.01, so map lookups and
+ * level scans have a realistic size:
+ *
+ * - `orderbook/add_resting`: limit orders that do not cross, added behind the others.
+ * - `orderbook/match_one`: an order that fills exactly one resting order at the best
+ *   level, which is replenished so the book keeps its shape.
+ * - `orderbook/sweep_5_levels`: a market order that takes five levels, then the levels
+ *   are put back outside the timed region.
+ * - `orderbook/cancel`: removal of an order from the middle of a level, which is then
+ *   replaced at the back outside the timed region.
+ *
+ * Orders are created outside the timed region: `Order` builds its id with a
+ * `std::stringstream`, which would otherwise dominate the results.
+ */
+
+#include <harness/Bench.h>
+#include <OrderBook.h>
+
+namespace {
+
+constexpr int DEPTH = 10;
+constexpr int ORDERS_PER_LEVEL = 20;
+constexpr int QUANTITY = 100;
+const std::string SYMBOL = "AAPL";
+
+double bidPrice(int level) { return 99.99 - 0.01 * level; }
+double askPrice(int level) { return 100.01 + 0.01 * level; }
+
+std::shared_ptr<Order> limit(Side side, double price, int quantity = QUANTITY) {
+    return std::make_shared<Order>("bench", SYMBOL, side, price, quantity);
+}
+
+void fill(OrderBook& book) {
+    for (int level = 0; level < DEPTH; ++level) {
+        for (int i = 0; i < ORDERS_PER_LEVEL; ++i) {
+            book.addOrder(limit(Side::BUY, bidPrice(level)));
+            book.addOrder(limit(Side::SELL, askPrice(level)));
+        }
+    }
+}
+
+std::vector<std::shared_ptr<Order>> makeOrders(uint64_t count, Side side, double price,
+                                               int quantity = QUANTITY) {
+    std::vector<std::shared_ptr<Order>> orders;
+    orders.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) orders.push_back(limit(side, price, quantity));
+    return orders;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Suite suite("orderbook");
+
+    suite.add("orderbook/add_resting", [](bench::State& state) {
+        state.pause();
+        OrderBook book(SYMBOL);
+        fill(book);
+        auto buys = makeOrders(state.iterations() / 2 + 1, Side::BUY, bidPrice(DEPTH / 2));
+        auto sells = makeOrders(state.iterations() / 2 + 1, Side::SELL, askPrice(DEPTH / 2));
+        state.resume();
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            book.addOrder(i % 2 ? sells[i / 2] : buys[i / 2]);
+        }
+        state.setItems(state.iterations());
+        state.pause();  // book destruction is not part of the measure
+    });
+
+    suite.add("orderbook/match_one", [](bench::State& state) {
+        state.pause();
+        OrderBook book(SYMBOL);
+        fill(book);
+        // Each aggressive buy fills one resting ask; a new ask at the same price keeps the level
+        auto buys = makeOrders(state.iterations(), Side::BUY, askPrice(0));
+        auto asks = makeOrders(state.iterations(), Side::SELL, askPrice(0));
+        state.resume();
+        uint64_t trades = 0;
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            book.addOrder(asks[i]);
+            auto result = book.matchOrders(buys[i]);
+            trades += result.size();
+        }
+        bench::doNotOptimize(trades);
+        state.setItems(state.iterations());
+        state.pause();
+    });
+
+    suite.add("orderbook/sweep_5_levels", [](bench::State& state) {
+        state.pause();
+        OrderBook book(SYMBOL);
+        fill(book);
+        uint64_t trades = 0;
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            auto sweep = std::make_shared<Order>("bench", SYMBOL, Side::BUY,
+                                                 5 * ORDERS_PER_LEVEL * QUANTITY);
+            state.resume();
+            auto result = book.matchOrders(sweep);
+            state.pause();
+            trades += result.size();
+            for (int level = 0; level < 5; ++level)
+                for (int o = 0; o < ORDERS_PER_LEVEL; ++o)
+                    book.addOrder(limit(Side::SELL, askPrice(level)));
+        }
+        bench::doNotOptimize(trades);
+        state.setItems(state.iterations());
+    });
+
+    suite.add("orderbook/cancel", [](bench::State& state) {
+        state.pause();
+        OrderBook book(SYMBOL);
+        fill(book);
+        // Ids of our orders on each bid level, in book order
+        std::vector<std::vector<std::string>> levels(DEPTH);
+        for (int level = 0; level < DEPTH; ++level) {
+            for (int i = 0; i < ORDERS_PER_LEVEL; ++i) {
+                auto order = limit(Side::BUY, bidPrice(level));
+                book.addOrder(order);
+                levels[level].push_back(order->order_id);
+            }
+        }
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            auto& ids = levels[i % DEPTH];
+            auto middle = ids.begin() + ids.size() / 2;
+            std::string id = *middle;
+            ids.erase(middle);
+            state.resume();
+            book.removeOrder(id);
+            state.pause();
+            // Replace it at the back of the level so the book keeps its shape
+            auto order = limit(Side::BUY, bidPrice(i % DEPTH));
+            book.addOrder(order);
+            ids.push_back(order->order_id);
+        }
+        state.setItems(state.iterations());
+    });
+
+    return suite.run(argc, argv);
+}
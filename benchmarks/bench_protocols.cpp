@@ -0,0 +1,106 @@
+/**
+ * @file examples/benchmarks/bench_protocols.cpp
+ * @brief Framing and parsing of the broker and chat wire protocols.
+ *
+ * @details
+ * `BrokerProtocol` and `ChatProtocol` (the `Protocol.h` of each example's `shared/`
+ * directory) are driven the way a QB session drives them: the bytes of a read are
+ * appended to the input pipe, then `getMessageSize()` / `onMessage()` / `free_front()`
+ * run until no complete message is left. The session is replaced by a stub that only
+ * counts the messages it receives.
+ *
+ * - `protocol/<broker|chat>/parse/<payload>`: 64 messages per read, with payloads of
+ *   32 bytes (a subscribe), 1 KiB and 16 KiB.
+ * - `protocol/<broker|chat>/serialize/<payload>`: `pipe<char>::put<Message>()`, the
+ *   serialization behind `*this << message << Protocol::end`.
+ *
+ * One iteration is one message.
+ */
+
+#include <harness/Bench.h>
+#include <qb/system/allocator/pipe.h>
+#include "../core_io/message_broker/shared/Protocol.h"
+#include "../core_io/chat_tcp/shared/Protocol.h"
+
+namespace {
+
+constexpr int MESSAGES_PER_READ = 64;
+
+/// Stands in for the session: owns the input pipe and receives the parsed messages
+template <typename Message>
+struct StubSession {
+    qb::allocator::pipe<char> _in;
+    uint64_t messages = 0;
+    uint64_t payload_bytes = 0;
+
+    qb::allocator::pipe<char>& in() { return _in; }
+
+    template <typename M>
+    void on(M&& msg) {
+        ++messages;
+        payload_bytes += msg.payload.size();
+    }
+};
+
+template <typename Message, template <typename> class Protocol, typename Type>
+void addProtocol(bench::Suite& suite, const std::string& name, Type type) {
+    for (std::size_t payload : {std::size_t(32), std::size_t(1024), std::size_t(16384)}) {
+        std::string size = std::to_string(payload);
+
+        suite.add("protocol/" + name + "/parse/" + size, [payload, type](bench::State& state) {
+            state.pause();
+            // One read worth of serialized messages
+            qb::allocator::pipe<char> wire;
+            for (int i = 0; i < MESSAGES_PER_READ; ++i)
+                wire.put(Message(type, std::string(payload, 'x')));
+            std::string read(wire.cbegin(), wire.size());
+
+            StubSession<Message> session;
+            Protocol<StubSession<Message>> protocol(session);
+            auto& in = session.in();
+            const uint64_t reads = (state.iterations() + MESSAGES_PER_READ - 1) / MESSAGES_PER_READ;
+            state.resume();
+            for (uint64_t r = 0; r < reads; ++r) {
+                in.put(read.data(), read.size());
+                std::size_t size;
+                while ((size = protocol.getMessageSize()) > 0 && in.size() >= size) {
+                    protocol.onMessage(size);
+                    in.free_front(size);
+                }
+            }
+            state.pause();
+            if (session.messages != reads * MESSAGES_PER_READ)
+                state.fail("parsed " + std::to_string(session.messages) + " messages");
+            // Report per message, whatever the rounding of reads
+            state.setManualTime(state.seconds() * state.iterations() / session.messages);
+            state.setItems(state.iterations());
+            state.setBytes(state.iterations() * (read.size() / MESSAGES_PER_READ));
+        });
+
+        suite.add("protocol/" + name + "/serialize/" + size, [payload, type](bench::State& state) {
+            state.pause();
+            Message msg(type, std::string(payload, 'x'));
+            qb::allocator::pipe<char> out;
+            out.put(msg);
+            const std::size_t wire_size = out.size();
+            out.reset();
+            state.resume();
+            for (uint64_t i = 0; i < state.iterations(); ++i) {
+                out.put(msg);
+                if (i % MESSAGES_PER_READ == MESSAGES_PER_READ - 1) out.reset();  // as after a write
+            }
+            bench::doNotOptimize(out.size());
+            state.setItems(state.iterations());
+            state.setBytes(state.iterations() * wire_size);
+        });
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Suite suite("protocols");
+    addProtocol<broker::Message, broker::BrokerProtocol>(suite, "broker", broker::MessageType::PUBLISH);
+    addProtocol<chat::Message, chat::ChatProtocol>(suite, "chat", chat::MessageType::CHAT_MESSAGE);
+    return suite.run(argc, argv);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file examples/benchmarks/bench_shared_queue.cpp
+ * @brief Mutex-protected queue of the producer/consumer example (`core/shared/SharedQueue.h`).
+ *
+ * @details
+ * - `shared_queue/push_pop`: one thread pushes and pops an item, so the lock is never
+ *   contended. This is the floor of every operation.
+ * - `shared_queue/mpmc/<P>x<C>`: P producer threads push items that C consumer threads
+ *   pop, as the producer and consumer actors of the example do from their cores. One
+ *   iteration is one item through the queue. Consumers spin on an empty queue like the
+ *   actors that poll it.
+ *
+ * The item is a `qb::Event` of the same layout as the example's `WorkItemMsg`.
+ */
+
+#include <harness/Bench.h>
+#include <SharedQueue.h>
+#include <qb/event.h>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+struct WorkItem : public qb::Event {
+    int id = 0;
+    int complexity = 0;
+
+    WorkItem() = default;
+    WorkItem(int i, int c) : id(i), complexity(c) {}
+};
+
+void contended(bench::State& state, int producers, int consumers) {
+    SharedQueue<WorkItem> queue;
+    const uint64_t total = state.iterations();
+    std::atomic<uint64_t> consumed{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            bench::unpinThread();
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (uint64_t i = p; i < total; i += producers)
+                queue.push(WorkItem(static_cast<int>(i), 1));
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            bench::unpinThread();
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            WorkItem item;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (queue.pop(item)) consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    state.resume();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    state.pause();
+    state.setItems(total);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Suite suite("shared_queue");
+
+    suite.add("shared_queue/push_pop", [](bench::State& state) {
+        SharedQueue<WorkItem> queue;
+        WorkItem item;
+        for (uint64_t i = 0; i < state.iterations(); ++i) {
+            queue.push(WorkItem(static_cast<int>(i), 1));
+            queue.pop(item);
+        }
+        bench::doNotOptimize(item.id);
+        state.setItems(state.iterations());
+    });
+
+    for (auto [producers, consumers] : std::vector<std::pair<int, int>>{{1, 1}, {1, 3}, {2, 2}}) {
+        suite.add("shared_queue/mpmc/" + std::to_string(producers) + "x" + std::to_string(consumers),
+                  [producers = producers, consumers = consumers](bench::State& state) {
+                      state.pause();
+                      contended(state, producers, consumers);
+                  });
+    }
+
+    return suite.run(argc, argv);
+}
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Compare benchmark results against a stored baseline.
+
+Both arguments are a JSON file written with `--json` or a directory of them. A
+benchmark is a regression when its median time per iteration grew by more than
+the threshold and by more than twice the relative spread (median absolute
+deviation) of either run, so a noisy benchmark needs a larger change to be
+flagged. The exit status is 1 when there is at least one regression.
+
+    compare.py baseline/ results/ --threshold 5
+"""
+
+import argparse
+import json
+import os
+import sys
+
+
+def load(path):
+    """Returns ({name: benchmark}, [context]) from a result file or directory."""
+    files = [path]
+    if os.path.isdir(path):
+        files = sorted(os.path.join(path, f) for f in os.listdir(path) if f.endswith(".json"))
+    benchmarks, contexts = {}, []
+    for f in files:
+        with open(f) as fh:
+            data = json.load(fh)
+        contexts.append(data.get("context", {}))
+        for b in data.get("benchmarks", []):
+            benchmarks[b["name"]] = b
+    return benchmarks, contexts
+
+
+def spread(b):
+    median = b.get("median_ns", 0)
+    return b.get("mad_ns", 0) / median if median else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("baseline", help="baseline JSON file or directory")
+    parser.add_argument("current", help="current JSON file or directory")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="smallest slowdown reported, in percent (default 5)")
+    parser.add_argument("--filter", default="", help="only compare names containing this")
+    args = parser.parse_args()
+
+    base, base_ctx = load(args.baseline)
+    cur, cur_ctx = load(args.current)
+
+    build_types = {c.get("build_type") for c in base_ctx + cur_ctx}
+    if len(build_types) > 1:
+        print("warning: results come from different build types: %s" % ", ".join(sorted(map(str, build_types))))
+    hosts = {c.get("host") for c in base_ctx + cur_ctx}
+    if len(hosts) > 1:
+        print("warning: results come from different hosts: %s" % ", ".join(sorted(map(str, hosts))))
+
+    rows, regressions = [], 0
+    for name in sorted(set(base) | set(cur)):
+        if args.filter not in name:
+            continue
+        b, c = base.get(name), cur.get(name)
+        if b is None or "median_ns" not in b:
+            rows.append((name, "-", fmt(c), "", "new"))
+            continue
+        if c is None or "median_ns" not in c:
+            rows.append((name, fmt(b), "-", "", "missing" if c is None else "error"))
+            regressions += c is not None
+            continue
+        change = c["median_ns"] / b["median_ns"] - 1 if b["median_ns"] else 0
+        noise = max(args.threshold / 100, 2 * max(spread(b), spread(c)))
+        if change > noise:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif change < -noise:
+            verdict = "improved"
+        else:
+            verdict = ""
+        rows.append((name, fmt(b), fmt(c), "%+.1f%% (noise %.1f%%)" % (100 * change, 100 * noise), verdict))
+
+    width = max([len(r[0]) for r in rows] + [len("benchmark")])
+    print("%-*s %14s %14s  %-24s %s" % (width, "benchmark", "baseline ns", "current ns", "change", ""))
+    for r in rows:
+        print("%-*s %14s %14s  %-24s %s" % (width, *r))
+    print("\n%d regression(s) beyond the noise threshold" % regressions)
+    return 1 if regressions else 0
+
+
+def fmt(b):
+    return "%.1f" % b["median_ns"] if b and "median_ns" in b else "error"
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,628 @@
+/**
+ * @file examples/benchmarks/cross_core_matrix.cpp
+ * @example Cross-Core Messaging Latency and Throughput Matrix
+ *
+ * @brief Measures event latency and throughput between every pair of cores, for event
+ * sizes from 16 B to 64 KB and for the common actor communication patterns, and writes
+ * the results as a CSV ready to be pivoted into heat maps.
+ *
+ * @details
+ * One `BenchNode` actor per slot is placed on every selected core (`--nodes-per-core`,
+ * default 2) and a `CoordinatorActor` on the first core runs the scenarios one after
+ * the other, so the whole matrix is measured in a single engine with stable threads:
+ *
+ * - `1to1`: node 0 on the source core streams to node 1 on the destination core, for
+ *   every (source, destination) pair including a core with itself.
+ * - `1toN`: node 0 on the source core streams to node 1 on every other core.
+ * - `Nto1`: node 0 on every other core streams to node 1 on the destination core.
+ * - `broadcast`: node 0 on the source core pushes to `qb::BroadcastId(destination)`,
+ *   which delivers every event to all nodes of the destination core.
+ *
+ * Each scenario runs two phases:
+ * 1. Latency (`--latency-ms`): one event in flight per receiver. Receivers record the
+ *    one-way latency (steady clock at send vs. at receive, both on Linux `CLOCK_MONOTONIC`)
+ *    and acknowledge every event; the sender records the round trip.
+ * 2. Throughput (`--throughput-ms`): up to `--window` events in flight per receiver
+ *    (capped at 1 MB), acknowledged in batches of half a window. The result is events
+ *    delivered per second.
+ *
+ * A phase ends with a final acknowledged event per receiver. Events between a sender and
+ * a receiver are delivered in order, so once it is acknowledged nothing of the phase is
+ * still queued and the next scenario starts on empty mailboxes.
+ *
+ * Each QB core is pinned to the CPU of the same id, so a pair of cores is a pair of CPUs
+ * from one run to the next; a core without such a CPU runs unpinned.
+ *
+ * Output (`--out`, default stdout), one row per scenario:
+ * `pattern,src_core,dst_core,src_cpu,dst_cpu,size,event_bytes,receivers,one_way_p50_ns,`
+ * `one_way_p99_ns,rtt_p50_ns,rtt_p99_ns,events_per_sec,mb_per_sec`. `dst_core` is `all`
+ * for `1toN` and `src_core` is `all` for `Nto1`, and so are their CPUs; an unpinned core
+ * has `-` as its CPU. `event_bytes` is the actual `sizeof` of the event,
+ * which includes the `qb::Event` header and the benchmark header for the smallest sizes.
+ *
+ * QB Features Demonstrated:
+ * - Multi-Core Deployment: one actor per core slot with `engine.addActor<T>(core_id, ...)`.
+ * - Event Templates: one event type per payload size, registered with a fold expression.
+ * - Core Broadcast: `push<E>(qb::BroadcastId(core_id))`.
+ * - Request/Acknowledge Flow Control: a credit window per receiver.
+ * - Shared Metrics: `metrics::Histogram` recorded from every core.
+ */
+
+#include <qb/actor.h>
+#include <qb/main.h>
+#include <qb/io.h>
+#include <metrics/Metrics.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+uint64_t now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Payload flags
+constexpr uint32_t FLAG_ACK = 1;      ///< receiver acknowledges this event
+constexpr uint32_t FLAG_RECORD = 2;   ///< receiver records the one-way latency
+constexpr uint32_t FLAG_FIN = 4;      ///< last event of the phase
+
+/// Events of the first latency samples of every phase are not recorded
+constexpr uint32_t WARMUP_EVENTS = 100;
+/// Upper bound on the bytes in flight per receiver in the throughput phase
+constexpr std::size_t MAX_WINDOW_BYTES = 1 << 20;
+
+struct PayloadHeader : public qb::Event {
+    uint64_t sent_ns = 0;
+    uint32_t seq = 0;
+    uint32_t flags = 0;
+};
+
+/// Benchmark event of (at least) N bytes, header included
+template <std::size_t N, bool Padded = (N > sizeof(PayloadHeader))>
+struct PayloadEvent : public PayloadHeader {
+    char data[N - sizeof(PayloadHeader)];
+};
+
+template <std::size_t N>
+struct PayloadEvent<N, false> : public PayloadHeader {};
+
+template <std::size_t... Sizes>
+struct SizeList {
+    static constexpr std::array<std::size_t, sizeof...(Sizes)> values{Sizes...};
+
+    /// Calls fn(std::integral_constant<std::size_t, N>) for the N equal to `size`
+    template <typename Fn>
+    static void dispatch(std::size_t size, Fn&& fn) {
+        ((size == Sizes ? (fn(std::integral_constant<std::size_t, Sizes>{}), true) : false) || ...);
+    }
+};
+
+using PayloadSizes = SizeList<16, 64, 256, 1024, 4096, 16384, 65536>;
+
+std::size_t eventBytes(std::size_t size) {
+    std::size_t bytes = 0;
+    PayloadSizes::dispatch(size, [&](auto n) { bytes = sizeof(PayloadEvent<decltype(n)::value>); });
+    return bytes;
+}
+
+struct AckEvent : public qb::Event {
+    uint32_t seq;
+    uint32_t node;        ///< index of the acknowledging node
+    uint64_t echo_ns;     ///< send time of the acknowledged event
+
+    AckEvent(uint32_t seq, uint32_t node, uint64_t echo_ns)
+        : seq(seq), node(node), echo_ns(echo_ns) {}
+};
+
+/// A destination of a sender: one node, or a core broadcast reaching several nodes
+struct Target {
+    qb::ActorId id;
+    std::vector<uint32_t> nodes;   ///< nodes expected to acknowledge
+};
+
+struct RunEvent : public qb::Event {
+    std::vector<Target> targets;
+    std::size_t size;
+    uint32_t window;
+    uint64_t duration_ns;
+    bool latency;
+
+    RunEvent(std::vector<Target> targets, std::size_t size, uint32_t window, uint64_t duration_ns, bool latency)
+        : targets(std::move(targets)), size(size), window(window), duration_ns(duration_ns), latency(latency) {}
+};
+
+struct DoneEvent : public qb::Event {
+    uint64_t deliveries;   ///< events received, summed over receivers
+    uint64_t elapsed_ns;
+
+    DoneEvent(uint64_t deliveries, uint64_t elapsed_ns)
+        : deliveries(deliveries), elapsed_ns(elapsed_ns) {}
+};
+
+/// Histograms of the current latency phase, replaced by the coordinator between phases
+struct Session {
+    std::unique_ptr<metrics::Histogram> one_way;
+    std::unique_ptr<metrics::Histogram> rtt;
+};
+
+struct Options {
+    std::vector<unsigned> cores;
+    std::vector<std::size_t> sizes{PayloadSizes::values.begin(), PayloadSizes::values.end()};
+    std::vector<std::string> patterns{"1to1", "1toN", "Nto1", "broadcast"};
+    unsigned nodes_per_core = 2;
+    uint32_t window = 64;
+    uint64_t latency_ms = 50;
+    uint64_t throughput_ms = 100;
+    std::string out;
+};
+
+struct Row {
+    std::string pattern;
+    std::string src;
+    std::string dst;
+    std::size_t size;
+    std::size_t receivers;
+    uint64_t one_way_p50 = 0;
+    uint64_t one_way_p99 = 0;
+    uint64_t rtt_p50 = 0;
+    uint64_t rtt_p99 = 0;
+    double events_per_sec = 0;
+};
+
+/**
+ * @brief Sender and receiver of benchmark events
+ *
+ * Every node receives; a node sends while it runs a `RunEvent` from the coordinator.
+ */
+class BenchNode : public qb::Actor {
+    const uint32_t _index;
+    const uint32_t _total_nodes;
+    Session& _session;
+
+    // Sender state, valid while running
+    struct Stream {
+        Target target;
+        uint32_t sent = 0;
+    };
+    std::vector<Stream> _streams;
+    std::vector<uint32_t> _acked;       ///< highest acknowledged seq per node
+    std::vector<int> _stream_of;        ///< stream index per node, -1 if not a receiver
+    qb::ActorId _coordinator;
+    std::size_t _size = 0;
+    uint32_t _window = 1;
+    uint32_t _ack_every = 1;
+    bool _latency = false;
+    bool _stopping = false;
+    uint64_t _start = 0;
+    uint64_t _deadline = 0;
+
+public:
+    BenchNode(uint32_t index, uint32_t total_nodes, Session& session)
+        : _index(index), _total_nodes(total_nodes), _session(session) {}
+
+    bool onInit() override {
+        registerPayloads(PayloadSizes{});
+        registerEvent<AckEvent>(*this);
+        registerEvent<RunEvent>(*this);
+        return true;
+    }
+
+    template <std::size_t N>
+    void on(PayloadEvent<N>& evt) {
+        if (evt.flags & FLAG_RECORD)
+            _session.one_way->record(now() - evt.sent_ns);
+        if (evt.flags & FLAG_ACK)
+            push<AckEvent>(evt.getSource(), evt.seq, _index, evt.sent_ns);
+    }
+
+    void on(RunEvent& evt) {
+        _coordinator = evt.getSource();
+        _size = evt.size;
+        _latency = evt.latency;
+        _window = evt.latency ? 1 : std::max<uint32_t>(1, std::min<std::size_t>(
+            evt.window, MAX_WINDOW_BYTES / eventBytes(evt.size)));
+        _ack_every = std::max<uint32_t>(1, _window / 2);
+        _stopping = false;
+
+        _streams.clear();
+        _acked.assign(_total_nodes, 0);
+        _stream_of.assign(_total_nodes, -1);
+        for (auto& target : evt.targets) {
+            for (auto node : target.nodes)
+                _stream_of[node] = static_cast<int>(_streams.size());
+            _streams.push_back({std::move(target), 0});
+        }
+
+        _start = now();
+        _deadline = _start + evt.duration_ns;
+        for (auto& stream : _streams)
+            fill(stream);
+    }
+
+    void on(AckEvent& evt) {
+        if (_latency && !_stopping && evt.seq > WARMUP_EVENTS)
+            _session.rtt->record(now() - evt.echo_ns);
+        _acked[evt.node] = std::max(_acked[evt.node], evt.seq);
+        auto& stream = _streams[static_cast<std::size_t>(_stream_of[evt.node])];
+
+        if (!_stopping) {
+            if (now() < _deadline) {
+                fill(stream);
+                return;
+            }
+            _stopping = true;
+            for (auto& s : _streams)
+                send(s, FLAG_ACK | FLAG_FIN);
+        }
+
+        for (const auto& s : _streams) {
+            if (acked(s) != s.sent)
+                return;
+        }
+        uint64_t deliveries = 0;
+        for (const auto& s : _streams)
+            deliveries += static_cast<uint64_t>(s.sent) * s.target.nodes.size();
+        push<DoneEvent>(_coordinator, deliveries, now() - _start);
+        _streams.clear();
+    }
+
+private:
+    template <std::size_t... Sizes>
+    void registerPayloads(SizeList<Sizes...>) {
+        (registerEvent<PayloadEvent<Sizes>>(*this), ...);
+    }
+
+    /// Lowest seq acknowledged by every node of the stream's target
+    uint32_t acked(const Stream& stream) const {
+        uint32_t lowest = UINT32_MAX;
+        for (auto node : stream.target.nodes)
+            lowest = std::min(lowest, _acked[node]);
+        return lowest;
+    }
+
+    void fill(Stream& stream) {
+        while (stream.sent - acked(stream) < _window) {
+            const uint32_t seq = stream.sent + 1;
+            uint32_t flags = 0;
+            if (_latency || seq % _ack_every == 0)
+                flags |= FLAG_ACK;
+            if (_latency && seq > WARMUP_EVENTS)
+                flags |= FLAG_RECORD;
+            send(stream, flags);
+        }
+    }
+
+    void send(Stream& stream, uint32_t flags) {
+        const uint32_t seq = ++stream.sent;
+        PayloadSizes::dispatch(_size, [&](auto n) {
+            auto& evt = push<PayloadEvent<decltype(n)::value>>(stream.target.id);
+            evt.seq = seq;
+            evt.flags = flags;
+            evt.sent_ns = now();
+        });
+    }
+};
+
+/**
+ * @brief Runs every scenario in turn and collects one `Row` per scenario
+ */
+class CoordinatorActor : public qb::Actor {
+    struct Job {
+        uint32_t sender;               ///< node index
+        std::vector<Target> targets;
+    };
+    struct Scenario {
+        Row row;
+        std::vector<Job> jobs;
+    };
+
+    const Options& _options;
+    const std::vector<qb::ActorId>& _nodes;
+    Session& _session;
+    std::vector<Row>& _rows;
+
+    std::vector<Scenario> _scenarios;
+    std::size_t _current = 0;
+    bool _latency_phase = true;
+    std::size_t _pending = 0;
+    uint64_t _deliveries = 0;
+    uint64_t _elapsed_ns = 0;
+
+public:
+    CoordinatorActor(const Options& options, const std::vector<qb::ActorId>& nodes,
+                     Session& session, std::vector<Row>& rows)
+        : _options(options), _nodes(nodes), _session(session), _rows(rows) {}
+
+    bool onInit() override {
+        registerEvent<DoneEvent>(*this);
+        // Broadcasts to the coordinator's core reach it as well
+        ignorePayloads(PayloadSizes{});
+        buildScenarios();
+        qb::io::cout() << "Coordinator: " << _scenarios.size() << " scenarios on "
+                       << _options.cores.size() << " cores" << std::endl;
+        startPhase();
+        return true;
+    }
+
+    template <std::size_t N>
+    void on(PayloadEvent<N>&) {}
+
+    void on(DoneEvent& evt) {
+        _deliveries += evt.deliveries;
+        _elapsed_ns = std::max(_elapsed_ns, evt.elapsed_ns);
+        if (--_pending)
+            return;
+
+        auto& row = _scenarios[_current].row;
+        if (_latency_phase) {
+            const auto one_way = _session.one_way->snapshot();
+            const auto rtt = _session.rtt->snapshot();
+            row.one_way_p50 = one_way.quantile(0.5);
+            row.one_way_p99 = one_way.quantile(0.99);
+            row.rtt_p50 = rtt.quantile(0.5);
+            row.rtt_p99 = rtt.quantile(0.99);
+            _latency_phase = false;
+        } else {
+            row.events_per_sec = _elapsed_ns ? static_cast<double>(_deliveries) * 1e9 / static_cast<double>(_elapsed_ns) : 0;
+            _rows.push_back(row);
+            if (++_current % 50 == 0)
+                std::cerr << "  " << _current << "/" << _scenarios.size() << " scenarios" << std::endl;
+            _latency_phase = true;
+        }
+
+        if (_current == _scenarios.size()) {
+            for (const auto& node : _nodes)
+                push<qb::KillEvent>(node);
+            kill();
+            return;
+        }
+        startPhase();
+    }
+
+private:
+    template <std::size_t... Sizes>
+    void ignorePayloads(SizeList<Sizes...>) {
+        (registerEvent<PayloadEvent<Sizes>>(*this), ...);
+    }
+
+    uint32_t node(std::size_t core_slot, unsigned k) const {
+        return static_cast<uint32_t>(core_slot * _options.nodes_per_core + k);
+    }
+
+    Target unicast(uint32_t node) const {
+        return {_nodes[node], {node}};
+    }
+
+    Target broadcast(std::size_t core_slot) const {
+        Target target{qb::BroadcastId(_options.cores[core_slot]), {}};
+        for (unsigned k = 0; k < _options.nodes_per_core; ++k)
+            target.nodes.push_back(node(core_slot, k));
+        return target;
+    }
+
+    void add(const std::string& pattern, std::string src, std::string dst, std::size_t size, std::vector<Job> jobs) {
+        Scenario scenario;
+        scenario.row.pattern = pattern;
+        scenario.row.src = std::move(src);
+        scenario.row.dst = std::move(dst);
+        scenario.row.size = size;
+        scenario.row.receivers = 0;
+        for (const auto& job : jobs)
+            for (const auto& target : job.targets)
+                scenario.row.receivers = std::max(scenario.row.receivers, target.nodes.size());
+        if (pattern == "1toN")
+            scenario.row.receivers = jobs.front().targets.size();
+        scenario.jobs = std::move(jobs);
+        _scenarios.push_back(std::move(scenario));
+    }
+
+    void buildScenarios() {
+        const auto& cores = _options.cores;
+        const auto slots = cores.size();
+        auto has = [&](const char* pattern) {
+            return std::find(_options.patterns.begin(), _options.patterns.end(), pattern) != _options.patterns.end();
+        };
+
+        for (auto size : _options.sizes) {
+            if (has("1to1")) {
+                for (std::size_t s = 0; s < slots; ++s)
+                    for (std::size_t d = 0; d < slots; ++d)
+                        add("1to1", std::to_string(cores[s]), std::to_string(cores[d]), size,
+                            {{node(s, 0), {unicast(node(d, 1))}}});
+            }
+            if (has("1toN") && slots > 1) {
+                for (std::size_t s = 0; s < slots; ++s) {
+                    Job job{node(s, 0), {}};
+                    for (std::size_t d = 0; d < slots; ++d)
+                        if (d != s)
+                            job.targets.push_back(unicast(node(d, 1)));
+                    add("1toN", std::to_string(cores[s]), "all", size, {job});
+                }
+            }
+            if (has("Nto1") && slots > 1) {
+                for (std::size_t d = 0; d < slots; ++d) {
+                    std::vector<Job> jobs;
+                    for (std::size_t s = 0; s < slots; ++s)
+                        if (s != d)
+                            jobs.push_back({node(s, 0), {unicast(node(d, 1))}});
+                    add("Nto1", "all", std::to_string(cores[d]), size, std::move(jobs));
+                }
+            }
+            if (has("broadcast")) {
+                for (std::size_t s = 0; s < slots; ++s)
+                    for (std::size_t d = 0; d < slots; ++d)
+                        add("broadcast", std::to_string(cores[s]), std::to_string(cores[d]), size,
+                            {{node(s, 0), {broadcast(d)}}});
+            }
+        }
+    }
+
+    void startPhase() {
+        const auto& scenario = _scenarios[_current];
+        if (_latency_phase) {
+            _session.one_way = std::make_unique<metrics::Histogram>();
+            _session.rtt = std::make_unique<metrics::Histogram>();
+        }
+        _deliveries = 0;
+        _elapsed_ns = 0;
+        _pending = scenario.jobs.size();
+        const uint64_t duration_ns = (_latency_phase ? _options.latency_ms : _options.throughput_ms) * 1000000ull;
+        for (const auto& job : scenario.jobs)
+            push<RunEvent>(_nodes[job.sender], job.targets, scenario.row.size, _options.window,
+                           duration_ns, _latency_phase);
+    }
+};
+
+template <typename T, typename Parse>
+std::vector<T> parseList(const std::string& text, Parse parse) {
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty())
+            parse(item, values);
+    }
+    return values;
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --cores LIST           cores to measure, e.g. 0-3 or 0,2,4 (default: all)\n"
+              << "  --sizes LIST           event sizes in bytes, among 16,64,256,1024,4096,16384,65536\n"
+              << "  --patterns LIST        1to1,1toN,Nto1,broadcast (default: all)\n"
+              << "  --nodes-per-core N     actors per core, also the broadcast fan-out (default: 2)\n"
+              << "  --window N             events in flight per receiver in the throughput phase (default: 64)\n"
+              << "  --latency-ms N         duration of the latency phase (default: 50)\n"
+              << "  --throughput-ms N      duration of the throughput phase (default: 100)\n"
+              << "  --out FILE             CSV output (default: stdout)\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc)
+            return false;
+        const std::string value = argv[++i];
+        if (arg == "--cores") {
+            options.cores = parseList<unsigned>(value, [](const std::string& item, std::vector<unsigned>& out) {
+                const auto dash = item.find('-');
+                const auto first = static_cast<unsigned>(std::stoul(item.substr(0, dash)));
+                const auto last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(item.substr(dash + 1)));
+                for (auto core = first; core <= last; ++core)
+                    out.push_back(core);
+            });
+        } else if (arg == "--sizes") {
+            options.sizes = parseList<std::size_t>(value, [](const std::string& item, std::vector<std::size_t>& out) {
+                out.push_back(std::stoul(item));
+            });
+            for (auto size : options.sizes) {
+                if (!eventBytes(size)) {
+                    std::cerr << "Unsupported size " << size << std::endl;
+                    return false;
+                }
+            }
+        } else if (arg == "--patterns") {
+            options.patterns = parseList<std::string>(value, [](const std::string& item, std::vector<std::string>& out) {
+                out.push_back(item);
+            });
+        } else if (arg == "--nodes-per-core") {
+            options.nodes_per_core = std::max(2u, static_cast<unsigned>(std::stoul(value)));
+        } else if (arg == "--window") {
+            options.window = std::max(1u, static_cast<uint32_t>(std::stoul(value)));
+        } else if (arg == "--latency-ms") {
+            options.latency_ms = std::stoull(value);
+        } else if (arg == "--throughput-ms") {
+            options.throughput_ms = std::stoull(value);
+        } else if (arg == "--out") {
+            options.out = value;
+        } else {
+            return false;
+        }
+    }
+    if (options.cores.empty()) {
+        for (unsigned core = 0; core < std::max(1u, std::thread::hardware_concurrency()); ++core)
+            options.cores.push_back(core);
+    }
+    return true;
+}
+
+/// CPU a core column of a row ran on: the pinned CPU, `all` as for the core, `-` if unpinned
+std::string cpuOf(const std::map<std::string, std::string>& cpus, const std::string& core) {
+    if (core == "all")
+        return core;
+    const auto it = cpus.find(core);
+    return it == cpus.end() ? "-" : it->second;
+}
+
+void writeCsv(std::ostream& out, const std::vector<Row>& rows, const std::map<std::string, std::string>& cpus) {
+    out << "pattern,src_core,dst_core,src_cpu,dst_cpu,size,event_bytes,receivers,one_way_p50_ns,one_way_p99_ns,"
+           "rtt_p50_ns,rtt_p99_ns,events_per_sec,mb_per_sec\n";
+    for (const auto& row : rows) {
+        const auto bytes = eventBytes(row.size);
+        out << row.pattern << ',' << row.src << ',' << row.dst << ',' << cpuOf(cpus, row.src) << ','
+            << cpuOf(cpus, row.dst) << ',' << row.size << ',' << bytes << ','
+            << row.receivers << ',' << row.one_way_p50 << ',' << row.one_way_p99 << ','
+            << row.rtt_p50 << ',' << row.rtt_p99 << ','
+            << static_cast<uint64_t>(row.events_per_sec) << ','
+            << row.events_per_sec * static_cast<double>(bytes) / 1e6 << '\n';
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    qb::Main engine;
+    Session session;
+    std::vector<Row> rows;
+
+    // Nodes are numbered core slot by core slot: node(slot, k) = slot * nodes_per_core + k
+    const auto total_nodes = static_cast<uint32_t>(options.cores.size() * options.nodes_per_core);
+    std::vector<qb::ActorId> nodes;
+    for (auto core : options.cores) {
+        for (unsigned k = 0; k < options.nodes_per_core; ++k)
+            nodes.push_back(engine.addActor<BenchNode>(core, static_cast<uint32_t>(nodes.size()), total_nodes, session));
+    }
+    engine.addActor<CoordinatorActor>(options.cores.front(), options, nodes, session, rows);
+
+    // Core id -> CPU id it is pinned to, for the CSV
+    std::map<std::string, std::string> cpus;
+    for (auto core : options.cores) {
+        if (core >= std::thread::hardware_concurrency())
+            continue;
+        const auto id = static_cast<qb::CoreId>(core);
+        engine.core(id).setAffinity({id});
+        cpus[std::to_string(core)] = std::to_string(core);
+    }
+
+    engine.start();
+    engine.join();
+
+    if (options.out.empty()) {
+        writeCsv(std::cout, rows, cpus);
+    } else {
+        std::ofstream out(options.out);
+        writeCsv(out, rows, cpus);
+        std::cerr << "Wrote " << rows.size() << " rows to " << options.out << std::endl;
+    }
+    return 0;
+}
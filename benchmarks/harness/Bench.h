@@ -0,0 +1,462 @@
+/**
+ * @file examples/benchmarks/harness/Bench.h
+ * @brief Micro-benchmark harness: calibration, warmup, repetitions, CPU pinning and JSON output.
+ *
+ * @details
+ * Each benchmark program builds a `bench::Suite`, adds its benchmarks and hands over
+ * `argc`/`argv`:
+ *
+ * - A benchmark is a function taking a `bench::State`. It runs the measured operation
+ *   `state.iterations()` times and may report the items or bytes it processed.
+ * - The harness picks the number of iterations so that one run lasts about
+ *   `--min-time` milliseconds, runs `--warmup` unrecorded runs, then `--repetitions`
+ *   recorded ones. The result of a run is its time divided by its iterations.
+ * - Setup that must not be timed goes between `state.pause()` and `state.resume()`.
+ *   Benchmarks that measure time themselves (e.g. across actors on other cores) report
+ *   it with `state.setManualTime()`.
+ * - The calling thread is pinned to `--cpu` (default: the last CPU the process may use,
+ *   `-1` to disable), so runs are not migrated between cores. Threads a benchmark starts
+ *   inherit the pinning unless they call `bench::unpinThread()`.
+ * - `--json FILE` writes every sample with the median, mean, min, max and median absolute
+ *   deviation, plus the machine and build context. `benchmarks/compare.py` compares two
+ *   such files and flags regressions beyond the noise.
+ *
+ * Usage:
+ * @code
+ * int main(int argc, char* argv[]) {
+ *     bench::Suite suite("orderbook");
+ *     suite.add("orderbook/match", [](bench::State& state) {
+ *         for (uint64_t i = 0; i < state.iterations(); ++i)
+ *             bench::doNotOptimize(book.matchOrders(next()));
+ *         state.setItems(state.iterations());
+ *     });
+ *     return suite.run(argc, argv);
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#ifndef QB_BENCH_BUILD_TYPE
+#define QB_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace bench {
+
+/// Keeps the compiler from discarding a value that is computed only to be measured
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/// Keeps the compiler from caching memory across this point
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/**
+ * @brief What a benchmark function sees of one run
+ */
+class State {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit State(uint64_t iterations) : _iterations(iterations) {}
+
+    /// Number of times the measured operation must run
+    uint64_t iterations() const { return _iterations; }
+
+    /// Stops the clock, e.g. around setup done once per run
+    void pause() {
+        if (_running) {
+            _elapsed += clock::now() - _started;
+            _running = false;
+        }
+    }
+
+    /// Restarts the clock after pause()
+    void resume() {
+        if (!_running) {
+            _started = clock::now();
+            _running = true;
+        }
+    }
+
+    /// Replaces the measured time of the run
+    void setManualTime(double seconds) { _manual_seconds = seconds; }
+
+    /// Items processed by the whole run, for items_per_second
+    void setItems(uint64_t items) { _items = items; }
+
+    /// Bytes processed by the whole run, for bytes_per_second
+    void setBytes(uint64_t bytes) { _bytes = bytes; }
+
+    /// Marks the run as failed; the benchmark is reported as an error
+    void fail(std::string message) { _error = std::move(message); }
+
+    double seconds() const {
+        if (_manual_seconds >= 0) return _manual_seconds;
+        return std::chrono::duration<double>(_elapsed).count();
+    }
+    uint64_t items() const { return _items; }
+    uint64_t bytes() const { return _bytes; }
+    const std::string& error() const { return _error; }
+
+private:
+    uint64_t _iterations;
+    clock::duration _elapsed{};
+    clock::time_point _started{};
+    bool _running = false;
+    double _manual_seconds = -1;
+    uint64_t _items = 0;
+    uint64_t _bytes = 0;
+    std::string _error;
+};
+
+/**
+ * @brief A registered benchmark
+ */
+struct Benchmark {
+    std::string name;
+    std::function<void(State&)> fn;
+    uint64_t fixed_iterations = 0;
+
+    /// Runs exactly @p n iterations instead of calibrating (for expensive setups)
+    Benchmark& iterations(uint64_t n) {
+        fixed_iterations = n;
+        return *this;
+    }
+};
+
+struct Options {
+    std::string filter;
+    int warmup = 1;
+    int repetitions = 5;
+    double min_time_ms = 200;
+    int cpu = -2;  ///< -2: last online CPU, -1: not pinned
+    std::string json;
+    bool list = false;
+};
+
+/**
+ * @brief Result of one benchmark over all repetitions
+ */
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;
+    std::vector<double> samples_ns;  ///< Time per iteration of each repetition
+    double items_per_iteration = 0;
+    double bytes_per_iteration = 0;
+    std::string error;
+
+    double median() const { return quantile(samples_ns, 0.5); }
+    double mean() const {
+        double sum = 0;
+        for (double s : samples_ns) sum += s;
+        return samples_ns.empty() ? 0 : sum / samples_ns.size();
+    }
+    double min() const {
+        return samples_ns.empty() ? 0 : *std::min_element(samples_ns.begin(), samples_ns.end());
+    }
+    double max() const {
+        return samples_ns.empty() ? 0 : *std::max_element(samples_ns.begin(), samples_ns.end());
+    }
+    /// Median absolute deviation, a spread measure robust to one noisy repetition
+    double mad() const {
+        double m = median();
+        std::vector<double> deviations;
+        for (double s : samples_ns) deviations.push_back(std::fabs(s - m));
+        return quantile(deviations, 0.5);
+    }
+
+    static double quantile(std::vector<double> values, double q) {
+        if (values.empty()) return 0;
+        std::sort(values.begin(), values.end());
+        double pos = q * (values.size() - 1);
+        auto lo = static_cast<std::size_t>(pos);
+        auto hi = std::min(lo + 1, values.size() - 1);
+        return values[lo] + (values[hi] - values[lo]) * (pos - lo);
+    }
+};
+
+#ifdef __linux__
+/// CPUs the process may run on, as captured before the harness pinned the main thread
+inline const cpu_set_t& initialAffinity() {
+    static const cpu_set_t set = [] {
+        cpu_set_t s;
+        CPU_ZERO(&s);
+        sched_getaffinity(0, sizeof(s), &s);
+        return s;
+    }();
+    return set;
+}
+#endif
+
+/// Gives the calling thread the affinity of the process back; for threads a benchmark starts
+inline void unpinThread() {
+#ifdef __linux__
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &initialAffinity());
+#endif
+}
+
+/// Pins the calling thread to @p cpu; returns the CPU actually used, or -1
+inline int pinThread(int cpu) {
+#ifdef __linux__
+    initialAffinity();
+    if (cpu == -2) {
+        cpu = -1;
+        for (int i = 0; i < CPU_SETSIZE; ++i)
+            if (CPU_ISSET(i, &initialAffinity())) cpu = i;
+    }
+    if (cpu < 0) return -1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "bench: cannot pin to CPU " << cpu << ", running unpinned" << std::endl;
+        return -1;
+    }
+    return cpu;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+inline std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief The benchmarks of one program
+ */
+class Suite {
+public:
+    explicit Suite(std::string name) : _name(std::move(name)) {}
+
+    Benchmark& add(std::string name, std::function<void(State&)> fn) {
+        _benchmarks.push_back(Benchmark{std::move(name), std::move(fn)});
+        return _benchmarks.back();
+    }
+
+    const Options& options() const { return _options; }
+
+    /// Parses the options, runs the selected benchmarks and writes the report
+    int run(int argc, char* argv[]) {
+        if (!parse(argc, argv)) return 2;
+        if (_options.list) {
+            for (const auto& b : _benchmarks) std::cout << b.name << "\n";
+            return 0;
+        }
+        _pinned_cpu = pinThread(_options.cpu);
+
+        std::vector<Result> results;
+        std::printf("%-44s %12s %12s %8s %14s\n", "benchmark", "median ns", "min ns", "mad %", "items/s");
+        for (auto& b : _benchmarks) {
+            if (!_options.filter.empty() && b.name.find(_options.filter) == std::string::npos)
+                continue;
+            results.push_back(measure(b));
+            print(results.back());
+        }
+
+        bool failed = false;
+        for (const auto& r : results) failed |= !r.error.empty();
+        if (!_options.json.empty() && !writeJson(results)) return 1;
+        return failed ? 1 : 0;
+    }
+
+private:
+    bool parse(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--list") {
+                _options.list = true;
+                continue;
+            }
+            bool takes_value = arg == "--filter" || arg == "--warmup" || arg == "--repetitions" ||
+                               arg == "--min-time" || arg == "--cpu" || arg == "--json";
+            if (!takes_value || i + 1 >= argc) {
+                if (arg != "--help")
+                    std::cerr << (takes_value ? "missing value for " : "unknown option: ") << arg << "\n";
+                std::cerr << "usage: " << argv[0]
+                          << " [--filter SUBSTR] [--warmup N] [--repetitions N] [--min-time MS]"
+                             " [--cpu N|-1] [--json FILE] [--list]\n";
+                return false;
+            }
+            const char* v = argv[++i];
+            if (arg == "--filter") _options.filter = v;
+            else if (arg == "--warmup") _options.warmup = std::max(0, std::atoi(v));
+            else if (arg == "--repetitions") _options.repetitions = std::max(1, std::atoi(v));
+            else if (arg == "--min-time") _options.min_time_ms = std::atof(v);
+            else if (arg == "--cpu") _options.cpu = std::atoi(v);
+            else _options.json = v;
+        }
+        return true;
+    }
+
+    static State runOnce(Benchmark& b, uint64_t iterations) {
+        State state(iterations);
+        state.resume();
+        b.fn(state);
+        state.pause();
+        return state;
+    }
+
+    /// Smallest iteration count whose run lasts about min_time_ms
+    uint64_t calibrate(Benchmark& b, std::string& error) {
+        if (b.fixed_iterations) return b.fixed_iterations;
+        const double target = _options.min_time_ms / 1e3;
+        uint64_t n = 1;
+        for (;;) {
+            State state = runOnce(b, n);
+            if (!state.error().empty()) {
+                error = state.error();
+                return n;
+            }
+            double seconds = state.seconds();
+            if (seconds >= target || n >= (uint64_t(1) << 40)) return n;
+            // Grow by at most 10x per step, aiming slightly past the target
+            double factor = seconds > 0 ? target * 1.2 / seconds : 10.0;
+            n = static_cast<uint64_t>(n * std::min(10.0, std::max(1.5, factor))) + 1;
+            if (seconds >= target / 10) return n;
+        }
+    }
+
+    Result measure(Benchmark& b) {
+        Result result;
+        result.name = b.name;
+        result.iterations = calibrate(b, result.error);
+        if (!result.error.empty()) return result;
+
+        for (int i = 0; i < _options.warmup; ++i) runOnce(b, result.iterations);
+        for (int i = 0; i < _options.repetitions; ++i) {
+            State state = runOnce(b, result.iterations);
+            if (!state.error().empty()) {
+                result.error = state.error();
+                break;
+            }
+            result.samples_ns.push_back(state.seconds() * 1e9 / result.iterations);
+            result.items_per_iteration = double(state.items()) / result.iterations;
+            result.bytes_per_iteration = double(state.bytes()) / result.iterations;
+        }
+        return result;
+    }
+
+    static void print(const Result& r) {
+        if (!r.error.empty()) {
+            std::printf("%-44s ERROR: %s\n", r.name.c_str(), r.error.c_str());
+            return;
+        }
+        double median = r.median();
+        double items = median > 0 ? r.items_per_iteration * 1e9 / median : 0;
+        std::printf("%-44s %12.1f %12.1f %8.2f %14.0f\n", r.name.c_str(), median, r.min(),
+                    median > 0 ? 100.0 * r.mad() / median : 0.0, items);
+        std::fflush(stdout);
+    }
+
+    bool writeJson(const std::vector<Result>& results) const {
+        std::ofstream out(_options.json);
+        if (!out) {
+            std::cerr << "cannot write " << _options.json << "\n";
+            return false;
+        }
+        char host[256] = "unknown";
+#ifdef __linux__
+        gethostname(host, sizeof(host) - 1);
+#endif
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        out.precision(10);
+        out << "{\n  \"context\": {\n"
+            << "    \"suite\": \"" << jsonEscape(_name) << "\",\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"host\": \"" << jsonEscape(host) << "\",\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+            << "    \"pinned_cpu\": " << _pinned_cpu << ",\n"
+            << "    \"build_type\": \"" << QB_BENCH_BUILD_TYPE << "\",\n"
+#ifdef __VERSION__
+            << "    \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n"
+#endif
+            << "    \"repetitions\": " << _options.repetitions << ",\n"
+            << "    \"min_time_ms\": " << _options.min_time_ms << "\n"
+            << "  },\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            out << (i ? "," : "") << "\n    {\"name\": \"" << jsonEscape(r.name) << "\"";
+            if (!r.error.empty()) {
+                out << ", \"error\": \"" << jsonEscape(r.error) << "\"}";
+                continue;
+            }
+            double median = r.median();
+            out << ", \"iterations\": " << r.iterations
+                << ", \"median_ns\": " << median
+                << ", \"mean_ns\": " << r.mean()
+                << ", \"min_ns\": " << r.min()
+                << ", \"max_ns\": " << r.max()
+                << ", \"mad_ns\": " << r.mad();
+            if (r.items_per_iteration > 0 && median > 0)
+                out << ", \"items_per_second\": " << r.items_per_iteration * 1e9 / median;
+            if (r.bytes_per_iteration > 0 && median > 0)
+                out << ", \"bytes_per_second\": " << r.bytes_per_iteration * 1e9 / median;
+            out << ", \"samples_ns\": [";
+            for (std::size_t s = 0; s < r.samples_ns.size(); ++s)
+                out << (s ? ", " : "") << r.samples_ns[s];
+            out << "]}";
+        }
+        out << "\n  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+
+    std::string _name;
+    std::vector<Benchmark> _benchmarks;
+    Options _options;
+    int _pinned_cpu = -1;
+};
+
+}  // namespace bench
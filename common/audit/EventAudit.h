@@ -0,0 +1,205 @@
+/**
+ * @file examples/common/audit/EventAudit.h
+ * @brief Compile-time size budgets and a layout report for events crossing cores.
+ *
+ * @details
+ * A QB event is copied by value through the inter-core rings, so every byte of a
+ * `qb::string<1024>` field travels with it whether the string holds 3 characters or 1000.
+ * This header makes event layouts visible and keeps the hot ones small:
+ *
+ * - `QB_AUDIT_EVENT(Type, member...)` records the size, alignment and triviality of an
+ *   event and of each listed member (up to 8) in `audit::Registry::global()`.
+ * - `QB_AUDIT_HOT_EVENT(Type, budget, member...)` does the same and fails the build with a
+ *   `static_assert` when `sizeof(Type)` exceeds `budget` bytes. Use it for events sent per
+ *   message or per request; budgets are usually a whole number of cache lines.
+ *
+ * Both macros go at namespace scope, in the namespace of the event, right after its
+ * definition. Registration happens during static initialization, so the report of a
+ * program covers every audited event it includes:
+ *
+ * - `audit::Registry::global().report()` renders a Markdown table, largest events first,
+ *   with the bytes not covered by the listed members (qb::Event header, padding) and the
+ *   members that are not trivially copyable (a copy constructor and destructor run per
+ *   event).
+ * - Any program writes the report at exit when `QB_EVENT_AUDIT` is set: to stderr for
+ *   `QB_EVENT_AUDIT=1`, otherwise to the named file.
+ *
+ * Usage:
+ * @code
+ * struct PublishEvent : public qb::Event {
+ *     qb::uuid session_id;
+ *     std::string_view topic;
+ * };
+ * QB_AUDIT_HOT_EVENT(PublishEvent, 2 * audit::CACHE_LINE, session_id, topic);
+ * @endcode
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <profiling/TypeName.h>
+
+namespace audit {
+
+/// Assumed cache line size, the unit of event budgets
+constexpr std::size_t CACHE_LINE = 64;
+
+struct Member {
+    std::string name;
+    std::string type;
+    std::size_t size;
+    bool trivial;   ///< trivially copyable and destructible
+};
+
+template <typename T>
+Member member(const char* name) {
+    return {name, profiling::typeName<T>(), sizeof(T),
+            std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>};
+}
+
+struct Entry {
+    std::string name;
+    std::size_t size;
+    std::size_t align;
+    std::size_t budget;   ///< 0 when not a hot event
+    bool trivially_copyable;
+    bool trivially_destructible;
+    std::vector<Member> members;
+
+    /// Bytes of the listed members
+    std::size_t payload() const noexcept {
+        std::size_t total = 0;
+        for (const auto& m : members)
+            total += m.size;
+        return total;
+    }
+
+    std::size_t cacheLines() const noexcept { return (size + CACHE_LINE - 1) / CACHE_LINE; }
+};
+
+class Registry {
+public:
+    /// Process-wide registry; never destroyed, so it can still be read by the exit report
+    static Registry& global() {
+        static Registry* registry = [] {
+            auto* created = new Registry;
+            if (std::getenv("QB_EVENT_AUDIT"))
+                std::atexit([] { Registry::global().writeReport(); });
+            return created;
+        }();
+        return *registry;
+    }
+
+    template <typename T>
+    bool add(const char* name, std::size_t budget, std::vector<Member> members) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& entry : _entries) {
+            if (entry.name == name)
+                return true;
+        }
+        _entries.push_back({name, sizeof(T), alignof(T), budget, std::is_trivially_copyable_v<T>,
+                            std::is_trivially_destructible_v<T>, std::move(members)});
+        return true;
+    }
+
+    /// Entries, largest first
+    std::vector<Entry> entries() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto sorted = _entries;
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) { return a.size > b.size; });
+        return sorted;
+    }
+
+    /// Markdown table of every audited event
+    std::string report() const {
+        std::ostringstream out;
+        out << "| Event | Size | Lines | Align | Members | Other | Trivial | Budget | Largest member | Non-trivial members |\n"
+            << "|---|---:|---:|---:|---:|---:|---|---:|---|---|\n";
+        for (const auto& entry : entries()) {
+            const auto payload = entry.payload();
+            out << "| " << entry.name << " | " << entry.size << " | " << entry.cacheLines() << " | " << entry.align
+                << " | " << payload << " | " << (entry.size > payload ? entry.size - payload : 0) << " | "
+                << (entry.trivially_copyable && entry.trivially_destructible ? "yes" : "no") << " | ";
+            if (entry.budget)
+                out << entry.budget;
+            else
+                out << "-";
+            out << " | ";
+            const auto largest = std::max_element(entry.members.begin(), entry.members.end(),
+                                                  [](const Member& a, const Member& b) { return a.size < b.size; });
+            if (largest != entry.members.end())
+                out << largest->name << " (" << largest->size << " B)";
+            out << " | ";
+            bool first = true;
+            for (const auto& m : entry.members) {
+                if (m.trivial)
+                    continue;
+                out << (first ? "" : ", ") << m.name << ": `" << m.type << "`";
+                first = false;
+            }
+            out << " |\n";
+        }
+        return out.str();
+    }
+
+private:
+    Registry() = default;
+
+    void writeReport() const {
+        const char* target = std::getenv("QB_EVENT_AUDIT");
+        const auto text = report();
+        if (!target || std::strcmp(target, "1") == 0) {
+            std::fputs(text.c_str(), stderr);
+            return;
+        }
+        std::ofstream(target) << text;
+    }
+
+    mutable std::mutex _mutex;
+    std::vector<Entry> _entries;
+};
+
+} // namespace audit
+
+// Member list expansion: QB_AUDIT_FOR_EACH_(M, T, a, b) -> M(T, a), M(T, b)
+#define QB_AUDIT_EXPAND_(x) x
+#define QB_AUDIT_CAT_(a, b) QB_AUDIT_CAT2_(a, b)
+#define QB_AUDIT_CAT2_(a, b) a##b
+#define QB_AUDIT_NARG_(...) QB_AUDIT_EXPAND_(QB_AUDIT_NARG_N_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define QB_AUDIT_NARG_N_(_1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define QB_AUDIT_FOR_EACH_(M, T, ...) \
+    QB_AUDIT_EXPAND_(QB_AUDIT_CAT_(QB_AUDIT_FE_, QB_AUDIT_CAT_(QB_AUDIT_NARG_(__VA_ARGS__), _))(M, T, __VA_ARGS__))
+#define QB_AUDIT_FE_1_(M, T, a) M(T, a)
+#define QB_AUDIT_FE_2_(M, T, a, ...) M(T, a), QB_AUDIT_EXPAND_(QB_AUDIT_FE_1_(M, T, __VA_ARGS__))
+#define QB_AUDIT_FE_3_(M, T, a, ...) M(T, a), QB_AUDIT_EXPAND_(QB_AUDIT_FE_2_(M, T, __VA_ARGS__))
+#define QB_AUDIT_FE_4_(M, T, a, ...) M(T, a), QB_AUDIT_EXPAND_(QB_AUDIT_FE_3_(M, T, __VA_ARGS__))
+#define QB_AUDIT_FE_5_(M, T, a, ...) M(T, a), QB_AUDIT_EXPAND_(QB_AUDIT_FE_4_(M, T, __VA_ARGS__))
+#define QB_AUDIT_FE_6_(M, T, a, ...) M(T, a), QB_AUDIT_EXPAND_(QB_AUDIT_FE_5_(M, T, __VA_ARGS__))
+#define QB_AUDIT_FE_7_(M, T, a, ...) M(T, a), QB_AUDIT_EXPAND_(QB_AUDIT_FE_6_(M, T, __VA_ARGS__))
+#define QB_AUDIT_FE_8_(M, T, a, ...) M(T, a), QB_AUDIT_EXPAND_(QB_AUDIT_FE_7_(M, T, __VA_ARGS__))
+
+#define QB_AUDIT_MEMBER_(Type, name) ::audit::member<decltype(Type::name)>(#name)
+
+#define QB_AUDIT_REGISTER_(Type, budget, ...)                                                    \
+    inline const bool qb_audit_registered_##Type = ::audit::Registry::global().add<Type>(     \
+        #Type, budget, {QB_AUDIT_FOR_EACH_(QB_AUDIT_MEMBER_, Type, __VA_ARGS__)})
+
+/// Records the layout of an event and of the listed members (at least one, up to 8)
+#define QB_AUDIT_EVENT(Type, ...) QB_AUDIT_REGISTER_(Type, 0, __VA_ARGS__)
+
+/// Same as QB_AUDIT_EVENT, and fails the build when sizeof(Type) exceeds budget bytes
+#define QB_AUDIT_HOT_EVENT(Type, budget, ...)                                                    \
+    static_assert(sizeof(Type) <= (budget),                                                      \
+                  #Type " exceeds its hot event size budget of " #budget " bytes");              \
+    QB_AUDIT_REGISTER_(Type, budget, __VA_ARGS__)
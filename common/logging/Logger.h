@@ -0,0 +1,575 @@
+/**
+ * @file examples/common/logging/Logger.h
+ * @brief Asynchronous structured logger for actor hot paths.
+ *
+ * @details
+ * `qb::io::cout() << ... << std::endl` formats on the calling core, takes a process-wide
+ * lock and flushes on every line, so info-level logging in a handler that runs per message
+ * costs more than the handler. This logger moves all of that off the cores:
+ *
+ * - `QB_LOG_INFO("published {} bytes to {}", size, topic)` copies a pointer to the static
+ *   call-site descriptor (format string, level, file, line), a timestamp and the binary
+ *   arguments into a fixed-size record of the calling thread's ring. Nothing is formatted
+ *   and no lock is taken. Arithmetic values are stored as is, strings are copied (truncated to
+ *   the record size); other types are rendered with their `operator<<` once, on the producer.
+ * - Each thread (one per QB core) owns a single-producer/single-consumer ring. When the ring
+ *   is full the record is dropped and counted: logging never blocks an event loop.
+ * - A background writer drains all rings every 10 ms, orders the batch by timestamp, formats
+ *   it (`{}` placeholders, `{:.Nf}` for fixed-point with N decimals) and issues one write
+ *   per batch. File output rotates by size
+ *   (`app.log`, `app.log.1`, ...). Drops are reported in the log itself.
+ * - Levels below `QB_LOG_LEVEL` (compile time, default `QB_LOG_LEVEL_INFO`) compile to
+ *   nothing; the remaining ones can be raised at run time (`setLevel()`).
+ *
+ * The writer starts on the first log call with the defaults (stdout) and the current
+ * level; call `start()` or `startFromEnv()` before that to log to a file (`QB_LOG_FILE`,
+ * `QB_LOG_MAX_BYTES`, `QB_LOG_MAX_FILES`, `QB_LOG_LEVEL=debug|info|warn|error`).
+ * `stop()` drains everything; records logged after it are dropped until the next `start()`.
+ *
+ * Usage:
+ * @code
+ * logging::Logger::instance().startFromEnv();
+ *
+ * void Worker::on(JobEvent& evt) {
+ *     QB_LOG_DEBUG("job {} received from core {}", evt.job_id, evt.getSource().index());
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define QB_LOG_LEVEL_TRACE 0
+#define QB_LOG_LEVEL_DEBUG 1
+#define QB_LOG_LEVEL_INFO 2
+#define QB_LOG_LEVEL_WARN 3
+#define QB_LOG_LEVEL_ERROR 4
+#define QB_LOG_LEVEL_OFF 5
+
+#ifndef QB_LOG_LEVEL
+#define QB_LOG_LEVEL QB_LOG_LEVEL_INFO
+#endif
+
+namespace logging {
+
+enum class Level : uint8_t { Trace, Debug, Info, Warn, Error, Off };
+
+/// Static description of a log statement, one per call site
+struct Site {
+    Level level;
+    const char* format;
+    const char* file;
+    int line;
+};
+
+struct Options {
+    std::string path;                     ///< empty = stdout
+    std::size_t max_bytes = 64u << 20;    ///< rotate when the file reaches this size
+    unsigned max_files = 5;               ///< rotated files kept (app.log.1 .. app.log.N)
+    Level level = Level::Info;            ///< run-time filter on top of QB_LOG_LEVEL
+};
+
+namespace detail {
+
+inline uint64_t now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+template <typename... Args>
+inline void discard(const Args&...) noexcept {}
+
+enum class Tag : uint8_t { Int, Uint, Double, Bool, Char, String };
+
+/// One log statement: call site, time and encoded arguments in a cache-line multiple
+struct alignas(64) Record {
+    static constexpr std::size_t ARGS_SIZE = 256 - sizeof(const Site*) - sizeof(uint64_t) - sizeof(uint16_t);
+
+    const Site* site;
+    uint64_t timestamp_ns;
+    uint16_t size;
+    char args[ARGS_SIZE];
+};
+
+/// Appends tagged arguments to a record; truncates when the record is full
+class Encoder {
+public:
+    explicit Encoder(Record& record)
+        : _record(record) {
+        _record.size = 0;
+    }
+
+    template <typename T>
+    void add(const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>)
+            put(Tag::Bool, static_cast<uint8_t>(value));
+        else if constexpr (std::is_same_v<U, char>)
+            put(Tag::Char, value);
+        else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+            put(Tag::Int, static_cast<int64_t>(value));
+        else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+            put(Tag::Uint, static_cast<uint64_t>(value));
+        else if constexpr (std::is_floating_point_v<U>)
+            put(Tag::Double, static_cast<double>(value));
+        else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+            putString(std::string_view(value));
+        else {
+            thread_local std::ostringstream stream;
+            stream.str({});
+            stream.clear();
+            stream << value;
+            putString(stream.str());
+        }
+    }
+
+private:
+    template <typename V>
+    void put(Tag tag, V value) {
+        if (_record.size + 1 + sizeof(V) > Record::ARGS_SIZE)
+            return;
+        _record.args[_record.size++] = static_cast<char>(tag);
+        std::memcpy(_record.args + _record.size, &value, sizeof(V));
+        _record.size = static_cast<uint16_t>(_record.size + sizeof(V));
+    }
+
+    void putString(std::string_view text) {
+        if (_record.size + 1 + sizeof(uint16_t) > Record::ARGS_SIZE)
+            return;
+        const auto room = Record::ARGS_SIZE - _record.size - 1 - sizeof(uint16_t);
+        const auto length = static_cast<uint16_t>(std::min(text.size(), room));
+        _record.args[_record.size++] = static_cast<char>(Tag::String);
+        std::memcpy(_record.args + _record.size, &length, sizeof(length));
+        std::memcpy(_record.args + _record.size + sizeof(length), text.data(), length);
+        _record.size = static_cast<uint16_t>(_record.size + sizeof(length) + length);
+    }
+
+    Record& _record;
+};
+
+/// Single-producer (owning thread) / single-consumer (writer) ring of records
+class Ring {
+public:
+    static constexpr std::size_t CAPACITY = 4096;
+
+    explicit Ring(unsigned thread_index)
+        : thread_index(thread_index) {}
+
+    /// Slot to fill, or nullptr (and one more drop) when the ring is full
+    Record* reserve() noexcept {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &_records[head % CAPACITY];
+    }
+
+    void commit() noexcept {
+        _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    template <typename Fn>
+    void drain(Fn&& fn) {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        const auto head = _head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+            fn(_records[tail % CAPACITY]);
+        _tail.store(tail, std::memory_order_release);
+    }
+
+    const unsigned thread_index;
+    std::atomic<uint64_t> dropped{0};
+
+private:
+    alignas(64) std::atomic<uint64_t> _head{0};
+    alignas(64) std::atomic<uint64_t> _tail{0};
+    std::array<Record, CAPACITY> _records;
+};
+
+} // namespace detail
+
+class Logger {
+public:
+    static Logger& instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    ~Logger() { stop(); }
+
+    /// Starts the writer; a no-op if it already runs (e.g. started by a first log call)
+    void start(Options options = {}) {
+        std::lock_guard<std::mutex> lock(_control);
+        if (_running.load(std::memory_order_relaxed))
+            return;
+        _options = std::move(options);
+        _level.store(_options.level, std::memory_order_relaxed);
+        _stopped.store(false, std::memory_order_relaxed);
+        launch();
+    }
+
+    void startFromEnv() {
+        Options options;
+        if (const char* path = std::getenv("QB_LOG_FILE"))
+            options.path = path;
+        if (const char* max_bytes = std::getenv("QB_LOG_MAX_BYTES"))
+            options.max_bytes = std::strtoull(max_bytes, nullptr, 10);
+        if (const char* max_files = std::getenv("QB_LOG_MAX_FILES"))
+            options.max_files = static_cast<unsigned>(std::strtoul(max_files, nullptr, 10));
+        if (const char* level = std::getenv("QB_LOG_LEVEL"))
+            options.level = parseLevel(level);
+        start(std::move(options));
+    }
+
+    /// Drains all rings, writes the remaining records and closes the output
+    void stop() {
+        std::lock_guard<std::mutex> lock(_control);
+        if (!_running.exchange(false))
+            return;
+        _stopped.store(true, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> wake(_wake_mutex);
+            _stop_writer = true;
+        }
+        _wake.notify_one();
+        _writer.join();
+        writeBatch();
+        if (_out && _out != stdout)
+            std::fclose(_out);
+        else if (_out)
+            std::fflush(_out);
+        _out = nullptr;
+    }
+
+    void setLevel(Level level) noexcept { _level.store(level, std::memory_order_relaxed); }
+
+    bool enabled(Level level) const noexcept {
+        return level >= _level.load(std::memory_order_relaxed);
+    }
+
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(_rings_mutex);
+        uint64_t total = 0;
+        for (const auto& ring : _rings)
+            total += ring->dropped.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    template <typename... Args>
+    void log(const Site& site, const Args&... args) {
+        if (!_running.load(std::memory_order_acquire) && !startOnFirstLog())
+            return;
+        auto& own = ring();
+        auto* record = own.reserve();
+        if (!record)
+            return;
+        record->site = &site;
+        record->timestamp_ns = detail::now();
+        detail::Encoder encoder(*record);
+        (encoder.add(args), ...);
+        own.commit();
+    }
+
+    static Level parseLevel(std::string_view name) {
+        if (name == "trace") return Level::Trace;
+        if (name == "debug") return Level::Debug;
+        if (name == "warn") return Level::Warn;
+        if (name == "error") return Level::Error;
+        if (name == "off") return Level::Off;
+        return Level::Info;
+    }
+
+private:
+    Logger()
+        : _clock_offset_ns(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::system_clock::now().time_since_epoch()).count()) -
+                           static_cast<int64_t>(detail::now())) {}
+
+    /// Starts with the default output but keeps the level set by `setLevel()`;
+    /// refuses after an explicit `stop()` so a late record does not revive the writer
+    bool startOnFirstLog() {
+        std::lock_guard<std::mutex> lock(_control);
+        if (_running.load(std::memory_order_relaxed))
+            return true;
+        if (_stopped.load(std::memory_order_relaxed))
+            return false;
+        _options = Options{};
+        launch();
+        return true;
+    }
+
+    /// Caller holds `_control`
+    void launch() {
+        openOutput();
+        _stop_writer = false;
+        _running.store(true, std::memory_order_release);
+        _writer = std::thread([this] { writeLoop(); });
+    }
+
+    detail::Ring& ring() {
+        thread_local detail::Ring* ring = nullptr;
+        if (!ring) {
+            std::lock_guard<std::mutex> lock(_rings_mutex);
+            _rings.push_back(std::make_unique<detail::Ring>(static_cast<unsigned>(_rings.size())));
+            ring = _rings.back().get();
+        }
+        return *ring;
+    }
+
+    void openOutput() {
+        if (_options.path.empty()) {
+            _out = stdout;
+            return;
+        }
+        _out = std::fopen(_options.path.c_str(), "a");
+        if (!_out) {
+            std::fprintf(stderr, "[logger] cannot open %s, logging to stdout\n", _options.path.c_str());
+            _out = stdout;
+            return;
+        }
+        std::fseek(_out, 0, SEEK_END);
+        _written = static_cast<std::size_t>(std::max(0L, std::ftell(_out)));
+    }
+
+    void rotate() {
+        std::fclose(_out);
+        for (unsigned i = _options.max_files; i > 0; --i) {
+            const auto from = i == 1 ? _options.path : _options.path + "." + std::to_string(i - 1);
+            const auto to = _options.path + "." + std::to_string(i);
+            std::rename(from.c_str(), to.c_str());
+        }
+        if (_options.max_files == 0)
+            std::remove(_options.path.c_str());
+        _out = std::fopen(_options.path.c_str(), "w");
+        if (!_out)
+            _out = stdout;
+        _written = 0;
+    }
+
+    void writeLoop() {
+        std::unique_lock<std::mutex> lock(_wake_mutex);
+        while (!_stop_writer) {
+            _wake.wait_for(lock, std::chrono::milliseconds(10));
+            lock.unlock();
+            writeBatch();
+            lock.lock();
+        }
+    }
+
+    /// Writer thread only (or stop() once the writer has joined)
+    void writeBatch() {
+        std::vector<detail::Ring*> rings;
+        {
+            std::lock_guard<std::mutex> lock(_rings_mutex);
+            for (const auto& ring : _rings)
+                rings.push_back(ring.get());
+        }
+
+        _batch.clear();
+        uint64_t dropped = 0;
+        for (auto* ring : rings) {
+            ring->drain([&](const detail::Record& record) {
+                _batch.emplace_back(record.timestamp_ns, std::string());
+                format(_batch.back().second, ring->thread_index, record);
+            });
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+        if (dropped != _reported_drops) {
+            std::string line = "[logger] " + std::to_string(dropped - _reported_drops) +
+                               " record(s) dropped (ring full)\n";
+            _batch.emplace_back(detail::now(), std::move(line));
+            _reported_drops = dropped;
+        }
+        if (_batch.empty() || !_out)
+            return;
+
+        std::stable_sort(_batch.begin(), _batch.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        _buffer.clear();
+        for (const auto& [timestamp, line] : _batch)
+            _buffer += line;
+
+        if (_out != stdout && _options.max_bytes && _written + _buffer.size() > _options.max_bytes && _written)
+            rotate();
+        std::fwrite(_buffer.data(), 1, _buffer.size(), _out);
+        std::fflush(_out);
+        _written += _buffer.size();
+    }
+
+    void format(std::string& line, unsigned thread_index, const detail::Record& record) const {
+        static constexpr const char* LEVELS[] = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "OFF  "};
+
+        const auto wall_ns = static_cast<int64_t>(record.timestamp_ns) + _clock_offset_ns;
+        const auto seconds = static_cast<std::time_t>(wall_ns / 1000000000);
+        std::tm tm{};
+#if defined(_WIN32)
+        localtime_s(&tm, &seconds);
+#else
+        localtime_r(&seconds, &tm);
+#endif
+        char prefix[64];
+        const auto length = std::strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", &tm);
+        std::snprintf(prefix + length, sizeof(prefix) - length, ".%06lld %s [t%u] ",
+                      static_cast<long long>((wall_ns % 1000000000) / 1000),
+                      LEVELS[static_cast<int>(record.site->level)], thread_index);
+        line += prefix;
+
+        std::size_t offset = 0;
+        for (const char* c = record.site->format; *c; ++c) {
+            if (c[0] == '{' && c[1] == '}') {
+                appendArg(line, record, offset);
+                ++c;
+            } else if (c[0] == '{' && c[1] == ':' && c[2] == '.' && c[3] >= '0' && c[3] <= '9' &&
+                       c[4] == 'f' && c[5] == '}') {
+                appendArg(line, record, offset, c[3] - '0');  // {:.Nf}
+                c += 5;
+            } else {
+                line += *c;
+            }
+        }
+        line += '\n';
+    }
+
+    /// Appends the next argument; `precision` >= 0 prints a floating-point value with that many decimals
+    static void appendArg(std::string& line, const detail::Record& record, std::size_t& offset,
+                          int precision = -1) {
+        if (offset >= record.size) {
+            line += "{}";
+            return;
+        }
+        const auto tag = static_cast<detail::Tag>(record.args[offset++]);
+        const char* data = record.args + offset;
+        char number[320];  // %.9f of the largest double
+        switch (tag) {
+        case detail::Tag::Int: {
+            int64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(value));
+            line += number;
+            offset += sizeof(value);
+            break;
+        }
+        case detail::Tag::Uint: {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value));
+            line += number;
+            offset += sizeof(value);
+            break;
+        }
+        case detail::Tag::Double: {
+            double value;
+            std::memcpy(&value, data, sizeof(value));
+            if (precision >= 0)
+                std::snprintf(number, sizeof(number), "%.*f", precision, value);
+            else
+                std::snprintf(number, sizeof(number), "%g", value);
+            line += number;
+            offset += sizeof(value);
+            break;
+        }
+        case detail::Tag::Bool:
+            line += data[0] ? "true" : "false";
+            offset += 1;
+            break;
+        case detail::Tag::Char:
+            line += data[0];
+            offset += 1;
+            break;
+        case detail::Tag::String: {
+            uint16_t length;
+            std::memcpy(&length, data, sizeof(length));
+            line.append(data + sizeof(length), length);
+            offset += sizeof(length) + length;
+            break;
+        }
+        }
+    }
+
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _stopped{false};
+    std::atomic<Level> _level{Level::Info};
+    Options _options;
+    const int64_t _clock_offset_ns;
+
+    mutable std::mutex _rings_mutex;
+    std::vector<std::unique_ptr<detail::Ring>> _rings;
+
+    std::mutex _control;
+    std::mutex _wake_mutex;
+    std::condition_variable _wake;
+    bool _stop_writer = false;
+    std::thread _writer;
+
+    // Owned by the writer
+    std::FILE* _out = nullptr;
+    std::size_t _written = 0;
+    uint64_t _reported_drops = 0;
+    std::vector<std::pair<uint64_t, std::string>> _batch;
+    std::string _buffer;
+};
+
+} // namespace logging
+
+#define QB_LOG_AT_(level_value, format_string, ...)                                              \
+    do {                                                                                         \
+        static constexpr ::logging::Site qb_log_site_{level_value, format_string, __FILE__, __LINE__}; \
+        if (::logging::Logger::instance().enabled(level_value))                                  \
+            ::logging::Logger::instance().log(qb_log_site_, ##__VA_ARGS__);                      \
+    } while (false)
+
+/// Compiled-out statement: arguments stay referenced (no unused warnings) but are never evaluated
+#define QB_LOG_DISCARD_(format_string, ...)                                                      \
+    do {                                                                                         \
+        if (false)                                                                               \
+            ::logging::detail::discard(format_string, ##__VA_ARGS__);                            \
+    } while (false)
+
+#if QB_LOG_LEVEL <= QB_LOG_LEVEL_TRACE
+#define QB_LOG_TRACE(format_string, ...) QB_LOG_AT_(::logging::Level::Trace, format_string, ##__VA_ARGS__)
+#else
+#define QB_LOG_TRACE(format_string, ...) QB_LOG_DISCARD_(format_string, ##__VA_ARGS__)
+#endif
+
+#if QB_LOG_LEVEL <= QB_LOG_LEVEL_DEBUG
+#define QB_LOG_DEBUG(format_string, ...) QB_LOG_AT_(::logging::Level::Debug, format_string, ##__VA_ARGS__)
+#else
+#define QB_LOG_DEBUG(format_string, ...) QB_LOG_DISCARD_(format_string, ##__VA_ARGS__)
+#endif
+
+#if QB_LOG_LEVEL <= QB_LOG_LEVEL_INFO
+#define QB_LOG_INFO(format_string, ...) QB_LOG_AT_(::logging::Level::Info, format_string, ##__VA_ARGS__)
+#else
+#define QB_LOG_INFO(format_string, ...) QB_LOG_DISCARD_(format_string, ##__VA_ARGS__)
+#endif
+
+#if QB_LOG_LEVEL <= QB_LOG_LEVEL_WARN
+#define QB_LOG_WARN(format_string, ...) QB_LOG_AT_(::logging::Level::Warn, format_string, ##__VA_ARGS__)
+#else
+#define QB_LOG_WARN(format_string, ...) QB_LOG_DISCARD_(format_string, ##__VA_ARGS__)
+#endif
+
+#if QB_LOG_LEVEL <= QB_LOG_LEVEL_ERROR
+#define QB_LOG_ERROR(format_string, ...) QB_LOG_AT_(::logging::Level::Error, format_string, ##__VA_ARGS__)
+#else
+#define QB_LOG_ERROR(format_string, ...) QB_LOG_DISCARD_(format_string, ##__VA_ARGS__)
+#endif
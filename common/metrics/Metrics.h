@@ -0,0 +1,427 @@
+/**
+ * @file examples/common/metrics/Metrics.h
+ * @brief Shared metrics library: sharded counters, gauges and HDR-style histograms
+ *        with a registry that renders the Prometheus text exposition format.
+ *
+ * @details
+ * The examples used to keep statistics in global `std::atomic<uint64_t>` counters
+ * that every core increments, so the cache line holding each counter bounces between
+ * cores on every event. This header replaces them with metrics that are sharded per
+ * thread (a QB `VirtualCore` is one thread):
+ *
+ * - `metrics::Counter`: monotonically increasing value. Each thread owns one
+ *   cache-line-aligned cell and is its only writer, so recording is a relaxed load
+ *   and store (a plain increment on x86/ARM, no lock prefix, no line sharing).
+ * - `metrics::Gauge`: value that goes up and down (queue depth, active orders).
+ *   Gauges change rarely compared to counters and are a single aligned atomic.
+ * - `metrics::Histogram`: log-linear buckets in the spirit of HdrHistogram
+ *   (8 sub-buckets per power of two, ~12.5% relative precision over the whole
+ *   64-bit range). Each thread lazily gets its own bucket array on first record.
+ * - `metrics::Registry`: owns metric families by name and label set; `scrape()`
+ *   merges all shards and renders Prometheus text, `Registry::global()` is the
+ *   process-wide instance used by the examples.
+ *
+ * Shards are read with relaxed loads while writers keep running: a scrape is not an
+ * atomic snapshot across metrics, which is the usual contract for Prometheus.
+ * Threads beyond `MAX_SHARDS - 1` share the last shard through atomic adds.
+ *
+ * Usage:
+ * @code
+ * auto& orders = metrics::Registry::global().counter("orders_total", "Orders received");
+ * auto& latency = metrics::Registry::global().histogram(
+ *     "match_duration_seconds", "Time to match one order", {}, 1e-9); // recorded in ns
+ * orders.inc();
+ * latency.record(elapsed_ns);
+ * std::string text = metrics::Registry::global().scrape();
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace metrics {
+
+/// Assumed destructive interference size
+constexpr std::size_t CACHE_LINE = 64;
+/// Per-thread shards of each metric; the last one is shared by any extra threads
+constexpr std::size_t MAX_SHARDS = 64;
+
+/// Prometheus label set, e.g. {{"symbol", "AAPL"}}
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+namespace detail {
+
+/// Index of the calling thread's shard, assigned on first use
+inline std::size_t threadShard() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t shard = next.fetch_add(1, std::memory_order_relaxed);
+    return shard < MAX_SHARDS - 1 ? shard : MAX_SHARDS - 1;
+}
+
+inline bool sharedShard(std::size_t shard) noexcept {
+    return shard == MAX_SHARDS - 1;
+}
+
+/// Add to a cell: plain load + store for the single owner, atomic add on the shared shard
+inline void add(std::atomic<uint64_t>& cell, uint64_t n, bool shared) noexcept {
+    if (shared)
+        cell.fetch_add(n, std::memory_order_relaxed);
+    else
+        cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline unsigned log2(uint64_t value) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Monotonic counter with one cache-line-isolated cell per thread
+ */
+class Counter {
+    struct alignas(CACHE_LINE) Cell {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Cell, MAX_SHARDS> _cells{};
+
+public:
+    void inc(uint64_t n = 1) noexcept {
+        const auto shard = detail::threadShard();
+        detail::add(_cells[shard].value, n, detail::sharedShard(shard));
+    }
+
+    /// Sum of all shards
+    uint64_t value() const noexcept {
+        uint64_t total = 0;
+        for (const auto& cell : _cells)
+            total += cell.value.load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+/**
+ * @brief Value that can go up and down
+ */
+class Gauge {
+    alignas(CACHE_LINE) std::atomic<int64_t> _value{0};
+
+public:
+    void set(int64_t value) noexcept { _value.store(value, std::memory_order_relaxed); }
+    void add(int64_t n = 1) noexcept { _value.fetch_add(n, std::memory_order_relaxed); }
+    void sub(int64_t n = 1) noexcept { _value.fetch_sub(n, std::memory_order_relaxed); }
+    int64_t value() const noexcept { return _value.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Log-linear histogram of unsigned integer values (e.g. nanoseconds)
+ *
+ * Values below 16 are counted exactly; above, every power of two is split into
+ * 8 equal sub-buckets.
+ */
+class Histogram {
+public:
+    static constexpr unsigned SUB_BITS = 3;
+    static constexpr std::size_t SUB_COUNT = std::size_t(1) << SUB_BITS;
+    static constexpr std::size_t LINEAR = 2 * SUB_COUNT;
+    static constexpr std::size_t BUCKETS = LINEAR + (64 - (SUB_BITS + 1)) * SUB_COUNT;
+
+    /// Merged view of all shards
+    struct Snapshot {
+        std::vector<uint64_t> buckets = std::vector<uint64_t>(BUCKETS, 0);
+        uint64_t count = 0;
+        uint64_t sum = 0;
+
+        /// Upper bound of the bucket holding the q-th quantile (q in [0, 1])
+        uint64_t quantile(double q) const noexcept {
+            if (!count)
+                return 0;
+            const auto rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+            uint64_t seen = 0;
+            for (std::size_t i = 0; i < BUCKETS; ++i) {
+                seen += buckets[i];
+                if (seen >= rank)
+                    return bucketHigh(i);
+            }
+            return bucketHigh(BUCKETS - 1);
+        }
+
+        /// Number of recorded values strictly below `bound`
+        uint64_t countBelow(uint64_t bound) const noexcept {
+            uint64_t below = 0;
+            for (std::size_t i = 0; i < BUCKETS && bucketHigh(i) < bound; ++i)
+                below += buckets[i];
+            return below;
+        }
+
+        double mean() const noexcept {
+            return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+        }
+    };
+
+    Histogram() = default;
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    ~Histogram() {
+        for (auto& shard : _shards)
+            delete shard.load(std::memory_order_acquire);
+    }
+
+    void record(uint64_t value) noexcept {
+        const auto index = detail::threadShard();
+        const bool shared = detail::sharedShard(index);
+        auto& shard = shardAt(index);
+        detail::add(shard.buckets[bucketOf(value)], 1, shared);
+        detail::add(shard.count, 1, shared);
+        detail::add(shard.sum, value, shared);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot merged;
+        for (const auto& slot : _shards) {
+            const Shard* shard = slot.load(std::memory_order_acquire);
+            if (!shard)
+                continue;
+            for (std::size_t i = 0; i < BUCKETS; ++i)
+                merged.buckets[i] += shard->buckets[i].load(std::memory_order_relaxed);
+            merged.count += shard->count.load(std::memory_order_relaxed);
+            merged.sum += shard->sum.load(std::memory_order_relaxed);
+        }
+        return merged;
+    }
+
+    static std::size_t bucketOf(uint64_t value) noexcept {
+        if (value < LINEAR)
+            return static_cast<std::size_t>(value);
+        const unsigned exponent = detail::log2(value);
+        const auto sub = static_cast<std::size_t>((value >> (exponent - SUB_BITS)) & (SUB_COUNT - 1));
+        return LINEAR + (exponent - (SUB_BITS + 1)) * SUB_COUNT + sub;
+    }
+
+    static uint64_t bucketLow(std::size_t bucket) noexcept {
+        if (bucket < LINEAR)
+            return bucket;
+        const auto exponent = static_cast<unsigned>((bucket - LINEAR) / SUB_COUNT + SUB_BITS + 1);
+        const uint64_t sub = (bucket - LINEAR) % SUB_COUNT;
+        return (uint64_t(1) << exponent) | (sub << (exponent - SUB_BITS));
+    }
+
+    static uint64_t bucketHigh(std::size_t bucket) noexcept {
+        return bucket + 1 < BUCKETS ? bucketLow(bucket + 1) - 1 : std::numeric_limits<uint64_t>::max();
+    }
+
+private:
+    struct alignas(CACHE_LINE) Shard {
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+    };
+
+    Shard& shardAt(std::size_t index) {
+        Shard* shard = _shards[index].load(std::memory_order_acquire);
+        if (!shard) {
+            auto* fresh = new Shard();
+            if (_shards[index].compare_exchange_strong(shard, fresh, std::memory_order_acq_rel))
+                shard = fresh;
+            else
+                delete fresh;
+        }
+        return *shard;
+    }
+
+    std::array<std::atomic<Shard*>, MAX_SHARDS> _shards{};
+};
+
+/**
+ * @brief Owner of all metrics, grouped in families by name
+ *
+ * Registration takes a lock and is meant for start-up; the returned references
+ * stay valid for the lifetime of the registry and are used lock-free.
+ */
+class Registry {
+public:
+    static Registry& global() {
+        static Registry registry;
+        return registry;
+    }
+
+    Counter& counter(const std::string& name, const std::string& help, const Labels& labels = {}) {
+        return findOrAdd(_counters, name, help, labels).metric;
+    }
+
+    Gauge& gauge(const std::string& name, const std::string& help, const Labels& labels = {}) {
+        return findOrAdd(_gauges, name, help, labels).metric;
+    }
+
+    /// @param scale factor applied on export, e.g. 1e-9 to record ns and expose seconds
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const Labels& labels = {}, double scale = 1.0) {
+        auto& entry = findOrAdd(_histograms, name, help, labels);
+        entry.scale = scale;
+        return entry.metric;
+    }
+
+    /// Prometheus text exposition format (version 0.0.4)
+    std::string scrape() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::ostringstream out;
+        out.precision(std::numeric_limits<double>::max_digits10);
+
+        for (const auto& [name, family] : _counters) {
+            header(out, name, family.help, "counter");
+            for (const auto& entry : family.series)
+                out << name << entry->labels << ' ' << entry->metric.value() << '\n';
+        }
+        for (const auto& [name, family] : _gauges) {
+            header(out, name, family.help, "gauge");
+            for (const auto& entry : family.series)
+                out << name << entry->labels << ' ' << entry->metric.value() << '\n';
+        }
+        for (const auto& [name, family] : _histograms) {
+            header(out, name, family.help, "histogram");
+            for (const auto& entry : family.series)
+                writeHistogram(out, name, *entry);
+        }
+        return out.str();
+    }
+
+private:
+    template <typename Metric>
+    struct Series {
+        std::string labels; // Pre-rendered "{k=\"v\",...}" or empty
+        Labels label_pairs;
+        double scale = 1.0;
+        Metric metric;
+    };
+
+    template <typename Metric>
+    struct Family {
+        std::string help;
+        std::vector<std::unique_ptr<Series<Metric>>> series;
+    };
+
+    template <typename Metric>
+    using Families = std::map<std::string, Family<Metric>>;
+
+    template <typename Metric>
+    Series<Metric>& findOrAdd(Families<Metric>& families, const std::string& name,
+                           const std::string& help, const Labels& labels) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (registeredElsewhere(families, name))
+            throw std::invalid_argument("metric '" + name + "' already registered with another type");
+
+        auto& family = families[name];
+        if (family.help.empty())
+            family.help = help;
+
+        const auto rendered = renderLabels(labels);
+        for (auto& entry : family.series) {
+            if (entry->labels == rendered)
+                return *entry;
+        }
+        family.series.push_back(std::make_unique<Series<Metric>>());
+        auto& entry = *family.series.back();
+        entry.labels = rendered;
+        entry.label_pairs = labels;
+        return entry;
+    }
+
+    template <typename Metric>
+    bool registeredElsewhere(const Families<Metric>& families, const std::string& name) const {
+        const bool counter = _counters.count(name) && static_cast<const void*>(&families) != &_counters;
+        const bool gauge = _gauges.count(name) && static_cast<const void*>(&families) != &_gauges;
+        const bool histogram = _histograms.count(name) && static_cast<const void*>(&families) != &_histograms;
+        return counter || gauge || histogram;
+    }
+
+    static std::string escape(const std::string& value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c : value) {
+            if (c == '\\' || c == '"')
+                escaped += '\\';
+            if (c == '\n') {
+                escaped += "\\n";
+                continue;
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    static std::string renderLabels(const Labels& labels, const std::string& extra = {}) {
+        if (labels.empty() && extra.empty())
+            return {};
+        std::string rendered = "{";
+        for (const auto& [key, value] : labels) {
+            if (rendered.size() > 1)
+                rendered += ',';
+            rendered += key + "=\"" + escape(value) + '"';
+        }
+        if (!extra.empty()) {
+            if (rendered.size() > 1)
+                rendered += ',';
+            rendered += extra;
+        }
+        return rendered + '}';
+    }
+
+    static void header(std::ostringstream& out, const std::string& name, const std::string& help,
+                       const char* type) {
+        out << "# HELP " << name << ' ' << help << '\n';
+        out << "# TYPE " << name << ' ' << type << '\n';
+    }
+
+    // Cumulative buckets at powers of two of the recorded unit, up to the first one
+    // that holds every value. Values are integers and bucket edges fall on powers of
+    // two, so the values below 2^k are exactly those <= 2^k - 1: that is the `le`
+    // bound exported, as Prometheus buckets count the values <= their bound.
+    static void writeHistogram(std::ostringstream& out, const std::string& name,
+                               const Series<Histogram>& entry) {
+        const auto snapshot = entry.metric.snapshot();
+        for (unsigned exponent = 0; exponent < 64; ++exponent) {
+            const uint64_t bound = uint64_t(1) << exponent;
+            const uint64_t below = snapshot.countBelow(bound);
+            std::ostringstream le;
+            le << "le=\"" << static_cast<double>(bound - 1) * entry.scale << '"';
+            out << name << "_bucket" << renderLabels(entry.label_pairs, le.str()) << ' ' << below << '\n';
+            if (below == snapshot.count)
+                break;
+        }
+        out << name << "_bucket" << renderLabels(entry.label_pairs, "le=\"+Inf\"") << ' '
+            << snapshot.count << '\n';
+        out << name << "_sum" << entry.labels << ' ' << static_cast<double>(snapshot.sum) * entry.scale << '\n';
+        out << name << "_count" << entry.labels << ' ' << snapshot.count << '\n';
+    }
+
+    mutable std::mutex _mutex;
+    Families<Counter> _counters;
+    Families<Gauge> _gauges;
+    Families<Histogram> _histograms;
+};
+
+} // namespace metrics
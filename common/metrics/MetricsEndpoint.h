@@ -0,0 +1,67 @@
+/**
+ * @file examples/common/metrics/MetricsEndpoint.h
+ * @brief HTTP actor exposing a `metrics::Registry` at `/metrics` for Prometheus.
+ *
+ * @details
+ * A minimal `qb::http::Server<>` actor with a single route. Each scrape merges the
+ * per-thread shards of every registered metric on the endpoint's core; the actors
+ * recording the metrics are never involved. Place it on a core that is not on a
+ * hot path.
+ *
+ * Usage:
+ * @code
+ * engine.addActor<metrics::MetricsEndpoint>(0, "tcp://0.0.0.0:9100");
+ * // curl http://localhost:9100/metrics
+ * @endcode
+ *
+ * Requires linking against `qbm-http`.
+ */
+
+#pragma once
+
+#include <qb/actor.h>
+#include <qb/io.h>
+#include <http/http.h>
+#include <string>
+#include <utility>
+#include "Metrics.h"
+
+namespace metrics {
+
+class MetricsEndpoint : public qb::Actor
+                      , public qb::http::Server<> {
+    std::string _listen_uri;
+    Registry& _registry;
+
+public:
+    explicit MetricsEndpoint(std::string listen_uri = "tcp://0.0.0.0:9100",
+                             Registry& registry = Registry::global())
+        : _listen_uri(std::move(listen_uri))
+        , _registry(registry) {}
+
+    bool onInit() override {
+        registerEvent<qb::KillEvent>(*this);
+
+        router().get("/metrics", [this](auto ctx) {
+            ctx->response().status() = qb::http::Status::OK;
+            ctx->response().add_header("Content-Type", "text/plain; version=0.0.4");
+            ctx->response().body() = _registry.scrape();
+            ctx->complete(qb::http::AsyncTaskResult::COMPLETE);
+        });
+        router().compile();
+
+        if (!listen({_listen_uri})) {
+            qb::io::cerr() << "MetricsEndpoint: failed to listen on " << _listen_uri << std::endl;
+            return false;
+        }
+        start();
+        qb::io::cout() << "MetricsEndpoint: serving /metrics on " << _listen_uri << std::endl;
+        return true;
+    }
+
+    void on(const qb::KillEvent&) noexcept {
+        kill();
+    }
+};
+
+} // namespace metrics
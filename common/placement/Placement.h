@@ -0,0 +1,517 @@
+/**
+ * @file examples/common/placement/Placement.h
+ * @brief Declarative mapping of actor roles to cores, aware of NUMA nodes and SMT siblings.
+ *
+ * @details
+ * A main declares its actor roles with the number of actors and a default core spec,
+ * then reads overrides from a placement file or the command line, so a deployment can be
+ * tuned without recompiling:
+ *
+ * - `3`, `1,3`, `4-7`: explicit cores; the role's actors are assigned round-robin.
+ * - `node:1`: the cores of NUMA node 1, first SMT thread of each physical core first.
+ * - `auto:hot`: one exclusive core per actor, for actors on the critical path. Isolated
+ *   cores (`isolcpus=`) are used first, then physical cores whose SMT siblings are all
+ *   free; the siblings are then kept away from every `auto:io` role.
+ * - `auto:io`: the remaining cores, spread round-robin over NUMA nodes and physical
+ *   cores (second SMT threads last), continuing across `auto:io` roles.
+ * - A `@N` suffix restricts an `auto` spec to NUMA node N (`auto:hot@0`).
+ *
+ * The topology is read from `/sys/devices/system` (online CPUs, package and core ids,
+ * SMT siblings, NUMA nodes, isolated CPUs). Without it every CPU counts as its own
+ * physical core on node 0. QB core indexes are CPU ids: `pin()` sets each used core's
+ * affinity to its CPU (explicit cores beyond the online CPUs are left unpinned).
+ *
+ * Overrides, later ones winning: the file named by `QB_PLACEMENT`, `--placement FILE`,
+ * then `--place role=spec` (repeatable). Files hold one `role = spec` per line, `#`
+ * starts a comment. Other arguments are left to the main.
+ *
+ * Usage:
+ * @code
+ * auto placement = placement::Placement::fromArgs({
+ *     {"topic_manager", 1, "2"},
+ *     {"server", 2, "1"},
+ * }, argc, argv);
+ * std::cout << placement.describe();
+ *
+ * auto topic_manager = engine.addActor<TopicManagerActor>(placement.core("topic_manager"));
+ * for (auto core : placement.cores("server"))
+ *     engine.addActor<ServerActor>(core, topic_manager);
+ * placement.pin(engine);
+ * @endcode
+ * @code
+ * $ ./broker_server --place topic_manager=auto:hot@0 --place server=auto:io
+ * @endcode
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace placement {
+
+/// Parses a kernel CPU list ("0-3,8,10-11")
+inline std::vector<unsigned> parseCpuList(const std::string& text) {
+    std::vector<unsigned> cpus;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        item.erase(std::remove_if(item.begin(), item.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)); }),
+                   item.end());
+        if (item.empty())
+            continue;
+        const auto dash = item.find('-');
+        try {
+            const auto first = static_cast<unsigned>(std::stoul(item.substr(0, dash)));
+            const auto last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(item.substr(dash + 1)));
+            if (last < first)
+                throw std::invalid_argument(item);
+            for (auto cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        } catch (const std::logic_error&) {
+            throw std::invalid_argument("invalid CPU list '" + text + "'");
+        }
+    }
+    return cpus;
+}
+
+struct Cpu {
+    unsigned id;
+    unsigned node = 0;
+    unsigned package = 0;
+    unsigned core = 0;        ///< physical core id within the package
+    unsigned thread = 0;      ///< rank among the SMT siblings, 0 for the first
+    bool isolated = false;
+};
+
+class Topology {
+public:
+    /// Reads the topology of this machine; falls back to one node without SMT
+    static Topology detect(const std::string& root = "/sys/devices/system") {
+        Topology topology;
+        std::string text;
+        std::vector<unsigned> online;
+        if (readFile(root + "/cpu/online", text))
+            online = parseCpuList(text);
+        if (online.empty()) {
+            for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+                online.push_back(cpu);
+        }
+
+        std::set<unsigned> isolated;
+        if (readFile(root + "/cpu/isolated", text)) {
+            for (auto cpu : parseCpuList(text))
+                isolated.insert(cpu);
+        }
+
+        std::map<unsigned, unsigned> node_of;
+        for (unsigned node = 0; node < 1024; ++node) {
+            if (!readFile(root + "/node/node" + std::to_string(node) + "/cpulist", text))
+                continue;
+            for (auto cpu : parseCpuList(text))
+                node_of[cpu] = node;
+        }
+
+        for (auto id : online) {
+            Cpu cpu{id};
+            const auto base = root + "/cpu/cpu" + std::to_string(id) + "/topology/";
+            cpu.package = readNumber(base + "physical_package_id", 0);
+            cpu.core = readNumber(base + "core_id", id);
+            if (readFile(base + "thread_siblings_list", text)) {
+                const auto siblings = parseCpuList(text);
+                cpu.thread = static_cast<unsigned>(std::find(siblings.begin(), siblings.end(), id) - siblings.begin());
+                if (cpu.thread == siblings.size())
+                    cpu.thread = 0;
+            }
+            const auto node = node_of.find(id);
+            cpu.node = node != node_of.end() ? node->second : 0;
+            cpu.isolated = isolated.count(id) != 0;
+            topology._cpus.push_back(cpu);
+        }
+        return topology;
+    }
+
+    /// Builds a topology from a CPU list, e.g. for a machine described in a test
+    static Topology fromCpus(std::vector<Cpu> cpus) {
+        Topology topology;
+        topology._cpus = std::move(cpus);
+        return topology;
+    }
+
+    const std::vector<Cpu>& cpus() const noexcept { return _cpus; }
+
+    const Cpu* find(unsigned id) const noexcept {
+        for (const auto& cpu : _cpus) {
+            if (cpu.id == id)
+                return &cpu;
+        }
+        return nullptr;
+    }
+
+    unsigned nodes() const noexcept {
+        unsigned count = 0;
+        for (const auto& cpu : _cpus)
+            count = std::max(count, cpu.node + 1);
+        return count;
+    }
+
+    /// True if both CPUs are threads of the same physical core
+    static bool siblings(const Cpu& a, const Cpu& b) noexcept {
+        return a.package == b.package && a.core == b.core;
+    }
+
+private:
+    static bool readFile(const std::string& path, std::string& text) {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+        std::getline(file, text);
+        return true;
+    }
+
+    static unsigned readNumber(const std::string& path, unsigned fallback) {
+        std::string text;
+        if (!readFile(path, text))
+            return fallback;
+        try {
+            return static_cast<unsigned>(std::stoul(text));
+        } catch (const std::logic_error&) {
+            return fallback;
+        }
+    }
+
+    std::vector<Cpu> _cpus;
+};
+
+/// An actor role of a main: its name, number of actors and default core spec
+struct Role {
+    std::string name;
+    unsigned count = 1;
+    std::string spec;
+};
+
+class Placement {
+public:
+    explicit Placement(std::vector<Role> roles, Topology topology = Topology::detect())
+        : _roles(std::move(roles))
+        , _topology(std::move(topology)) {
+        for (const auto& role : _roles) {
+            if (role.count == 0)
+                throw std::invalid_argument("role '" + role.name + "' has no actors");
+        }
+    }
+
+    /**
+     * @brief Declares the roles, applies the overrides of the environment and command line
+     *        and resolves the placement
+     *
+     * Prints the error and exits on an invalid placement: meant for mains.
+     */
+    static Placement fromArgs(std::vector<Role> roles, int argc, char* argv[]) {
+        try {
+            Placement placement(std::move(roles));
+            placement.loadArgs(argc, argv);
+            placement.resolve();
+            return placement;
+        } catch (const std::exception& e) {
+            std::cerr << "Placement: " << e.what() << std::endl;
+            std::exit(2);
+        }
+    }
+
+    /// Overrides the core spec of a role
+    void set(const std::string& name, const std::string& spec) {
+        role(name).spec = spec;
+        _resolved = false;
+    }
+
+    /// Reads `role = spec` lines
+    void loadFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file)
+            throw std::invalid_argument("cannot read placement file '" + path + "'");
+        std::string line;
+        for (unsigned number = 1; std::getline(file, line); ++number) {
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty())
+                continue;
+            const auto equal = line.find('=');
+            if (equal == std::string::npos)
+                throw std::invalid_argument(path + ":" + std::to_string(number) + ": expected 'role = spec'");
+            set(trim(line.substr(0, equal)), trim(line.substr(equal + 1)));
+        }
+    }
+
+    /// Applies `QB_PLACEMENT`, `--placement FILE` and `--place role=spec`; ignores other arguments
+    void loadArgs(int argc, char* argv[]) {
+        if (const char* path = std::getenv("QB_PLACEMENT"))
+            loadFile(path);
+        for (int i = 1; i + 1 < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--placement") {
+                loadFile(argv[++i]);
+            } else if (arg == "--place") {
+                const std::string value = argv[++i];
+                const auto equal = value.find('=');
+                if (equal == std::string::npos)
+                    throw std::invalid_argument("expected --place role=spec, got '" + value + "'");
+                set(value.substr(0, equal), value.substr(equal + 1));
+            }
+        }
+    }
+
+    /// Assigns a core to every actor of every role
+    void resolve() {
+        _cores.clear();
+        _exclusive.clear();
+        _reserved.clear();
+        if (_topology.cpus().empty())
+            throw std::invalid_argument("no CPU found");
+
+        // Explicit cores first, then exclusive cores for hot roles, then shared cores
+        std::vector<const Role*> hot, node, io;
+        for (const auto& role : _roles) {
+            const auto spec = parseSpec(role);
+            if (spec.kind == Kind::Explicit)
+                assign(role, spec.cpus);
+            else if (spec.kind == Kind::Hot)
+                hot.push_back(&role);
+            else if (spec.kind == Kind::Node)
+                node.push_back(&role);
+            else
+                io.push_back(&role);
+        }
+        for (const auto* role : hot)
+            resolveHot(*role, parseSpec(*role).node);
+        for (const auto* role : node)
+            assign(*role, shared(parseSpec(*role).node));
+        unsigned cursor = 0;
+        for (const auto* role : io) {
+            const auto candidates = shared(parseSpec(*role).node);
+            auto& cores = _cores[role->name];
+            for (unsigned i = 0; i < role->count; ++i)
+                cores.push_back(candidates[cursor++ % candidates.size()]);
+        }
+        _resolved = true;
+    }
+
+    /// Core of the index-th actor of a role
+    unsigned core(const std::string& name, unsigned index = 0) const {
+        const auto& list = cores(name);
+        return list[index % list.size()];
+    }
+
+    /// Cores of all actors of a role, one per actor
+    const std::vector<unsigned>& cores(const std::string& name) const {
+        if (!_resolved)
+            throw std::logic_error("placement not resolved");
+        const auto found = _cores.find(name);
+        if (found == _cores.end())
+            throw std::invalid_argument("unknown role '" + name + "'");
+        return found->second;
+    }
+
+    /// Every core used by a role
+    std::set<unsigned> used() const {
+        std::set<unsigned> all;
+        for (const auto& [name, cores] : _cores)
+            all.insert(cores.begin(), cores.end());
+        return all;
+    }
+
+    /// Pins each used QB core to the CPU of the same id, if that CPU is online
+    template <typename Engine>
+    void pin(Engine& engine) const {
+        for (auto core : used()) {
+            if (!_topology.find(core))
+                continue;
+            const auto id = static_cast<uint16_t>(core);   // qb::CoreId
+            engine.core(id).setAffinity({id});
+        }
+    }
+
+    /// One line per role: spec and cores with their NUMA node
+    std::string describe() const {
+        std::ostringstream out;
+        out << "Placement (" << _topology.cpus().size() << " CPUs, " << _topology.nodes() << " NUMA nodes):\n";
+        for (const auto& role : _roles) {
+            out << "  " << role.name << " [" << role.spec << "] ->";
+            for (auto cpu : cores(role.name)) {
+                const auto* info = _topology.find(cpu);
+                out << ' ' << cpu;
+                if (info)
+                    out << "(n" << info->node << (info->isolated ? ",iso" : "") << ')';
+            }
+            out << '\n';
+        }
+        return out.str();
+    }
+
+    const Topology& topology() const noexcept { return _topology; }
+
+private:
+    enum class Kind { Explicit, Node, Hot, Io };
+
+    struct Spec {
+        Kind kind;
+        std::vector<unsigned> cpus;
+        int node = -1;   ///< NUMA node restriction, -1 for none
+    };
+
+    Role& role(const std::string& name) {
+        for (auto& role : _roles) {
+            if (role.name == name)
+                return role;
+        }
+        throw std::invalid_argument("unknown role '" + name + "'");
+    }
+
+    Spec parseSpec(const Role& role) const {
+        const auto& text = role.spec;
+        auto fail = [&](const std::string& why) {
+            return std::invalid_argument("role '" + role.name + "': " + why + " in '" + text + "'");
+        };
+        Spec spec{Kind::Explicit, {}, -1};
+        if (text.rfind("auto:", 0) == 0) {
+            const auto at = text.find('@');
+            const auto mode = text.substr(5, at == std::string::npos ? std::string::npos : at - 5);
+            if (mode == "hot")
+                spec.kind = Kind::Hot;
+            else if (mode == "io")
+                spec.kind = Kind::Io;
+            else
+                throw fail("unknown mode '" + mode + "'");
+            if (at != std::string::npos)
+                spec.node = parseNode(text.substr(at + 1), fail);
+        } else if (text.rfind("node:", 0) == 0) {
+            spec.kind = Kind::Node;
+            spec.node = parseNode(text.substr(5), fail);
+        } else {
+            // Explicit cores need not exist: QB runs more cores than CPUs, unpinned
+            spec.cpus = parseCpuList(text);
+            if (spec.cpus.empty())
+                throw fail("no core");
+        }
+        return spec;
+    }
+
+    template <typename Fail>
+    int parseNode(const std::string& text, Fail&& fail) const {
+        try {
+            const auto node = static_cast<unsigned>(std::stoul(text));
+            if (node >= _topology.nodes())
+                throw fail("no NUMA node " + text);
+            return static_cast<int>(node);
+        } catch (const std::logic_error&) {
+            throw fail("invalid NUMA node '" + text + "'");
+        }
+    }
+
+    void assign(const Role& role, const std::vector<unsigned>& cpus) {
+        if (cpus.empty())
+            throw std::invalid_argument("role '" + role.name + "': no core available");
+        auto& cores = _cores[role.name];
+        for (unsigned i = 0; i < role.count; ++i)
+            cores.push_back(cpus[i % cpus.size()]);
+    }
+
+    bool taken(unsigned cpu) const {
+        for (const auto& [name, cores] : _cores) {
+            if (std::find(cores.begin(), cores.end(), cpu) != cores.end())
+                return true;
+        }
+        return false;
+    }
+
+    /// One exclusive CPU per actor: isolated CPUs first, then idle physical cores
+    void resolveHot(const Role& role, int node) {
+        auto& cores = _cores[role.name];
+        for (unsigned i = 0; i < role.count; ++i) {
+            const Cpu* pick = nullptr;
+            for (const auto& cpu : _topology.cpus()) {
+                if (cpu.isolated && inNode(cpu, node) && !taken(cpu.id)) {
+                    pick = &cpu;
+                    break;
+                }
+            }
+            for (const auto& cpu : _topology.cpus()) {
+                if (pick)
+                    break;
+                if (cpu.isolated || cpu.thread != 0 || !inNode(cpu, node))
+                    continue;
+                bool idle = true;
+                for (const auto& other : _topology.cpus())
+                    idle = idle && !(Topology::siblings(cpu, other) && (taken(other.id) || _reserved.count(other.id)));
+                if (idle)
+                    pick = &cpu;
+            }
+            if (!pick)
+                throw std::invalid_argument("role '" + role.name + "': no free core for auto:hot");
+            cores.push_back(pick->id);
+            _exclusive.insert(pick->id);
+            for (const auto& other : _topology.cpus()) {
+                if (Topology::siblings(*pick, other))
+                    _reserved.insert(other.id);
+            }
+        }
+    }
+
+    /// CPUs for shared roles, spread over nodes and physical cores, second SMT threads last
+    std::vector<unsigned> shared(int node) const {
+        std::vector<const Cpu*> free;
+        for (const auto& cpu : _topology.cpus()) {
+            if (!cpu.isolated && !_reserved.count(cpu.id) && !_exclusive.count(cpu.id) && inNode(cpu, node))
+                free.push_back(&cpu);
+        }
+        if (free.empty()) {
+            // Everything is reserved: share the non-exclusive CPUs rather than fail
+            for (const auto& cpu : _topology.cpus()) {
+                if (!_exclusive.count(cpu.id) && inNode(cpu, node))
+                    free.push_back(&cpu);
+            }
+        }
+        // Order by (SMT rank, position within the node), then interleave the nodes
+        std::stable_sort(free.begin(), free.end(), [](const Cpu* a, const Cpu* b) { return a->thread < b->thread; });
+        std::map<std::pair<unsigned, unsigned>, unsigned> seen;
+        std::vector<std::pair<std::pair<unsigned, unsigned>, unsigned>> order;
+        for (const auto* cpu : free)
+            order.push_back({{cpu->thread, seen[{cpu->node, cpu->thread}]++}, cpu->id});
+        std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        std::vector<unsigned> cpus;
+        for (const auto& entry : order)
+            cpus.push_back(entry.second);
+        return cpus;
+    }
+
+    static bool inNode(const Cpu& cpu, int node) noexcept {
+        return node < 0 || cpu.node == static_cast<unsigned>(node);
+    }
+
+    static std::string trim(const std::string& text) {
+        const auto first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos)
+            return {};
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    std::vector<Role> _roles;
+    Topology _topology;
+    std::map<std::string, std::vector<unsigned>> _cores;
+    std::set<unsigned> _exclusive;   ///< CPUs of auto:hot actors
+    std::set<unsigned> _reserved;    ///< those CPUs and their SMT siblings
+    bool _resolved = false;
+};
+
+} // namespace placement
@@ -0,0 +1,325 @@
+/**
+ * @file examples/common/profiling/Profiler.h
+ * @brief Opt-in instrumentation of actor event handlers and inter-core queues.
+ *
+ * @details
+ * Answers the first question asked when an actor falls behind: which handler is slow,
+ * and is the time spent running it or waiting in the mailbox? Three macros are placed
+ * in actor code:
+ *
+ * - `QB_PROFILE_HANDLER(evt)` at the top of an `on(Event&)` handler: counts invocations
+ *   and records the handler duration per (actor type, event type).
+ * - `QB_PROFILE_SEND(evt)` right after `auto& evt = push<Event>(...)`: stamps the send
+ *   time into the event and counts it as in flight on the (source core, destination core)
+ *   pair.
+ * - `QB_PROFILE_STAMP` as an extra base of an event (`struct E : qb::Event, QB_PROFILE_STAMP`):
+ *   gives the event room for the send time. Events without it are still timed, they just
+ *   have no queue statistics.
+ *
+ * When a stamped event is handled, the wait time (send to handler start) is recorded per
+ * core pair, and every 64th receive samples the queue depth, i.e. events sent on that pair
+ * but not yet handled. This is the backlog an actor sees in its mailbox, measured without
+ * touching QB internals.
+ *
+ * Everything is compiled out unless `QB_EXAMPLES_PROFILE` is defined (CMake option of the
+ * same name): the macros expand to nothing and `QB_PROFILE_STAMP` is an empty base that
+ * takes no space in the event. When enabled, the data lives in `metrics::Registry::global()`
+ * (`qb_profile_*` families, so a `metrics::MetricsEndpoint` exposes it too) and can be dumped
+ * with `profiling::Profiler::instance().table()` or `.json()`.
+ *
+ * Usage:
+ * @code
+ * struct WorkEvent : qb::Event, QB_PROFILE_STAMP { ... };
+ *
+ * void Producer::send() {
+ *     auto& evt = push<WorkEvent>(_worker);
+ *     QB_PROFILE_SEND(evt);
+ * }
+ *
+ * void Worker::on(WorkEvent& evt) {
+ *     QB_PROFILE_HANDLER(evt);
+ *     ...
+ * }
+ *
+ * // after engine.join()
+ * std::cout << profiling::Profiler::instance().table();
+ * @endcode
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#ifdef QB_EXAMPLES_PROFILE
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <metrics/Metrics.h>
+#include "TypeName.h"
+
+namespace profiling {
+
+/// Core ids above this share the last row/column of the core pair matrix
+constexpr std::size_t MAX_CORES = 64;
+/// Queue depth is sampled on one receive out of this many per event type and thread
+constexpr uint64_t DEPTH_SAMPLE_PERIOD = 64;
+
+inline uint64_t now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// Extra event base carrying the send timestamp (see QB_PROFILE_STAMP)
+struct Stamp {
+    uint64_t profile_sent_ns = 0;
+};
+
+/// Statistics of one handler, shared by all actors of the same type
+struct HandlerStats {
+    std::string actor;
+    std::string event;
+    metrics::Histogram& duration;  ///< ns; count() is the invocation count
+};
+
+/// Statistics of one (source core, destination core) pair
+struct QueueStats {
+    unsigned source;
+    unsigned destination;
+    metrics::Counter& sent;
+    metrics::Counter& received;
+    metrics::Histogram& wait;      ///< ns from push to handler start
+    metrics::Histogram& depth;     ///< sampled events in flight
+};
+
+class Profiler {
+public:
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /// Registration happens once per call site (function-local static in QB_PROFILE_HANDLER)
+    template <typename Actor, typename Event>
+    HandlerStats& handler() {
+        auto actor = typeName<Actor>();
+        auto event = typeName<Event>();
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& stats : _handlers)
+            if (stats.actor == actor && stats.event == event)
+                return stats;
+        auto& duration = _registry.histogram(
+            "qb_profile_handler_duration_seconds", "Actor event handler run time",
+            {{"actor", actor}, {"event", event}}, 1e-9);
+        _handlers.push_back(HandlerStats{std::move(actor), std::move(event), duration});
+        return _handlers.back();
+    }
+
+    QueueStats& queue(unsigned source, unsigned destination) {
+        source = std::min<unsigned>(source, MAX_CORES - 1);
+        destination = std::min<unsigned>(destination, MAX_CORES - 1);
+        auto& slot = _queues[source * MAX_CORES + destination];
+        if (auto* stats = slot.load(std::memory_order_acquire))
+            return *stats;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (auto* stats = slot.load(std::memory_order_acquire))
+            return *stats;
+        const metrics::Labels labels{{"source_core", std::to_string(source)},
+                                     {"destination_core", std::to_string(destination)}};
+        _queue_list.push_back(QueueStats{
+            source, destination,
+            _registry.counter("qb_profile_events_sent_total", "Stamped events pushed", labels),
+            _registry.counter("qb_profile_events_received_total", "Stamped events handled", labels),
+            _registry.histogram("qb_profile_queue_wait_seconds", "Time from push to handler start",
+                                labels, 1e-9),
+            _registry.histogram("qb_profile_queue_depth", "Sampled events in flight", labels)});
+        slot.store(&_queue_list.back(), std::memory_order_release);
+        return _queue_list.back();
+    }
+
+    template <typename Event>
+    void sent(Event& evt, unsigned source) noexcept {
+        if constexpr (std::is_base_of_v<Stamp, Event>) {
+            evt.profile_sent_ns = now();
+            queue(source, evt.getDestination().index()).sent.inc();
+        }
+    }
+
+    template <typename Event>
+    void received(const Event& evt, unsigned destination, uint64_t start) noexcept {
+        if constexpr (std::is_base_of_v<Stamp, Event>) {
+            if (!evt.profile_sent_ns)
+                return;
+            auto& stats = queue(evt.getSource().index(), destination);
+            stats.received.inc();
+            stats.wait.record(start > evt.profile_sent_ns ? start - evt.profile_sent_ns : 0);
+
+            thread_local uint64_t receives = 0;
+            if (++receives % DEPTH_SAMPLE_PERIOD == 0) {
+                const auto sent = stats.sent.value();
+                const auto received = stats.received.value();
+                stats.depth.record(sent > received ? sent - received : 0);
+            }
+        }
+    }
+
+    /// Human-readable report, one row per handler and per core pair
+    std::string table() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::ostringstream out;
+        char line[256];
+
+        out << "=== Handlers (per actor type / event type) ===\n";
+        std::snprintf(line, sizeof(line), "%-28s %-24s %12s %10s %10s %10s %12s\n",
+                      "actor", "event", "count", "mean_us", "p50_us", "p99_us", "total_ms");
+        out << line;
+        for (const auto* stats : sortedHandlers()) {
+            const auto snap = stats->duration.snapshot();
+            std::snprintf(line, sizeof(line), "%-28s %-24s %12llu %10.2f %10.2f %10.2f %12.2f\n",
+                          stats->actor.c_str(), stats->event.c_str(),
+                          static_cast<unsigned long long>(snap.count), snap.mean() / 1e3,
+                          snap.quantile(0.5) / 1e3, snap.quantile(0.99) / 1e3, snap.sum / 1e6);
+            out << line;
+        }
+
+        out << "=== Queues (source core -> destination core) ===\n";
+        std::snprintf(line, sizeof(line), "%-8s %12s %10s %10s %10s %12s %10s\n",
+                      "pair", "received", "in_flight", "wait_p50", "wait_p99", "depth_p99", "depth_max");
+        out << line;
+        for (const auto& stats : _queue_list) {
+            const auto wait = stats.wait.snapshot();
+            const auto depth = stats.depth.snapshot();
+            const auto sent = stats.sent.value();
+            const auto received = stats.received.value();
+            char pair[32];
+            std::snprintf(pair, sizeof(pair), "%u->%u", stats.source, stats.destination);
+            std::snprintf(line, sizeof(line), "%-8s %12llu %10llu %8.2fus %8.2fus %12llu %10llu\n",
+                          pair, static_cast<unsigned long long>(received),
+                          static_cast<unsigned long long>(sent > received ? sent - received : 0),
+                          wait.quantile(0.5) / 1e3, wait.quantile(0.99) / 1e3,
+                          static_cast<unsigned long long>(depth.quantile(0.99)),
+                          static_cast<unsigned long long>(depth.quantile(1.0)));
+            out << line;
+        }
+        return out.str();
+    }
+
+    /// Same data as table(), durations in nanoseconds
+    std::string json() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::ostringstream out;
+        out << "{\"handlers\":[";
+        bool first = true;
+        for (const auto* stats : sortedHandlers()) {
+            const auto snap = stats->duration.snapshot();
+            out << (first ? "" : ",") << "{\"actor\":\"" << stats->actor
+                << "\",\"event\":\"" << stats->event
+                << "\",\"count\":" << snap.count
+                << ",\"total_ns\":" << snap.sum
+                << ",\"mean_ns\":" << snap.mean()
+                << ",\"p50_ns\":" << snap.quantile(0.5)
+                << ",\"p99_ns\":" << snap.quantile(0.99)
+                << ",\"max_ns\":" << snap.quantile(1.0) << '}';
+            first = false;
+        }
+        out << "],\"queues\":[";
+        first = true;
+        for (const auto& stats : _queue_list) {
+            const auto wait = stats.wait.snapshot();
+            const auto depth = stats.depth.snapshot();
+            out << (first ? "" : ",") << "{\"source_core\":" << stats.source
+                << ",\"destination_core\":" << stats.destination
+                << ",\"sent\":" << stats.sent.value()
+                << ",\"received\":" << stats.received.value()
+                << ",\"wait_p50_ns\":" << wait.quantile(0.5)
+                << ",\"wait_p99_ns\":" << wait.quantile(0.99)
+                << ",\"wait_max_ns\":" << wait.quantile(1.0)
+                << ",\"depth_p99\":" << depth.quantile(0.99)
+                << ",\"depth_max\":" << depth.quantile(1.0) << '}';
+            first = false;
+        }
+        out << "]}";
+        return out.str();
+    }
+
+private:
+    Profiler() = default;
+
+    /// Handlers by total time spent, the most expensive first
+    std::vector<const HandlerStats*> sortedHandlers() const {
+        std::vector<std::pair<uint64_t, const HandlerStats*>> order;
+        for (const auto& stats : _handlers)
+            order.emplace_back(stats.duration.snapshot().sum, &stats);
+        std::stable_sort(order.begin(), order.end(),
+                         [](const auto& a, const auto& b) { return a.first > b.first; });
+        std::vector<const HandlerStats*> sorted;
+        for (const auto& [total, stats] : order)
+            sorted.push_back(stats);
+        return sorted;
+    }
+
+    metrics::Registry& _registry = metrics::Registry::global();
+    mutable std::mutex _mutex;
+    std::deque<HandlerStats> _handlers;
+    std::deque<QueueStats> _queue_list;
+    std::array<std::atomic<QueueStats*>, MAX_CORES * MAX_CORES> _queues{};
+};
+
+/// Times one handler invocation and accounts for the queue wait of its event
+class HandlerScope {
+    HandlerStats& _stats;
+    uint64_t _start;
+
+public:
+    template <typename Event>
+    HandlerScope(HandlerStats& stats, const Event& evt, unsigned core) noexcept
+        : _stats(stats)
+        , _start(now()) {
+        Profiler::instance().received(evt, core, _start);
+    }
+
+    ~HandlerScope() {
+        _stats.duration.record(now() - _start);
+    }
+
+    HandlerScope(const HandlerScope&) = delete;
+    HandlerScope& operator=(const HandlerScope&) = delete;
+};
+
+} // namespace profiling
+
+#define QB_PROFILE_CONCAT_(a, b) a##b
+#define QB_PROFILE_CONCAT(a, b) QB_PROFILE_CONCAT_(a, b)
+
+#define QB_PROFILE_HANDLER(evt)                                                              \
+    static auto& QB_PROFILE_CONCAT(qb_profile_stats_, __LINE__) =                            \
+        ::profiling::Profiler::instance()                                                    \
+            .handler<std::decay_t<decltype(*this)>, std::decay_t<decltype(evt)>>();        \
+    ::profiling::HandlerScope QB_PROFILE_CONCAT(qb_profile_scope_, __LINE__)(                \
+        QB_PROFILE_CONCAT(qb_profile_stats_, __LINE__), evt, getIndex())
+
+#define QB_PROFILE_SEND(evt) ::profiling::Profiler::instance().sent(evt, getIndex())
+
+#define QB_PROFILE_STAMP public ::profiling::Stamp
+
+#else // QB_EXAMPLES_PROFILE
+
+namespace profiling {
+/// Empty when profiling is disabled: no space taken in events (empty base)
+struct Stamp {};
+} // namespace profiling
+
+#define QB_PROFILE_HANDLER(evt) ((void)(evt))
+#define QB_PROFILE_SEND(evt) ((void)(evt))
+#define QB_PROFILE_STAMP public ::profiling::Stamp
+
+#endif // QB_EXAMPLES_PROFILE
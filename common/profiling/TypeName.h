@@ -0,0 +1,36 @@
+/**
+ * @file examples/common/profiling/TypeName.h
+ * @brief Readable type names from the compiler, without RTTI or demangling.
+ *
+ * @details
+ * Used by the profiler and the watchdog to label actors and events:
+ * `profiling::typeName<TopicManagerActor>()` returns "TopicManagerActor".
+ * The name is built from `__PRETTY_FUNCTION__` (`__FUNCSIG__` on MSVC), so it is spelled
+ * as written in the source, including namespaces and template arguments.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace profiling {
+
+template <typename T>
+std::string typeName() {
+#if defined(_MSC_VER)
+    std::string_view name = __FUNCSIG__;
+    const auto begin = name.find("typeName<") + 9;
+    name = name.substr(begin, name.rfind(">(void)") - begin);
+    for (std::string_view prefix : {"struct ", "class "})
+        if (name.substr(0, prefix.size()) == prefix)
+            name.remove_prefix(prefix.size());
+#else
+    std::string_view name = __PRETTY_FUNCTION__;
+    const auto begin = name.find("T = ") + 4;
+    name = name.substr(begin, name.find_first_of(";]", begin) - begin);
+#endif
+    return std::string(name);
+}
+
+} // namespace profiling
@@ -0,0 +1,366 @@
+/**
+ * @file examples/common/tracing/Tracer.h
+ * @brief Sampled cross-actor request tracing with Chrome trace JSON output.
+ *
+ * @details
+ * Follows one request (a broker publish, a trading order) across actors and cores:
+ *
+ * - `tracing::Context` is carried in events. It holds the trace id, the sending span
+ *   and a flow id linking the send to the receiving span. An empty context (trace id 0)
+ *   means "not sampled"; every operation on it is a single branch.
+ * - `tracing::Span` is an RAII scope. It records a begin timestamp on construction and a
+ *   complete event on destruction. `propagate()` returns the context for an outgoing
+ *   event and records the start of a flow arrow.
+ * - `Tracer::sample()` decides at the entry point whether a new request is traced
+ *   (one in `sample_every`, counted per thread).
+ *
+ * Records go to a lock-free single-producer/single-consumer ring owned by the recording
+ * thread (one per QB core); a full ring drops the record and counts it. A background
+ * flusher thread drains all rings every 50 ms and appends Chrome trace events ("X" complete
+ * spans, "s"/"f" flow arrows between actors) to the output file, which opens in
+ * `chrome://tracing` and in the Perfetto UI (https://ui.perfetto.dev).
+ *
+ * Span names must be string literals (only the pointer is stored). Time stamps use
+ * `std::chrono::steady_clock`, which is consistent across cores on Linux.
+ *
+ * Usage:
+ * @code
+ * tracing::Tracer::instance().start("trace.json", 100);   // 1 request in 100
+ *
+ * // entry point
+ * tracing::Span span("Gateway.request", tracing::Tracer::instance().sample());
+ * auto& evt = push<WorkEvent>(worker);
+ * evt.trace = span.propagate();
+ *
+ * // receiving actor
+ * void Worker::on(WorkEvent& evt) {
+ *     tracing::Span span("Worker.process", evt.trace);
+ *     ...
+ * }
+ *
+ * tracing::Tracer::instance().stop();                      // after engine.join()
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tracing {
+
+/// Trace context carried in events; default-constructed means "not sampled"
+struct Context {
+    uint64_t trace_id = 0;
+    uint64_t span_id = 0;   ///< span that sent the event (0 for a root)
+    uint64_t flow_id = 0;   ///< links the send to the receiving span
+
+    bool sampled() const noexcept { return trace_id != 0; }
+};
+
+namespace detail {
+
+inline uint64_t now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+enum class Kind : uint8_t { Span, FlowStart, FlowEnd };
+
+struct Record {
+    Kind kind;
+    const char* name;
+    uint64_t trace_id;
+    uint64_t id;          ///< span id, or flow id for flow records
+    uint64_t parent_id;   ///< parent span id (spans only)
+    uint64_t begin_ns;
+    uint64_t duration_ns;
+};
+
+/// Single-producer (owning thread) / single-consumer (flusher) ring of records
+class Ring {
+public:
+    static constexpr std::size_t CAPACITY = 16384;
+
+    explicit Ring(unsigned thread_index)
+        : thread_index(thread_index) {}
+
+    void push(const Record& record) noexcept {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        _records[head % CAPACITY] = record;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename Fn>
+    std::size_t drain(Fn&& fn) {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        const auto head = _head.load(std::memory_order_acquire);
+        const auto count = static_cast<std::size_t>(head - tail);
+        for (; tail != head; ++tail)
+            fn(_records[tail % CAPACITY]);
+        _tail.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    const unsigned thread_index;
+    std::atomic<uint64_t> dropped{0};
+
+private:
+    alignas(64) std::atomic<uint64_t> _head{0};
+    alignas(64) std::atomic<uint64_t> _tail{0};
+    std::array<Record, CAPACITY> _records;
+};
+
+} // namespace detail
+
+class Tracer {
+public:
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    ~Tracer() { stop(); }
+
+    /**
+     * @brief Opens the output file and starts the flusher thread
+     * @param path Chrome trace JSON file
+     * @param sample_every trace one request out of this many (1 = all)
+     */
+    bool start(const std::string& path, uint32_t sample_every = 100) {
+        std::lock_guard<std::mutex> lock(_control);
+        if (_running.load(std::memory_order_relaxed))
+            return true;
+        _out.open(path, std::ios::out | std::ios::trunc);
+        if (!_out)
+            return false;
+        _out << "[\n";
+        _first_event = true;
+        _sample_every.store(sample_every ? sample_every : 1, std::memory_order_relaxed);
+        _stop_flusher = false;
+        _running.store(true, std::memory_order_release);
+        _flusher = std::thread([this] { flushLoop(); });
+        return true;
+    }
+
+    /// Stops sampling, drains every ring and closes the file
+    void stop() {
+        std::lock_guard<std::mutex> lock(_control);
+        if (!_running.exchange(false))
+            return;
+        {
+            std::lock_guard<std::mutex> wake(_wake_mutex);
+            _stop_flusher = true;
+        }
+        _wake.notify_one();
+        _flusher.join();
+        flush();
+        _out << "\n]\n";
+        _out.close();
+    }
+
+    bool running() const noexcept { return _running.load(std::memory_order_relaxed); }
+
+    /// Root context for a new request, empty unless this request is sampled
+    Context sample() noexcept {
+        if (!running())
+            return {};
+        thread_local uint64_t requests = 0;
+        if (++requests % _sample_every.load(std::memory_order_relaxed) != 0)
+            return {};
+        return Context{nextId(), 0, 0};
+    }
+
+    uint64_t written() const noexcept { return _written.load(std::memory_order_relaxed); }
+
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(_rings_mutex);
+        uint64_t total = 0;
+        for (const auto& ring : _rings)
+            total += ring->dropped.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /// Unique non-zero id: thread index in the high bits, per-thread sequence below
+    uint64_t nextId() noexcept {
+        thread_local uint64_t sequence = 0;
+        return (static_cast<uint64_t>(ring().thread_index + 1) << 40) | ++sequence;
+    }
+
+    void record(const detail::Record& record) noexcept {
+        if (running())
+            ring().push(record);
+    }
+
+private:
+    Tracer() = default;
+
+    detail::Ring& ring() {
+        thread_local detail::Ring* ring = nullptr;
+        if (!ring) {
+            std::lock_guard<std::mutex> lock(_rings_mutex);
+            _rings.push_back(std::make_unique<detail::Ring>(static_cast<unsigned>(_rings.size())));
+            ring = _rings.back().get();
+        }
+        return *ring;
+    }
+
+    void flushLoop() {
+        std::unique_lock<std::mutex> lock(_wake_mutex);
+        while (!_stop_flusher) {
+            _wake.wait_for(lock, std::chrono::milliseconds(50));
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    /// Drains all rings into the file; only called by the flusher (or stop() after it joined)
+    void flush() {
+        std::vector<detail::Ring*> rings;
+        {
+            std::lock_guard<std::mutex> lock(_rings_mutex);
+            for (const auto& ring : _rings)
+                rings.push_back(ring.get());
+        }
+
+        std::string batch;
+        for (auto* ring : rings) {
+            if (ring->thread_index >= _named_threads) {
+                appendThreadName(batch, ring->thread_index);
+            }
+            _written.fetch_add(ring->drain([&](const detail::Record& record) {
+                appendRecord(batch, ring->thread_index, record);
+            }), std::memory_order_relaxed);
+        }
+        _named_threads = static_cast<unsigned>(rings.size());
+        if (!batch.empty()) {
+            _out << batch;
+            _out.flush();
+        }
+    }
+
+    void separator(std::string& batch) {
+        if (!_first_event)
+            batch += ",\n";
+        _first_event = false;
+    }
+
+    void appendThreadName(std::string& batch, unsigned tid) {
+        char line[160];
+        std::snprintf(line, sizeof(line),
+                      R"({"ph":"M","name":"thread_name","pid":1,"tid":%u,"args":{"name":"thread %u"}})",
+                      tid, tid);
+        separator(batch);
+        batch += line;
+    }
+
+    void appendRecord(std::string& batch, unsigned tid, const detail::Record& record) {
+        char line[384];
+        const double ts = static_cast<double>(record.begin_ns) / 1e3;
+        switch (record.kind) {
+        case detail::Kind::Span:
+            std::snprintf(line, sizeof(line),
+                          R"({"ph":"X","name":"%s","cat":"actor","pid":1,"tid":%u,"ts":%.3f,"dur":%.3f,)"
+                          R"("args":{"trace_id":"%llx","span_id":"%llx","parent_id":"%llx"}})",
+                          record.name, tid, ts, static_cast<double>(record.duration_ns) / 1e3,
+                          static_cast<unsigned long long>(record.trace_id),
+                          static_cast<unsigned long long>(record.id),
+                          static_cast<unsigned long long>(record.parent_id));
+            break;
+        case detail::Kind::FlowStart:
+        case detail::Kind::FlowEnd:
+            // start and end of an arrow are matched by category, name and id
+            std::snprintf(line, sizeof(line),
+                          R"({"ph":"%s","name":"push","cat":"event","pid":1,"tid":%u,"ts":%.3f,"id":"%llx"%s})",
+                          record.kind == detail::Kind::FlowStart ? "s" : "f", tid, ts,
+                          static_cast<unsigned long long>(record.id),
+                          record.kind == detail::Kind::FlowEnd ? R"(,"bp":"e")" : "");
+            break;
+        }
+        separator(batch);
+        batch += line;
+    }
+
+    std::atomic<bool> _running{false};
+    std::atomic<uint32_t> _sample_every{100};
+    std::atomic<uint64_t> _written{0};
+
+    mutable std::mutex _rings_mutex;
+    std::vector<std::unique_ptr<detail::Ring>> _rings;
+
+    std::mutex _control;
+    std::mutex _wake_mutex;
+    std::condition_variable _wake;
+    bool _stop_flusher = false;
+    std::thread _flusher;
+
+    // Owned by the flusher
+    std::ofstream _out;
+    bool _first_event = true;
+    unsigned _named_threads = 0;
+};
+
+/**
+ * @brief RAII span: one timed section of a request on the current thread
+ *
+ * Does nothing (beyond one branch) when the parent context is not sampled.
+ */
+class Span {
+public:
+    Span(const char* name, const Context& parent) noexcept
+        : _name(name) {
+        if (!parent.sampled())
+            return;
+        auto& tracer = Tracer::instance();
+        _context.trace_id = parent.trace_id;
+        _context.span_id = tracer.nextId();
+        _parent_id = parent.span_id;
+        _begin = detail::now();
+        if (parent.flow_id)
+            tracer.record({detail::Kind::FlowEnd, _name, _context.trace_id, parent.flow_id, 0, _begin, 0});
+    }
+
+    ~Span() {
+        if (_context.sampled())
+            Tracer::instance().record({detail::Kind::Span, _name, _context.trace_id, _context.span_id,
+                                       _parent_id, _begin, detail::now() - _begin});
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    bool sampled() const noexcept { return _context.sampled(); }
+
+    /// Context for an event sent from this span; records the start of the flow arrow
+    Context propagate() noexcept {
+        if (!_context.sampled())
+            return {};
+        auto& tracer = Tracer::instance();
+        Context child{_context.trace_id, _context.span_id, tracer.nextId()};
+        tracer.record({detail::Kind::FlowStart, _name, child.trace_id, child.flow_id, 0, detail::now(), 0});
+        return child;
+    }
+
+private:
+    const char* _name;
+    Context _context;
+    uint64_t _parent_id = 0;
+    uint64_t _begin = 0;
+};
+
+} // namespace tracing
@@ -0,0 +1,334 @@
+/**
+ * @file examples/common/watchdog/Watchdog.h
+ * @brief Event-loop stall detector: reports handlers and callbacks that block a core.
+ *
+ * @details
+ * A QB core runs one event loop; a handler that sleeps, waits on a synchronous Redis
+ * command or reads a large file stalls every actor on that core. The watchdog makes such
+ * stalls visible while the engine keeps running:
+ *
+ * - `QB_WATCHDOG_HANDLER(evt)` at the top of an `on(Event&)` handler, or
+ *   `QB_WATCHDOG_SCOPE("onCallback")` in a callback, marks the section as running on the
+ *   current thread (actor type, event or callback name, start time). It is two relaxed
+ *   stores per invocation, and a single load when the watchdog is not started.
+ * - A monitor thread scans all threads every `threshold / 4`. A section running longer
+ *   than the threshold is reported once on stderr with its actor, event and duration. On
+ *   Linux/glibc it also prints a stack sample of the stalled thread, taken by signalling it
+ *   (`SIGPROF`) and calling `backtrace()` in the handler.
+ * - An optional hard limit aborts the process when exceeded, so a CI run fails when a
+ *   blocking call is introduced in a handler.
+ *
+ * Configuration from the environment (`startFromEnv()`):
+ * - `QB_WATCHDOG_MS`: stall threshold in milliseconds; the watchdog is off when unset.
+ * - `QB_WATCHDOG_FAIL_MS`: hard limit in milliseconds (abort), off when unset.
+ * - `QB_WATCHDOG_STACKS=0`: disable stack samples.
+ *
+ * Usage:
+ * @code
+ * void Worker::on(JobEvent& evt) {
+ *     QB_WATCHDOG_HANDLER(evt);
+ *     ...
+ * }
+ *
+ * int main() {
+ *     watchdog::Watchdog::instance().startFromEnv();
+ *     engine.start();
+ *     engine.join();
+ *     watchdog::Watchdog::instance().stop();
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <profiling/TypeName.h>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#define QB_WATCHDOG_STACK_SAMPLES 1
+#include <csignal>
+#include <execinfo.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace watchdog {
+
+/// Threads that can be watched; further threads are not monitored
+constexpr std::size_t MAX_THREADS = 64;
+constexpr int MAX_FRAMES = 32;
+
+struct Options {
+    std::chrono::milliseconds threshold{100};
+    std::chrono::milliseconds hard_limit{0};   ///< 0 = never abort
+    bool stack_samples = true;
+};
+
+namespace detail {
+
+inline uint64_t now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// State of one watched thread: written by the thread, read by the monitor
+struct alignas(64) Slot {
+    std::atomic<uint64_t> start_ns{0};          ///< 0 when no section is running
+    std::atomic<uint64_t> sequence{0};          ///< incremented at each section start
+    std::atomic<const char*> actor{nullptr};
+    std::atomic<const char*> section{nullptr};
+    unsigned index = 0;
+#ifdef QB_WATCHDOG_STACK_SAMPLES
+    pthread_t thread{};
+    std::atomic<int> frames{-1};
+    void* stack[MAX_FRAMES];
+#endif
+    uint64_t reported_sequence = 0;             ///< monitor only
+};
+
+} // namespace detail
+
+class Watchdog {
+public:
+    static Watchdog& instance() {
+        static Watchdog watchdog;
+        return watchdog;
+    }
+
+    ~Watchdog() { stop(); }
+
+    void start(const Options& options) {
+        std::lock_guard<std::mutex> lock(_control);
+        if (_active.load(std::memory_order_relaxed))
+            return;
+        _options = options;
+#ifdef QB_WATCHDOG_STACK_SAMPLES
+        if (_options.stack_samples) {
+            void* warmup[1];
+            backtrace(warmup, 1);  // loads the unwinder now, not inside the signal handler
+            struct sigaction action {};
+            action.sa_handler = &Watchdog::onSample;
+            action.sa_flags = SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            sigaction(SIGPROF, &action, nullptr);
+        }
+#endif
+        _stop_monitor = false;
+        _active.store(true, std::memory_order_release);
+        _monitor = std::thread([this] { monitorLoop(); });
+        std::fprintf(stderr, "[watchdog] threshold %lld ms%s\n",
+                     static_cast<long long>(_options.threshold.count()),
+                     _options.hard_limit.count() ? ", hard limit enabled" : "");
+    }
+
+    /// Starts when QB_WATCHDOG_MS is set; returns whether the watchdog runs
+    bool startFromEnv() {
+        const char* threshold = std::getenv("QB_WATCHDOG_MS");
+        if (!threshold)
+            return false;
+        Options options;
+        options.threshold = std::chrono::milliseconds(std::max(1L, std::strtol(threshold, nullptr, 10)));
+        if (const char* limit = std::getenv("QB_WATCHDOG_FAIL_MS"))
+            options.hard_limit = std::chrono::milliseconds(std::strtol(limit, nullptr, 10));
+        if (const char* stacks = std::getenv("QB_WATCHDOG_STACKS"))
+            options.stack_samples = std::string(stacks) != "0";
+        start(options);
+        return true;
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(_control);
+        if (!_active.exchange(false))
+            return;
+        {
+            std::lock_guard<std::mutex> wake(_wake_mutex);
+            _stop_monitor = true;
+        }
+        _wake.notify_one();
+        _monitor.join();
+        if (const auto stalls = _stalls.load())
+            std::fprintf(stderr, "[watchdog] %llu stall(s), longest %.1f ms\n",
+                         static_cast<unsigned long long>(stalls),
+                         static_cast<double>(_longest_ns.load()) / 1e6);
+    }
+
+    bool active() const noexcept { return _active.load(std::memory_order_relaxed); }
+
+    uint64_t stalls() const noexcept { return _stalls.load(std::memory_order_relaxed); }
+
+    /// Slot of the calling thread, nullptr when all slots are taken
+    detail::Slot* slot() {
+        thread_local detail::Slot* slot = registerThread();
+        return slot;
+    }
+
+private:
+    Watchdog() = default;
+
+    detail::Slot* registerThread() {
+        const auto index = _registered.fetch_add(1, std::memory_order_relaxed);
+        if (index >= MAX_THREADS)
+            return nullptr;
+        auto& slot = _slots[index];
+        slot.index = static_cast<unsigned>(index);
+#ifdef QB_WATCHDOG_STACK_SAMPLES
+        slot.thread = pthread_self();
+        t_slot = &slot;
+#endif
+        _published.fetch_add(1, std::memory_order_release);
+        return &slot;
+    }
+
+    void monitorLoop() {
+        const auto interval = std::max(std::chrono::milliseconds(1), _options.threshold / 4);
+        const auto threshold_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(_options.threshold).count());
+        const auto limit_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(_options.hard_limit).count());
+
+        std::unique_lock<std::mutex> lock(_wake_mutex);
+        while (!_stop_monitor) {
+            _wake.wait_for(lock, interval);
+            const auto count = std::min<std::size_t>(_published.load(std::memory_order_acquire), MAX_THREADS);
+            for (std::size_t i = 0; i < count; ++i)
+                check(_slots[i], threshold_ns, limit_ns);
+        }
+    }
+
+    void check(detail::Slot& slot, uint64_t threshold_ns, uint64_t limit_ns) {
+        // Sequence first: a section starting after this load changes it, and the
+        // recheck below then discards the start time read for it
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto start = slot.start_ns.load(std::memory_order_acquire);
+        if (!start)
+            return;
+        const auto current = detail::now();
+        const auto elapsed = current > start ? current - start : 0;
+        if (elapsed < threshold_ns)
+            return;
+
+        const bool fatal = limit_ns && elapsed >= limit_ns;
+        if (sequence == slot.reported_sequence && !fatal)
+            return;  // this stall was already reported
+
+        const char* actor = slot.actor.load(std::memory_order_relaxed);
+        const char* section = slot.section.load(std::memory_order_relaxed);
+        if (slot.start_ns.load(std::memory_order_acquire) != start ||
+            slot.sequence.load(std::memory_order_acquire) != sequence)
+            return;  // finished in the meantime, or another section started
+
+        if (sequence != slot.reported_sequence) {
+            slot.reported_sequence = sequence;
+            _stalls.fetch_add(1, std::memory_order_relaxed);
+        }
+        uint64_t longest = _longest_ns.load(std::memory_order_relaxed);
+        while (elapsed > longest && !_longest_ns.compare_exchange_weak(longest, elapsed)) {}
+
+        std::fprintf(stderr, "[watchdog] %s: thread %u blocked in %s::%s for %.1f ms (threshold %lld ms)\n",
+                     fatal ? "HARD LIMIT EXCEEDED" : "stall", slot.index,
+                     actor ? actor : "?", section ? section : "?",
+                     static_cast<double>(elapsed) / 1e6,
+                     static_cast<long long>(_options.threshold.count()));
+        if (_options.stack_samples)
+            sampleStack(slot);
+        if (fatal)
+            std::abort();
+    }
+
+#ifdef QB_WATCHDOG_STACK_SAMPLES
+    static inline thread_local detail::Slot* t_slot = nullptr;
+
+    static void onSample(int) {
+        if (auto* slot = t_slot)
+            slot->frames.store(backtrace(slot->stack, MAX_FRAMES), std::memory_order_release);
+    }
+
+    void sampleStack(detail::Slot& slot) {
+        slot.frames.store(-1, std::memory_order_relaxed);
+        if (pthread_kill(slot.thread, SIGPROF) != 0)
+            return;
+        for (int wait = 0; wait < 100 && slot.frames.load(std::memory_order_acquire) < 0; ++wait)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        const int frames = slot.frames.load(std::memory_order_acquire);
+        if (frames > 0)
+            backtrace_symbols_fd(slot.stack, frames, STDERR_FILENO);
+    }
+#else
+    void sampleStack(detail::Slot&) {}
+#endif
+
+    std::atomic<bool> _active{false};
+    Options _options;
+    std::array<detail::Slot, MAX_THREADS> _slots{};
+    std::atomic<std::size_t> _registered{0};
+    std::atomic<std::size_t> _published{0};
+    std::atomic<uint64_t> _stalls{0};
+    std::atomic<uint64_t> _longest_ns{0};
+
+    std::mutex _control;
+    std::mutex _wake_mutex;
+    std::condition_variable _wake;
+    bool _stop_monitor = false;
+    std::thread _monitor;
+};
+
+/// Marks a handler or callback as running on this thread for its lifetime
+class Scope {
+    detail::Slot* _slot = nullptr;
+
+public:
+    Scope(const char* actor, const char* section) noexcept {
+        auto& watchdog = Watchdog::instance();
+        if (!watchdog.active())
+            return;
+        auto* slot = watchdog.slot();
+        if (!slot || slot->start_ns.load(std::memory_order_relaxed))
+            return;  // no slot left, or nested in an outer section that is already watched
+        _slot = slot;
+        slot->actor.store(actor, std::memory_order_relaxed);
+        slot->section.store(section, std::memory_order_relaxed);
+        slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        slot->start_ns.store(detail::now(), std::memory_order_release);
+    }
+
+    ~Scope() {
+        if (_slot)
+            _slot->start_ns.store(0, std::memory_order_release);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace watchdog
+
+#define QB_WATCHDOG_CONCAT_(a, b) a##b
+#define QB_WATCHDOG_CONCAT(a, b) QB_WATCHDOG_CONCAT_(a, b)
+
+/// Watches an event handler; labels it with the actor and event types
+#define QB_WATCHDOG_HANDLER(evt)                                                                 \
+    static const std::string QB_WATCHDOG_CONCAT(qb_watchdog_actor_, __LINE__) =                  \
+        ::profiling::typeName<std::decay_t<decltype(*this)>>();                                  \
+    static const std::string QB_WATCHDOG_CONCAT(qb_watchdog_event_, __LINE__) =                  \
+        ::profiling::typeName<std::decay_t<decltype(evt)>>();                                    \
+    ::watchdog::Scope QB_WATCHDOG_CONCAT(qb_watchdog_scope_, __LINE__)(                          \
+        QB_WATCHDOG_CONCAT(qb_watchdog_actor_, __LINE__).c_str(),                                \
+        QB_WATCHDOG_CONCAT(qb_watchdog_event_, __LINE__).c_str())
+
+/// Watches any other section of an actor (callback, timer); `name` must be a string literal
+#define QB_WATCHDOG_SCOPE(name)                                                                  \
+    static const std::string QB_WATCHDOG_CONCAT(qb_watchdog_actor_, __LINE__) =                  \
+        ::profiling::typeName<std::decay_t<decltype(*this)>>();                                  \
+    ::watchdog::Scope QB_WATCHDOG_CONCAT(qb_watchdog_scope_, __LINE__)(                          \
+        QB_WATCHDOG_CONCAT(qb_watchdog_actor_, __LINE__).c_str(), name)
@@ -41,6 +41,11 @@
  *         (e.g., by broadcasting `ShutdownEvent` or `qb::KillEvent`) after a set duration or
  *         once all work is deemed complete.
  *
+ * System-wide counters, the scheduler queue depth and a task processing time histogram are
+ * recorded with the shared metrics library (`common/metrics`), sharded per core so workers
+ * on different cores never contend on a counter. When built with qbm-http, `/metrics` is
+ * served in Prometheus format on port 9100 for the duration of the run.
+ *
  * This example showcases dynamic load balancing, worker health monitoring, task prioritization,
  * result validation (conceptual), and real-time performance metrics within a QB actor system.
  *
@@ -55,6 +60,7 @@
  * - System Orchestration and Lifecycle Management: `SystemMonitorActor` overseeing the simulation.
  * - Fixed-Size Strings: `qb::string<N>` used in event/model definitions for potentially performance-sensitive data.
  * - Referenced Actors: `addRefActor` for potentially closer coupling where appropriate (though the example uses it broadly).
+ * - Shared Metrics: `metrics::Counter`, `metrics::Gauge`, `metrics::Histogram`, `metrics::MetricsEndpoint`.
  */
 
 #include <deque>
@@ -62,6 +68,11 @@
 #include <qb/main.h>
 #include <qb/io.h>
 #include <qb/io/async.h>
+#include <metrics/Metrics.h>
+#include <audit/EventAudit.h>
+#ifdef QB_EXAMPLES_METRICS_HTTP
+#include <metrics/MetricsEndpoint.h>
+#endif
 
 
 namespace {
@@ -79,12 +90,22 @@ namespace {
         VERY_COMPLEX = 20
     };
     
-    // Performance tracking
-    std::atomic<uint64_t> g_total_tasks{0};
-    std::atomic<uint64_t> g_completed_tasks{0};
-    std::atomic<uint64_t> g_failed_tasks{0};
-    std::atomic<uint64_t> g_total_task_messages{0};
-    std::atomic<uint64_t> g_total_result_messages{0};
+    // Performance tracking: per-core sharded metrics, merged when read or scraped
+    metrics::Registry& g_metrics = metrics::Registry::global();
+    metrics::Counter& g_total_tasks =
+        g_metrics.counter("compute_tasks_total", "Tasks generated");
+    metrics::Counter& g_completed_tasks =
+        g_metrics.counter("compute_tasks_finished_total", "Tasks finished by workers", {{"status", "completed"}});
+    metrics::Counter& g_failed_tasks =
+        g_metrics.counter("compute_tasks_finished_total", "Tasks finished by workers", {{"status", "failed"}});
+    metrics::Counter& g_total_task_messages =
+        g_metrics.counter("compute_task_messages_total", "Task messages sent and received");
+    metrics::Counter& g_total_result_messages =
+        g_metrics.counter("compute_result_messages_total", "Result messages received by the scheduler");
+    metrics::Gauge& g_queued_tasks =
+        g_metrics.gauge("compute_queued_tasks", "Tasks waiting in the scheduler queue");
+    metrics::Histogram& g_task_duration =
+        g_metrics.histogram("compute_task_duration_seconds", "Task processing time", {}, 1e-6); // recorded in us
     
     // System-wide timestamp for simulation time tracking
     uint64_t getCurrentTimestamp() {
@@ -264,6 +285,7 @@ struct TaskMessage : public qb::Event {
     
     explicit TaskMessage(const std::shared_ptr<Task>& t) : task(t) {}
 };
+QB_AUDIT_HOT_EVENT(TaskMessage, audit::CACHE_LINE, task);
 
 struct TaskAssignmentMessage : public TaskMessage {
     explicit TaskAssignmentMessage(const std::shared_ptr<Task>& t) : TaskMessage(t) {}
@@ -283,6 +305,7 @@ struct ResultMessage : public qb::Event {
     
     explicit ResultMessage(const TaskResult& r) : result(r) {}
 };
+QB_AUDIT_EVENT(ResultMessage, result);
 
 // Worker status messages
 struct WorkerStatusMessage : public qb::Event {
@@ -291,6 +314,7 @@ struct WorkerStatusMessage : public qb::Event {
     
     WorkerStatusMessage(qb::ActorId id, const WorkerMetrics& m) : worker_id(id), metrics(m) {}
 };
+QB_AUDIT_EVENT(WorkerStatusMessage, worker_id, metrics);
 
 struct WorkerHeartbeatMessage : public qb::Event {
     qb::ActorId worker_id;
@@ -300,6 +324,7 @@ struct WorkerHeartbeatMessage : public qb::Event {
     WorkerHeartbeatMessage(qb::ActorId id, uint64_t time, bool busy) : 
         worker_id(id), timestamp(time), is_busy(busy) {}
 };
+QB_AUDIT_HOT_EVENT(WorkerHeartbeatMessage, audit::CACHE_LINE, worker_id, timestamp, is_busy);
 
 // System messages
 struct SystemStatsMessage : public qb::Event {
@@ -314,6 +339,7 @@ struct SystemStatsMessage : public qb::Event {
         total_tasks(total), completed_tasks(completed), failed_tasks(failed),
         elapsed_seconds(seconds), tasks_per_second(throughput) {}
 };
+QB_AUDIT_EVENT(SystemStatsMessage, total_tasks, completed_tasks, failed_tasks, elapsed_seconds, tasks_per_second);
 
 struct InitializeMessage : public qb::Event {};
 struct ShutdownMessage : public qb::Event {};
@@ -323,6 +349,7 @@ struct UpdateWorkersMessage : public qb::Event {
     std::vector<qb::ActorId> worker_ids;
     explicit UpdateWorkersMessage(const std::vector<qb::ActorId>& ids) : worker_ids(ids) {}
 };
+QB_AUDIT_EVENT(UpdateWorkersMessage, worker_ids);
 
 // ═════════════════════════════════════════════════════════════════
 // SYSTEM ACTORS
@@ -417,8 +444,8 @@ private:
         push<TaskMessage>(_scheduler_id, task);
         
         // Update global statistics
-        g_total_tasks++;
-        g_total_task_messages++;
+        g_total_tasks.inc();
+        g_total_task_messages.inc();
     }
 };
 
@@ -477,10 +504,11 @@ public:
     }
     
     void on(TaskMessage& msg) {
-        g_total_task_messages++;
+        g_total_task_messages.inc();
         
         // Add task to queue
         _task_queue.push_back(msg.task);
+        g_queued_tasks.set(static_cast<int64_t>(_task_queue.size()));
         
         // Attempt to schedule tasks immediately
         scheduleTasks();
@@ -508,7 +536,7 @@ public:
     }
     
     void on(ResultMessage& msg) {
-        g_total_result_messages++;
+        g_total_result_messages.inc();
         
         // Remove from active tasks
         qb::string<64> task_id = msg.result.task_id;
@@ -531,6 +559,7 @@ public:
         
         // Clear queues
         _task_queue.clear();
+        g_queued_tasks.set(0);
         _active_tasks.clear();
         
         kill();
@@ -558,6 +587,7 @@ private:
                 // Get next task
                 auto task = _task_queue.front();
                 _task_queue.pop_front();
+                g_queued_tasks.set(static_cast<int64_t>(_task_queue.size()));
                 
                 // Assign to worker
                 task->status = TaskStatus::ASSIGNED;
@@ -787,10 +817,11 @@ private:
         
         // Update global counters
         if (success) {
-            g_completed_tasks++;
+            g_completed_tasks.inc();
         } else {
-            g_failed_tasks++;
+            g_failed_tasks.inc();
         }
+        g_task_duration.record(processing_time);
         
         // Reset worker state
         _current_task = nullptr;
@@ -988,6 +1019,9 @@ public:
                  << msg.elapsed_seconds << " seconds" << std::endl;
         qb::io::cout() << "Throughput: " << std::fixed << std::setprecision(2)
                  << msg.tasks_per_second << " tasks/sec" << std::endl;
+        const auto durations = g_task_duration.snapshot();
+        qb::io::cout() << "Task Time: p50 " << durations.quantile(0.50) / 1000.0 << " ms, p99 "
+                 << durations.quantile(0.99) / 1000.0 << " ms, queued " << g_queued_tasks.value() << std::endl;
         qb::io::cout() << "===========================" << std::endl;
     }
     
@@ -1010,14 +1044,14 @@ private:
             
             // Calculate throughput
             double tasks_per_second = elapsed_seconds > 0 ? 
-                (g_completed_tasks + g_failed_tasks) / elapsed_seconds : 0;
+                (g_completed_tasks.value() + g_failed_tasks.value()) / elapsed_seconds : 0;
             
             // Send statistics message to self
             push<SystemStatsMessage>(
                 id(),
-                g_total_tasks.load(),
-                g_completed_tasks.load(),
-                g_failed_tasks.load(),
+                g_total_tasks.value(),
+                g_completed_tasks.value(),
+                g_failed_tasks.value(),
                 elapsed_seconds,
                 tasks_per_second
             );
@@ -1034,13 +1068,13 @@ private:
         uint64_t current_time = getCurrentTimestamp();
         double elapsed_seconds = (current_time - _start_time) / 1000000.0;
         double tasks_per_second = elapsed_seconds > 0 ? 
-            (g_completed_tasks + g_failed_tasks) / elapsed_seconds : 0;
+            (g_completed_tasks.value() + g_failed_tasks.value()) / elapsed_seconds : 0;
         
         push<SystemStatsMessage>(
             id(),
-            g_total_tasks.load(),
-            g_completed_tasks.load(),
-            g_failed_tasks.load(),
+            g_total_tasks.value(),
+            g_completed_tasks.value(),
+            g_failed_tasks.value(),
             elapsed_seconds,
             tasks_per_second
         );
@@ -1059,6 +1093,8 @@ private:
         // Kill self after a short delay
         qb::io::async::callback([this]() {
             broadcast<ShutdownMessage>();
+            // Also stops actors without a ShutdownMessage handler (metrics endpoint)
+            broadcast<qb::KillEvent>();
         }, 0.5);
     }
 };
@@ -1095,6 +1131,11 @@ int main() {
         // Step 4: Create TaskGenerator (Core 0)
         auto generator_id = engine.addActor<TaskGeneratorActor>(0, scheduler_id);
         
+#ifdef QB_EXAMPLES_METRICS_HTTP
+        // Expose the metrics registry for Prometheus (core 0)
+        engine.addActor<metrics::MetricsEndpoint>(0, "tcp://0.0.0.0:9100");
+#endif
+        
         // Step 5: Create SystemMonitor (Core 0)
         auto monitor_id = engine.addActor<SystemMonitorActor>(
             0, generator_id, scheduler_id, collector_id, worker_ids
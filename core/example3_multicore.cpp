@@ -36,11 +36,16 @@
  * - Core Information: `getIndex()` to retrieve the actor's current core ID.
  * - Engine Management: `qb::Main`, `std::thread::hardware_concurrency()`.
  * - Thread-Safe I/O: `qb::io::cout()`.
+ *
+ * The simulated work (`sleep_for` in the worker handlers and the dispatcher callback) blocks
+ * its core. Every handler is watched by the shared stall detector (`common/watchdog`): run
+ * with `QB_WATCHDOG_MS=30` to see the blocked sections reported with their duration.
  */
 
 #include <qb/actor.h>
 #include <qb/main.h>
 #include <qb/io.h>
+#include <watchdog/Watchdog.h>
 
 // Define event types with different priorities
 struct HighPriorityEvent : public qb::Event {
@@ -95,6 +100,7 @@ public:
     
     // Handlers for different event types
     void on(StandardEvent& event) {
+        QB_WATCHDOG_HANDLER(event);
         qb::io::cout() << _timestamp() << "WorkerActor " << id() << ": Processing StandardEvent with value " << event.value << std::endl;
         // Simulate work for standard priority
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
@@ -105,6 +111,7 @@ public:
     }
     
     void on(HighPriorityEvent& event) {
+        QB_WATCHDOG_HANDLER(event);
         qb::io::cout() << _timestamp() << "WorkerActor " << id() << ": Processing HighPriorityEvent with value " << event.value << std::endl;
         // High priority tasks are processed faster
         std::this_thread::sleep_for(std::chrono::milliseconds(20));
@@ -115,6 +122,7 @@ public:
     }
     
     void on(LowPriorityEvent& event) {
+        QB_WATCHDOG_HANDLER(event);
         qb::io::cout() << _timestamp() << "WorkerActor " << id() << ": Processing LowPriorityEvent with value " << event.value << std::endl;
         // Low priority tasks take longer
         std::this_thread::sleep_for(std::chrono::milliseconds(80));
@@ -165,6 +173,7 @@ public:
     }
     
     void onCallback() override {
+        QB_WATCHDOG_SCOPE("onCallback");
         if (_dispatched_events < _max_events_per_worker * _num_workers * 3) {
             // Round-robin dispatch
             int worker_index = (_dispatched_events / 3) % _num_workers;
@@ -228,11 +237,15 @@ int main() {
     // Create dispatcher actor on core 0
     engine.addActor<DispatcherActor>(0, workers);
     
+    // Report handlers that block a core (simulated work) when QB_WATCHDOG_MS is set
+    watchdog::Watchdog::instance().startFromEnv();
+    
     qb::io::cout() << "Main: Starting QB engine" << std::endl;
     engine.start();
     
     qb::io::cout() << "Main: Waiting for actors to complete" << std::endl;
     engine.join();
+    watchdog::Watchdog::instance().stop();
     
     qb::io::cout() << "Main: All actors have terminated, exiting" << std::endl;
     return 0;
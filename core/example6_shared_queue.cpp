@@ -8,9 +8,9 @@
  *
  * @details
  * The system consists of:
- * 1.  `SharedQueue<WorkItemMsg>`: A custom thread-safe queue (using `std::mutex`) that
- *     stores `WorkItemMsg` objects. This is not a QB feature but a standard C++ utility
- *     used here to illustrate interaction with shared memory.
+ * 1.  `SharedQueue<WorkItemMsg>`: A custom thread-safe queue (using `std::mutex`, in
+ *     `shared/SharedQueue.h`) that stores `WorkItemMsg` objects. This is not a QB feature
+ *     but a standard C++ utility used here to illustrate interaction with shared memory.
  * 2.  `Producer` Actor:
  *     -   Periodically generates `WorkItemMsg` objects, each with a simulated complexity.
  *     -   Pushes these work items into the `SharedQueue`.
@@ -48,40 +48,7 @@
 #include <qb/event.h>
 #include <random>
 #include <queue>
-
-// Thread-safe shared queue for actors
-template <typename T>
-class SharedQueue {
-public:
-    void push(const T& item) {
-        std::lock_guard<std::mutex> lock(_mutex);
-        _queue.push(item);
-    }
-
-    bool pop(T& item) {
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (_queue.empty()) {
-            return false;
-        }
-        item = _queue.front();
-        _queue.pop();
-        return true;
-    }
-
-    size_t size() const {
-        std::lock_guard<std::mutex> lock(_mutex);
-        return _queue.size();
-    }
-
-    bool empty() const {
-        std::lock_guard<std::mutex> lock(_mutex);
-        return _queue.empty();
-    }
-
-private:
-    std::queue<T> _queue;
-    mutable std::mutex _mutex;
-};
+#include "shared/SharedQueue.h"
 
 // Message for scheduling delayed actions
 struct DelayedActionMsg : public qb::Event {
@@ -13,7 +13,7 @@
  *         SELECTING, PAYMENT, BREWING, DISPENSING, MAINTENANCE, or ERROR.
  *     -   Manages state transitions triggered by `InputEventMessage`s (e.g., COIN_INSERTED,
  *         BUTTON_PRESSED, CANCEL).
- *     -   Uses a `std::map` as a transition table to define state-specific event handlers.
+ *     -   Uses a `TransitionTable` (`shared/TransitionTable.h`) to define state-specific event handlers.
  *     -   Simulates timed operations like brewing and dispensing by scheduling `DelayedActionMessage`s
  *         to itself using `qb::io::async::callback(func, delay_seconds)`.
  *     -   Responds to `StatusRequestMessage` with its current operational status.
@@ -47,6 +47,7 @@
 #include <qb/main.h>
 #include <qb/io.h>
 #include <qb/io/async.h>
+#include "shared/TransitionTable.h"
 
 using namespace qb;
 
@@ -229,8 +230,7 @@ private:
     std::map<CoffeeType, double> _coffee_prices;
     
     // Transition table: maps current state and input event to a handler function
-    using TransitionHandler = std::function<void(const InputEventMessage&)>;
-    std::map<MachineState, std::map<InputEvent, TransitionHandler>> _transition_table;
+    TransitionTable<MachineState, InputEvent, InputEventMessage> _transition_table;
     
     // List of subscribers to state changes
     std::vector<ActorId> _subscribers;
@@ -428,8 +428,7 @@ private:
                 auto input_event = static_cast<InputEvent>(event);
                 
                 // Add default handler if no specific handler exists
-                if (_transition_table[machine_state].find(input_event) == 
-                    _transition_table[machine_state].end()) {
+                if (!_transition_table.contains(machine_state, input_event)) {
                     
                     _transition_table[machine_state][input_event] = 
                         [this, machine_state, input_event](const InputEventMessage& msg) {
@@ -447,14 +446,8 @@ private:
         qb::io::cout() << "Received event: " << eventToString(msg.event)
                   << " in state: " << stateToString(_current_state) << std::endl;
         
-        // Look up the appropriate handler for this state and event
-        auto& state_handlers = _transition_table[_current_state];
-        auto it = state_handlers.find(msg.event);
-        
-        if (it != state_handlers.end()) {
-            // Execute the transition handler
-            it->second(msg);
-        } else {
+        // Look up and execute the handler for this state and event
+        if (!_transition_table.dispatch(_current_state, msg.event, msg)) {
             // This should not happen since we have default handlers
             qb::io::cout() << "Unhandled event " << eventToString(msg.event)
                       << " in state " << stateToString(_current_state) << std::endl;
@@ -34,12 +34,27 @@
  * 5.  `SupervisorActor`:
  *     -   Initializes and orchestrates the entire system.
  *     -   Sends `InitializeMessage` to start other actors.
- *     -   Uses `qb::io::async::callback` to periodically request and display `StatisticsMessage`.
+ *     -   Uses `qb::io::async::callback` to periodically request and display `StatisticsMessage`,
+ *         built from the shared metrics registry.
  *     -   Manages the simulation lifecycle, initiating a shutdown after a set duration by sending `qb::KillEvent` to actors.
  * 
+ * Statistics are recorded with the shared metrics library (`common/metrics`): counters are
+ * sharded per core, so clients, order entry and matching engine never contend on a shared
+ * cache line. Matching latency is recorded in a histogram and the number of active orders
+ * in a gauge. When built with qbm-http, `/metrics` is served in Prometheus format on
+ * port 9100 for the duration of the run.
+ *
+ * Orders can be traced end to end: with `QB_TRACE_FILE=trace.json`, one order in
+ * `QB_TRACE_SAMPLE` (default 10) carries a `tracing::Context` from the client through
+ * order entry and matching to market data, and the resulting Chrome trace shows each
+ * hop and the time spent between cores (`common/tracing`).
+ *
  * The example emphasizes actor communication patterns, state management within order books,
  * and multi-core deployment strategies for different components of a complex system.
  *
+ * The domain model (`Order`, `Trade`, `PriceLevel`, `OrderBook`) lives in `shared/OrderBook.h`,
+ * where `benchmarks/bench_orderbook.cpp` measures it without an engine.
+ *
  * QB Features Demonstrated:
  * - Multi-Core Deployment: Assigning different actors (`MatchingEngineActor`, `ClientActor`s, etc.) to specific CPU cores via `engine.addActor<T>(core_id, ...)`.
  * - Complex Actor Interactions: Multiple actors collaborating through message passing to achieve system goals.
@@ -49,6 +64,11 @@
  * - Application-Specific Logic: Implementation of order matching and market data generation.
  * - System Orchestration: `SupervisorActor` managing the lifecycle and monitoring of the system.
  * - Engine Management: `qb::Main`, `engine.start()`, `engine.join()`.
+ * - Shared Metrics: `metrics::Counter`, `metrics::Gauge`, `metrics::Histogram`, `metrics::MetricsEndpoint`.
+ * - Configurable Placement: the cores of every role can be changed with `--placement FILE` or
+ *   `--place role=spec`, e.g. `--place matching_engine=auto:hot` (`common/placement`).
+ * - Asynchronous Logging: `QB_LOG_INFO`/`QB_LOG_DEBUG` for per-order and per-tick messages.
+ * - Request Tracing: `tracing::Span` and `tracing::Context` carried in events.
  */
 
 #include <deque>
@@ -56,6 +76,16 @@
 #include <qb/main.h>
 #include <qb/io.h>
 #include <qb/io/async.h>
+#include <metrics/Metrics.h>
+#include <tracing/Tracer.h>
+#include <logging/Logger.h>
+#include <placement/Placement.h>
+#include <audit/EventAudit.h>
+#include "shared/OrderBook.h"
+#include <cstdlib>
+#ifdef QB_EXAMPLES_METRICS_HTTP
+#include <metrics/MetricsEndpoint.h>
+#endif
 
 namespace {
     // Global settings
@@ -64,32 +94,24 @@ namespace {
     const int SIMULATION_DURATION_SECONDS = 10;
     const int ORDERS_PER_SECOND_PER_CLIENT = 5;
     
-    // Performance tracking
-    std::atomic<uint64_t> g_total_orders{0};
-    std::atomic<uint64_t> g_total_trades{0};
-    std::atomic<uint64_t> g_total_order_messages{0};
-    std::atomic<uint64_t> g_total_market_data_messages{0};
+    // Performance tracking: per-core sharded metrics, merged when read or scraped
+    metrics::Registry& g_metrics = metrics::Registry::global();
+    metrics::Counter& g_total_orders =
+        g_metrics.counter("trading_orders_total", "Orders generated by clients");
+    metrics::Counter& g_total_trades =
+        g_metrics.counter("trading_trades_total", "Trades produced by the matching engine");
+    metrics::Counter& g_total_order_messages =
+        g_metrics.counter("trading_order_messages_total", "Order messages handled by order entry");
+    metrics::Counter& g_total_market_data_messages =
+        g_metrics.counter("trading_market_data_messages_total", "Market data messages published");
+    metrics::Gauge& g_active_orders =
+        g_metrics.gauge("trading_active_orders", "Orders tracked by order entry");
+    metrics::Histogram& g_match_latency =
+        g_metrics.histogram("trading_match_duration_seconds", "Time to match one order", {}, 1e-9);
     
     // System-wide timestamp for simulation time tracking
     std::atomic<uint64_t> g_current_timestamp{0};
     
-    // Helper function to get current timestamp in microseconds
-    uint64_t getCurrentTimestamp() {
-        return static_cast<uint64_t>(
-            std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::high_resolution_clock::now().time_since_epoch()
-            ).count()
-        );
-    }
-    
-    // Generate a unique order ID
-    std::string generateOrderId() {
-        static std::atomic<uint64_t> next_id{1};
-        std::stringstream ss;
-        ss << "ORD-" << std::setw(10) << std::setfill('0') << next_id++;
-        return ss.str();
-    }
-    
     // Available stock symbols
     const std::vector<std::string> SYMBOLS = {"AAPL", "MSFT", "GOOGL"};
     
@@ -106,423 +128,6 @@ namespace {
     }
 }
 
-// ═════════════════════════════════════════════════════════════════
-// DOMAIN MODELS
-// ═════════════════════════════════════════════════════════════════
-
-enum class Side {
-    BUY,
-    SELL
-};
-
-std::string sideToString(Side side) {
-    return side == Side::BUY ? "BUY" : "SELL";
-}
-
-enum class OrderStatus {
-    NEW,
-    PARTIALLY_FILLED,
-    FILLED,
-    CANCELED,
-    REJECTED
-};
-
-std::string statusToString(OrderStatus status) {
-    switch (status) {
-        case OrderStatus::NEW: return "NEW";
-        case OrderStatus::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
-        case OrderStatus::FILLED: return "FILLED";
-        case OrderStatus::CANCELED: return "CANCELED";
-        case OrderStatus::REJECTED: return "REJECTED";
-        default: return "UNKNOWN";
-    }
-}
-
-/**
- * @brief Order model representing a client's trading instruction
- */
-struct Order {
-    std::string order_id;
-    std::string client_id;
-    std::string symbol;
-    Side side;
-    double price;
-    int quantity;
-    int filled_quantity = 0;
-    OrderStatus status = OrderStatus::NEW;
-    uint64_t timestamp;
-    
-    // Constructeur par défaut
-    Order() : price(0.0), quantity(0), side(Side::BUY), timestamp(getCurrentTimestamp()), order_id(generateOrderId()) {}
-    
-    // Constructor for market orders
-    Order(const std::string& client, const std::string& sym, Side s, int qty)
-        : order_id(generateOrderId()), client_id(client), symbol(sym),
-          side(s), quantity(qty), timestamp(getCurrentTimestamp()) {
-        // Market orders have zero price (will match at best available)
-        price = 0.0;
-    }
-    
-    // Constructor for limit orders
-    Order(const std::string& client, const std::string& sym, Side s, double p, int qty)
-        : order_id(generateOrderId()), client_id(client), symbol(sym),
-          side(s), price(p), quantity(qty), timestamp(getCurrentTimestamp()) {}
-    
-    // Determine if the order is fully filled
-    bool isFullyFilled() const {
-        return filled_quantity >= quantity;
-    }
-    
-    // Determine if the order is a market order
-    bool isMarketOrder() const {
-        return price == 0.0;
-    }
-    
-    // Get the remaining unfilled quantity
-    int getRemainingQuantity() const {
-        return quantity - filled_quantity;
-    }
-    
-    std::string toString() const {
-        std::stringstream ss;
-        ss << order_id << " | " << client_id << " | " << symbol << " | " 
-           << sideToString(side) << " | " << std::fixed << std::setprecision(2) << price 
-           << " | " << filled_quantity << "/" << quantity 
-           << " | " << statusToString(status);
-        return ss.str();
-    }
-};
-
-/**
- * @brief Trade model representing a matched pair of orders
- */
-struct Trade {
-    std::string trade_id;
-    std::string buy_order_id;
-    std::string sell_order_id;
-    std::string symbol;
-    double price;
-    int quantity;
-    uint64_t timestamp;
-    
-    Trade(const std::string& buy_id, const std::string& sell_id, 
-          const std::string& sym, double p, int qty)
-        : buy_order_id(buy_id), sell_order_id(sell_id), symbol(sym),
-          price(p), quantity(qty), timestamp(getCurrentTimestamp()) {
-        
-        // Generate a unique trade ID
-        static std::atomic<uint64_t> next_trade_id{1};
-        std::stringstream ss;
-        ss << "TRD-" << std::setw(10) << std::setfill('0') << next_trade_id++;
-        trade_id = ss.str();
-    }
-    
-    std::string toString() const {
-        std::stringstream ss;
-        ss << trade_id << " | " << symbol << " | " << std::fixed 
-           << std::setprecision(2) << price << " | " << quantity;
-        return ss.str();
-    }
-};
-
-/**
- * @brief Price level in the order book
- */
-struct PriceLevel {
-    double price;
-    std::deque<std::shared_ptr<Order>> orders;
-    int total_quantity = 0;
-    
-    PriceLevel() : price(0.0) {}  // Constructeur par défaut
-    explicit PriceLevel(double p) : price(p) {}
-    
-    int getTotalQuantity() const {
-        int total = 0;
-        for (const auto& order : orders) {
-            total += order->getRemainingQuantity();
-        }
-        return total;
-    }
-};
-
-/**
- * @brief Order book for a specific instrument
- */
-class OrderBook {
-private:
-    std::string _symbol;
-    std::map<double, PriceLevel, std::greater<double>> _bids; // Highest first
-    std::map<double, PriceLevel> _asks; // Lowest first
-    std::unordered_map<std::string, std::shared_ptr<Order>> _orders_by_id;
-    
-    // Last trade price and timestamp
-    double _last_price = 0.0;
-    uint64_t _last_trade_time = 0;
-    
-    // Order book statistics
-    int _total_volume = 0;
-    
-    // Market price info
-    double _open_price = 0.0;
-    double _high_price = 0.0;
-    double _low_price = std::numeric_limits<double>::max();
-    
-public:
-    OrderBook() : _symbol("") {}  // Constructeur par défaut
-    explicit OrderBook(const std::string& symbol) : _symbol(symbol) {}
-    
-    // Get basic book info
-    std::string getSymbol() const { return _symbol; }
-    double getLastPrice() const { return _last_price; }
-    int getTotalVolume() const { return _total_volume; }
-    
-    // Get best bid and ask prices
-    double getBestBidPrice() const {
-        return _bids.empty() ? 0.0 : _bids.begin()->first;
-    }
-    
-    double getBestAskPrice() const {
-        return _asks.empty() ? 0.0 : _asks.begin()->first;
-    }
-    
-    // Get total volume at best bid and ask
-    int getBestBidVolume() const {
-        return _bids.empty() ? 0 : _bids.begin()->second.getTotalQuantity();
-    }
-    
-    int getBestAskVolume() const {
-        return _asks.empty() ? 0 : _asks.begin()->second.getTotalQuantity();
-    }
-    
-    // Add an order to the book
-    void addOrder(const std::shared_ptr<Order>& order) {
-        if (order->isMarketOrder()) {
-            // Market orders are executed immediately so they don't go into the book
-            return;
-        }
-        
-        // Store order in the map
-        _orders_by_id[order->order_id] = order;
-        
-        // Add to the appropriate side
-        if (order->side == Side::BUY) {
-            if (_bids.find(order->price) == _bids.end()) {
-                _bids[order->price] = PriceLevel(order->price);
-            }
-            _bids[order->price].orders.push_back(order);
-        } else {
-            if (_asks.find(order->price) == _asks.end()) {
-                _asks[order->price] = PriceLevel(order->price);
-            }
-            _asks[order->price].orders.push_back(order);
-        }
-    }
-    
-    // Remove an order from the book
-    void removeOrder(const std::string& order_id) {
-        auto order_it = _orders_by_id.find(order_id);
-        if (order_it == _orders_by_id.end()) {
-            return; // Order not found
-        }
-        
-        auto order = order_it->second;
-        
-        // Remove from the price level
-        if (order->side == Side::BUY) {
-            auto price_it = _bids.find(order->price);
-            if (price_it != _bids.end()) {
-                auto& orders = price_it->second.orders;
-                orders.erase(std::remove_if(orders.begin(), orders.end(),
-                    [&order_id](const std::shared_ptr<Order>& o) {
-                        return o->order_id == order_id;
-                    }), orders.end());
-                
-                // Remove price level if empty
-                if (orders.empty()) {
-                    _bids.erase(price_it);
-                }
-            }
-        } else {
-            auto price_it = _asks.find(order->price);
-            if (price_it != _asks.end()) {
-                auto& orders = price_it->second.orders;
-                orders.erase(std::remove_if(orders.begin(), orders.end(),
-                    [&order_id](const std::shared_ptr<Order>& o) {
-                        return o->order_id == order_id;
-                    }), orders.end());
-                
-                // Remove price level if empty
-                if (orders.empty()) {
-                    _asks.erase(price_it);
-                }
-            }
-        }
-        
-        // Remove from the map
-        _orders_by_id.erase(order_id);
-    }
-    
-    // Match orders and return resulting trades
-    std::vector<Trade> matchOrders(const std::shared_ptr<Order>& incoming_order) {
-        std::vector<Trade> trades;
-        
-        if (incoming_order->side == Side::BUY) {
-            // Buy order - match with asks
-            matchBuyOrder(incoming_order, trades);
-        } else {
-            // Sell order - match with bids
-            matchSellOrder(incoming_order, trades);
-        }
-        
-        // If there's any remaining quantity and it's not a market order, add to book
-        if (incoming_order->getRemainingQuantity() > 0 && !incoming_order->isMarketOrder()) {
-            addOrder(incoming_order);
-        }
-        
-        return trades;
-    }
-    
-private:
-    // Match a buy order against the available asks
-    void matchBuyOrder(const std::shared_ptr<Order>& buy_order, std::vector<Trade>& trades) {
-        // For market orders, use the best available price
-        double max_price = buy_order->isMarketOrder() ? 
-            std::numeric_limits<double>::max() : buy_order->price;
-        
-        // Continue matching as long as there are matching asks and the order has remaining quantity
-        while (!_asks.empty() && buy_order->getRemainingQuantity() > 0) {
-            // Get the best (lowest) ask price
-            auto ask_it = _asks.begin();
-            double ask_price = ask_it->first;
-            
-            // Check if we can match at this price
-            if (ask_price > max_price) {
-                break; // No matching ask prices
-            }
-            
-            // Get the orders at this price level
-            auto& ask_level = ask_it->second;
-            auto& ask_orders = ask_level.orders;
-            
-            // Match with orders at this price level
-            while (!ask_orders.empty() && buy_order->getRemainingQuantity() > 0) {
-                auto& sell_order = ask_orders.front();
-                
-                // Calculate the matched quantity
-                int match_qty = std::min(buy_order->getRemainingQuantity(), 
-                                        sell_order->getRemainingQuantity());
-                
-                // Update order quantities
-                buy_order->filled_quantity += match_qty;
-                sell_order->filled_quantity += match_qty;
-                
-                // Create a trade
-                trades.emplace_back(buy_order->order_id, sell_order->order_id, 
-                                   _symbol, ask_price, match_qty);
-                
-                // Update market stats
-                _total_volume += match_qty;
-                _last_price = ask_price;
-                _last_trade_time = getCurrentTimestamp();
-                
-                if (_high_price < ask_price) _high_price = ask_price;
-                if (_low_price > ask_price) _low_price = ask_price;
-                if (_open_price == 0) _open_price = ask_price;
-                
-                // Update order status
-                if (sell_order->isFullyFilled()) {
-                    sell_order->status = OrderStatus::FILLED;
-                    ask_orders.pop_front(); // Remove the filled order
-                } else {
-                    sell_order->status = OrderStatus::PARTIALLY_FILLED;
-                    break; // The sell order still has quantity, so we're done with this buy order
-                }
-            }
-            
-            // If no more orders at this price level, remove it
-            if (ask_orders.empty()) {
-                _asks.erase(ask_it);
-            }
-        }
-        
-        // Update the buy order status
-        if (buy_order->isFullyFilled()) {
-            buy_order->status = OrderStatus::FILLED;
-        } else if (buy_order->filled_quantity > 0) {
-            buy_order->status = OrderStatus::PARTIALLY_FILLED;
-        }
-    }
-    
-    // Match a sell order against the available bids
-    void matchSellOrder(const std::shared_ptr<Order>& sell_order, std::vector<Trade>& trades) {
-        // For market orders, use any bid price
-        double min_price = sell_order->isMarketOrder() ? 0.0 : sell_order->price;
-        
-        // Continue matching as long as there are matching bids and the order has remaining quantity
-        while (!_bids.empty() && sell_order->getRemainingQuantity() > 0) {
-            // Get the best (highest) bid price
-            auto bid_it = _bids.begin();
-            double bid_price = bid_it->first;
-            
-            // Check if we can match at this price
-            if (bid_price < min_price) {
-                break; // No matching bid prices
-            }
-            
-            // Get the orders at this price level
-            auto& bid_level = bid_it->second;
-            auto& bid_orders = bid_level.orders;
-            
-            // Match with orders at this price level
-            while (!bid_orders.empty() && sell_order->getRemainingQuantity() > 0) {
-                auto& buy_order = bid_orders.front();
-                
-                // Calculate the matched quantity
-                int match_qty = std::min(sell_order->getRemainingQuantity(), 
-                                        buy_order->getRemainingQuantity());
-                
-                // Update order quantities
-                sell_order->filled_quantity += match_qty;
-                buy_order->filled_quantity += match_qty;
-                
-                // Create a trade
-                trades.emplace_back(buy_order->order_id, sell_order->order_id, 
-                                   _symbol, bid_price, match_qty);
-                
-                // Update market stats
-                _total_volume += match_qty;
-                _last_price = bid_price;
-                _last_trade_time = getCurrentTimestamp();
-                
-                if (_high_price < bid_price) _high_price = bid_price;
-                if (_low_price > bid_price) _low_price = bid_price;
-                if (_open_price == 0) _open_price = bid_price;
-                
-                // Update order status
-                if (buy_order->isFullyFilled()) {
-                    buy_order->status = OrderStatus::FILLED;
-                    bid_orders.pop_front(); // Remove the filled order
-                } else {
-                    buy_order->status = OrderStatus::PARTIALLY_FILLED;
-                    break; // The buy order still has quantity, so we're done with this sell order
-                }
-            }
-            
-            // If no more orders at this price level, remove it
-            if (bid_orders.empty()) {
-                _bids.erase(bid_it);
-            }
-        }
-        
-        // Update the sell order status
-        if (sell_order->isFullyFilled()) {
-            sell_order->status = OrderStatus::FILLED;
-        } else if (sell_order->filled_quantity > 0) {
-            sell_order->status = OrderStatus::PARTIALLY_FILLED;
-        }
-    }
-};
-
 // ═════════════════════════════════════════════════════════════════
 // EVENT MESSAGES
 // ═════════════════════════════════════════════════════════════════
@@ -530,9 +135,11 @@ private:
 // Base message for all order-related events
 struct OrderMessage : public qb::Event {
     std::shared_ptr<Order> order;
+    tracing::Context trace;  // sampled orders only
     
     explicit OrderMessage(const std::shared_ptr<Order>& o) : order(o) {}
 };
+QB_AUDIT_HOT_EVENT(OrderMessage, 2 * audit::CACHE_LINE, order, trace);
 
 // New order submission
 struct NewOrderMessage : public OrderMessage {
@@ -558,6 +165,7 @@ struct ExecutionMessage : public qb::Event {
         order->client_id = client_id;
     }
 };
+QB_AUDIT_EVENT(ExecutionMessage, order, trade_id, execution_price, execution_quantity);
 
 // Order cancellation request
 struct CancelOrderMessage : public OrderMessage {
@@ -578,6 +186,7 @@ struct MarketDataMessage : public qb::Event {
     int ask_size;
     double last_price;
     int last_size;
+    tracing::Context trace;
 
     // Constructeur par défaut
     MarketDataMessage() : bid_price(0.0), bid_size(0), ask_price(0.0), ask_size(0), last_price(0.0), last_size(0) {}
@@ -587,13 +196,16 @@ struct MarketDataMessage : public qb::Event {
         : symbol(sym), bid_price(bp), bid_size(bs), ask_price(ap), ask_size(as),
           last_price(lp), last_size(ls) {}
 };
+QB_AUDIT_EVENT(MarketDataMessage, symbol, bid_price, bid_size, ask_price, ask_size, last_price, last_size, trace);
 
 // Trade notification message
 struct TradeMessage : public qb::Event {
     Trade trade;
+    tracing::Context trace;
     
     explicit TradeMessage(const Trade& t) : trade(t) {}
 };
+QB_AUDIT_EVENT(TradeMessage, trade, trace);
 
 // Performance statistics message
 struct StatisticsMessage : public qb::Event {
@@ -659,16 +271,14 @@ public:
     
     void on(ExecutionMessage& msg) {
         // Handle execution report
-        qb::io::cout() << "Client " << _client_id << " received execution: "
-                << msg.trade_id << " for " << msg.execution_quantity 
-                << " at $" << msg.execution_price << std::endl;
+        QB_LOG_INFO("Client {} received execution: {} for {} at ${}",
+                    _client_id, msg.trade_id, msg.execution_quantity, msg.execution_price);
     }
     
     void on(OrderStatusMessage& msg) {
         // Handle order status update
-        qb::io::cout() << "Client " << _client_id << " order status: "
-                << msg.order->order_id << " is now " 
-                << statusToString(msg.order->status) << std::endl;
+        QB_LOG_DEBUG("Client {} order status: {} is now {}",
+                    _client_id, msg.order->order_id, statusToString(msg.order->status));
     }
     
     void on(qb::KillEvent&) {
@@ -713,11 +323,13 @@ private:
         // Create the order
         auto order = std::make_shared<Order>(_client_id, symbol, side, price, quantity);
         
-        // Send to order entry
-        push<NewOrderMessage>(_order_entry_id, order);
+        // Send to order entry; a sampled order starts a trace here
+        tracing::Span span("ClientActor.newOrder", tracing::Tracer::instance().sample());
+        auto& msg = push<NewOrderMessage>(_order_entry_id, order);
+        msg.trace = span.propagate();
         
         // Update statistics
-        g_total_orders++;
+        g_total_orders.inc();
     }
 };
 
@@ -746,7 +358,8 @@ public:
     }
     
     void on(NewOrderMessage& msg) {
-        g_total_order_messages++;
+        tracing::Span span("OrderEntryActor.newOrder", msg.trace);
+        g_total_order_messages.inc();
         
         auto order = msg.order;
         
@@ -759,16 +372,18 @@ public:
         
         // Track the order
         _active_orders[order->order_id] = order;
+        g_active_orders.set(static_cast<int64_t>(_active_orders.size()));
         
         // Send acknowledgment to client
         push<OrderStatusMessage>(msg.getSource(), order);
         
         // Forward to matching engine
-        push<NewOrderMessage>(_matching_engine_id, order);
+        auto& forward = push<NewOrderMessage>(_matching_engine_id, order);
+        forward.trace = span.propagate();
     }
     
     void on(CancelOrderMessage& msg) {
-        g_total_order_messages++;
+        g_total_order_messages.inc();
         
         auto order_id = msg.order->order_id;
         
@@ -795,6 +410,7 @@ public:
             if (msg.order->status == OrderStatus::FILLED || 
                 msg.order->status == OrderStatus::CANCELED) {
                 _active_orders.erase(order_id);
+                g_active_orders.set(static_cast<int64_t>(_active_orders.size()));
             }
         }
         
@@ -847,6 +463,8 @@ public:
     }
     
     void on(NewOrderMessage& msg) {
+        tracing::Span span("MatchingEngineActor.match", msg.trace);
+        const auto match_start = std::chrono::steady_clock::now();
         auto order = msg.order;
         
         // Check if we have an order book for this symbol
@@ -863,17 +481,22 @@ public:
         // Process resulting trades
         for (const auto& trade : trades) {
             // Increment trade counter
-            g_total_trades++;
+            g_total_trades.inc();
             
             // Notify clients of execution
             executeTrade(trade);
             
             // Send trade to market data
-            push<TradeMessage>(_market_data_id, trade);
+            auto& trade_msg = push<TradeMessage>(_market_data_id, trade);
+            trade_msg.trace = span.propagate();
         }
         
         // Update market data
-        publishMarketDataForSymbol(order->symbol);
+        publishMarketDataForSymbol(order->symbol, span.propagate());
+        
+        g_match_latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - match_start).count()));
     }
     
     void on(CancelOrderMessage& msg) {
@@ -929,7 +552,7 @@ private:
     }
     
     // Publish market data for a specific symbol
-    void publishMarketDataForSymbol(const std::string& symbol) {
+    void publishMarketDataForSymbol(const std::string& symbol, const tracing::Context& trace = {}) {
         // Check if we have an order book for this symbol
         if (_order_books.find(symbol) == _order_books.end()) {
             return;  // Symbol not found
@@ -946,18 +569,20 @@ private:
         double last_price = order_book.getLastPrice();
         
         // Publish market data
-        publishMarketData(symbol, bid_price, bid_size, ask_price, ask_size, last_price, 0);
+        publishMarketData(symbol, bid_price, bid_size, ask_price, ask_size, last_price, 0, trace);
     }
     
     // Helper to publish market data
     void publishMarketData(const std::string& symbol, double bid_price, int bid_size,
-                          double ask_price, int ask_size, double last_price, int last_size) {
-        g_total_market_data_messages++;
+                          double ask_price, int ask_size, double last_price, int last_size,
+                          const tracing::Context& trace = {}) {
+        g_total_market_data_messages.inc();
         
-        push<MarketDataMessage>(
+        auto& msg = push<MarketDataMessage>(
             _market_data_id,
             symbol, bid_price, bid_size, ask_price, ask_size, last_price, last_size
         );
+        msg.trace = trace;
     }
     
     // Get sender ID from order ID (placeholder implementation)
@@ -990,16 +615,14 @@ public:
     }
     
     void on(MarketDataMessage& msg) {
+        tracing::Span span("MarketDataActor.marketData", msg.trace);
+        
         // Store the latest market data
         _latest_market_data[msg.symbol] = msg;
         
         // Log the market data
-        qb::io::cout() << "Market Data: " << msg.symbol
-                 << " Bid: " << std::fixed << std::setprecision(2) << msg.bid_price 
-                 << " x " << msg.bid_size
-                 << " Ask: " << msg.ask_price 
-                 << " x " << msg.ask_size
-                 << " Last: " << msg.last_price << std::endl;
+        QB_LOG_DEBUG("Market Data: {} Bid: {:.2f} x {} Ask: {:.2f} x {} Last: {:.2f}",
+                    msg.symbol, msg.bid_price, msg.bid_size, msg.ask_price, msg.ask_size, msg.last_price);
         
         // Broadcast to subscribers
         for (const auto& subscriber_id : _subscribers) {
@@ -1009,8 +632,10 @@ public:
     }
     
     void on(TradeMessage& msg) {
+        tracing::Span span("MarketDataActor.trade", msg.trace);
+        
         // Log the trade
-        qb::io::cout() << "Trade: " << msg.trade.toString() << std::endl;
+        QB_LOG_INFO("Trade: {}", msg.trade.toString());
     }
     
     void on(qb::KillEvent&) {
@@ -1099,6 +724,10 @@ public:
                  << orders_per_sec << " orders/sec, " 
                  << trades_per_sec << " trades/sec, " 
                  << messages_per_sec << " messages/sec" << std::endl;
+        
+        const auto latency = g_match_latency.snapshot();
+        qb::io::cout() << "Matching Latency: p50 " << latency.quantile(0.50) << " ns, p99 "
+                 << latency.quantile(0.99) << " ns, active orders " << g_active_orders.value() << std::endl;
         qb::io::cout() << "==========================================" << std::endl;
     }
     
@@ -1122,10 +751,10 @@ private:
             // Send statistics message to self
             push<StatisticsMessage>(
                 id(),
-                g_total_orders.load(),
-                g_total_trades.load(),
-                g_total_order_messages.load(),
-                g_total_market_data_messages.load(),
+                g_total_orders.value(),
+                g_total_trades.value(),
+                g_total_order_messages.value(),
+                g_total_market_data_messages.value(),
                 elapsed_seconds
             );
             
@@ -1143,10 +772,10 @@ private:
         
         push<StatisticsMessage>(
             id(),
-            g_total_orders.load(),
-            g_total_trades.load(),
-            g_total_order_messages.load(),
-            g_total_market_data_messages.load(),
+            g_total_orders.value(),
+            g_total_trades.value(),
+            g_total_order_messages.value(),
+            g_total_market_data_messages.value(),
             elapsed_seconds
         );
         
@@ -1169,26 +798,36 @@ private:
 /**
  * Main function to set up and run the trading system
  */
-int main() {
+int main(int argc, char* argv[]) {
     qb::io::cout() << "Initializing multi-core trading system..." << std::endl;
     
+    // Core of each actor role, overridable with --placement FILE / --place role=spec
+    auto placement = placement::Placement::fromArgs({
+        {"market_data", 1, "0"},
+        {"matching_engine", 1, "1"},
+        {"order_entry", 1, "2"},
+        {"client", NUM_CLIENTS, "0,3"},
+        {"supervisor", 1, "0"},
+    }, argc, argv);
+    qb::io::cout() << placement.describe();
+    
     // Create the main engine with multiple cores
     qb::Main engine;
     
-    // Create market data actor (core 0)
-    auto market_data_id = engine.addActor<MarketDataActor>(0);
+    // Create market data actor (default core 0)
+    auto market_data_id = engine.addActor<MarketDataActor>(placement.core("market_data"));
     
-    // Create matching engine actor (core 1 - dedicated for low latency)
-    auto matching_engine_id = engine.addActor<MatchingEngineActor>(1, market_data_id);
+    // Create matching engine actor (default core 1 - dedicated for low latency)
+    auto matching_engine_id = engine.addActor<MatchingEngineActor>(placement.core("matching_engine"), market_data_id);
     
-    // Create order entry actor (core 2)
-    auto order_entry_id = engine.addActor<OrderEntryActor>(2, matching_engine_id);
+    // Create order entry actor (default core 2)
+    auto order_entry_id = engine.addActor<OrderEntryActor>(placement.core("order_entry"), matching_engine_id);
     
     // Create client actors (distribute across cores)
     std::vector<qb::ActorId> client_ids;
     for (int i = 0; i < NUM_CLIENTS; ++i) {
-        // Distribute clients across cores (except core 1 which is dedicated to matching engine)
-        int core_id = (i % 3 == 1) ? 0 : (i % 3 + 1);
+        // Distribute clients across cores (by default 0 and 3, away from the matching engine)
+        const auto core_id = placement.core("client", static_cast<unsigned>(i));
         
         // Each client focuses on a specific symbol
         std::string symbol = SYMBOLS[i % NUM_SYMBOLS];
@@ -1206,16 +845,34 @@ int main() {
         client_ids.push_back(actor_id);
     }
     
-    // Create supervisor actor (core 0)
+#ifdef QB_EXAMPLES_METRICS_HTTP
+    // Expose the metrics registry for Prometheus (core 0, off the hot path)
+    engine.addActor<metrics::MetricsEndpoint>(placement.core("supervisor"), "tcp://0.0.0.0:9100");
+#endif
+    
+    // Create supervisor actor (default core 0)
     auto supervisor_id = engine.addActor<SupervisorActor>(
-        0, matching_engine_id, order_entry_id, market_data_id, client_ids
+        placement.core("supervisor"), matching_engine_id, order_entry_id, market_data_id, client_ids
     );
+    placement.pin(engine);
+    
+    // Asynchronous logging: QB_LOG_LEVEL=debug shows every market data tick
+    logging::Logger::instance().startFromEnv();
+    
+    // Optional request tracing: QB_TRACE_FILE=trace.json, QB_TRACE_SAMPLE=N (1 order in N)
+    if (const char* trace_path = std::getenv("QB_TRACE_FILE")) {
+        const char* sample = std::getenv("QB_TRACE_SAMPLE");
+        tracing::Tracer::instance().start(
+            trace_path, sample ? static_cast<uint32_t>(std::strtoul(sample, nullptr, 10)) : 10);
+    }
     
     // Start the system
     engine.start();
     
     // Wait for the system to complete
     engine.join();
+    tracing::Tracer::instance().stop();
+    logging::Logger::instance().stop();
     
     qb::io::cout() << "Trading system simulation completed" << std::endl;
     return 0;
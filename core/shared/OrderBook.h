@@ -0,0 +1,469 @@
+/**
+ * @file examples/core/shared/OrderBook.h
+ * @brief Order, trade and price-time priority order book of the trading example.
+ *
+ * @details
+ * The domain model of `example9_trading_system.cpp`, kept apart from its actors so the
+ * matching logic can be measured without an engine (`benchmarks/bench_orderbook.cpp`):
+ *
+ * - `Order`: A client instruction. A price of 0 makes it a market order.
+ * - `Trade`: A match between a buy and a sell order.
+ * - `PriceLevel`: The orders resting at one price, in arrival order.
+ * - `OrderBook`: Bids (highest first) and asks (lowest first) of one symbol.
+ *   `matchOrders()` matches an incoming order against the opposite side and rests
+ *   the remaining quantity of a limit order.
+ *
+ * Order and trade ids come from process-wide atomic counters, so books may live on
+ * different cores.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Helper function to get current timestamp in microseconds
+inline uint64_t getCurrentTimestamp() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now().time_since_epoch()
+        ).count()
+    );
+}
+
+// Generate a unique order ID
+inline std::string generateOrderId() {
+    static std::atomic<uint64_t> next_id{1};
+    std::stringstream ss;
+    ss << "ORD-" << std::setw(10) << std::setfill('0') << next_id++;
+    return ss.str();
+}
+
+// ═════════════════════════════════════════════════════════════════
+// DOMAIN MODELS
+// ═════════════════════════════════════════════════════════════════
+
+enum class Side {
+    BUY,
+    SELL
+};
+
+inline std::string sideToString(Side side) {
+    return side == Side::BUY ? "BUY" : "SELL";
+}
+
+enum class OrderStatus {
+    NEW,
+    PARTIALLY_FILLED,
+    FILLED,
+    CANCELED,
+    REJECTED
+};
+
+inline std::string statusToString(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::NEW: return "NEW";
+        case OrderStatus::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
+        case OrderStatus::FILLED: return "FILLED";
+        case OrderStatus::CANCELED: return "CANCELED";
+        case OrderStatus::REJECTED: return "REJECTED";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Order model representing a client's trading instruction
+ */
+struct Order {
+    std::string order_id;
+    std::string client_id;
+    std::string symbol;
+    Side side;
+    double price;
+    int quantity;
+    int filled_quantity = 0;
+    OrderStatus status = OrderStatus::NEW;
+    uint64_t timestamp;
+    
+    // Constructeur par défaut
+    Order() : price(0.0), quantity(0), side(Side::BUY), timestamp(getCurrentTimestamp()), order_id(generateOrderId()) {}
+    
+    // Constructor for market orders
+    Order(const std::string& client, const std::string& sym, Side s, int qty)
+        : order_id(generateOrderId()), client_id(client), symbol(sym),
+          side(s), quantity(qty), timestamp(getCurrentTimestamp()) {
+        // Market orders have zero price (will match at best available)
+        price = 0.0;
+    }
+    
+    // Constructor for limit orders
+    Order(const std::string& client, const std::string& sym, Side s, double p, int qty)
+        : order_id(generateOrderId()), client_id(client), symbol(sym),
+          side(s), price(p), quantity(qty), timestamp(getCurrentTimestamp()) {}
+    
+    // Determine if the order is fully filled
+    bool isFullyFilled() const {
+        return filled_quantity >= quantity;
+    }
+    
+    // Determine if the order is a market order
+    bool isMarketOrder() const {
+        return price == 0.0;
+    }
+    
+    // Get the remaining unfilled quantity
+    int getRemainingQuantity() const {
+        return quantity - filled_quantity;
+    }
+    
+    std::string toString() const {
+        std::stringstream ss;
+        ss << order_id << " | " << client_id << " | " << symbol << " | " 
+           << sideToString(side) << " | " << std::fixed << std::setprecision(2) << price 
+           << " | " << filled_quantity << "/" << quantity 
+           << " | " << statusToString(status);
+        return ss.str();
+    }
+};
+
+/**
+ * @brief Trade model representing a matched pair of orders
+ */
+struct Trade {
+    std::string trade_id;
+    std::string buy_order_id;
+    std::string sell_order_id;
+    std::string symbol;
+    double price;
+    int quantity;
+    uint64_t timestamp;
+    
+    Trade(const std::string& buy_id, const std::string& sell_id, 
+          const std::string& sym, double p, int qty)
+        : buy_order_id(buy_id), sell_order_id(sell_id), symbol(sym),
+          price(p), quantity(qty), timestamp(getCurrentTimestamp()) {
+        
+        // Generate a unique trade ID
+        static std::atomic<uint64_t> next_trade_id{1};
+        std::stringstream ss;
+        ss << "TRD-" << std::setw(10) << std::setfill('0') << next_trade_id++;
+        trade_id = ss.str();
+    }
+    
+    std::string toString() const {
+        std::stringstream ss;
+        ss << trade_id << " | " << symbol << " | " << std::fixed 
+           << std::setprecision(2) << price << " | " << quantity;
+        return ss.str();
+    }
+};
+
+/**
+ * @brief Price level in the order book
+ */
+struct PriceLevel {
+    double price;
+    std::deque<std::shared_ptr<Order>> orders;
+    int total_quantity = 0;
+    
+    PriceLevel() : price(0.0) {}  // Constructeur par défaut
+    explicit PriceLevel(double p) : price(p) {}
+    
+    int getTotalQuantity() const {
+        int total = 0;
+        for (const auto& order : orders) {
+            total += order->getRemainingQuantity();
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief Order book for a specific instrument
+ */
+class OrderBook {
+private:
+    std::string _symbol;
+    std::map<double, PriceLevel, std::greater<double>> _bids; // Highest first
+    std::map<double, PriceLevel> _asks; // Lowest first
+    std::unordered_map<std::string, std::shared_ptr<Order>> _orders_by_id;
+    
+    // Last trade price and timestamp
+    double _last_price = 0.0;
+    uint64_t _last_trade_time = 0;
+    
+    // Order book statistics
+    int _total_volume = 0;
+    
+    // Market price info
+    double _open_price = 0.0;
+    double _high_price = 0.0;
+    double _low_price = std::numeric_limits<double>::max();
+    
+public:
+    OrderBook() : _symbol("") {}  // Constructeur par défaut
+    explicit OrderBook(const std::string& symbol) : _symbol(symbol) {}
+    
+    // Get basic book info
+    std::string getSymbol() const { return _symbol; }
+    double getLastPrice() const { return _last_price; }
+    int getTotalVolume() const { return _total_volume; }
+    
+    // Get best bid and ask prices
+    double getBestBidPrice() const {
+        return _bids.empty() ? 0.0 : _bids.begin()->first;
+    }
+    
+    double getBestAskPrice() const {
+        return _asks.empty() ? 0.0 : _asks.begin()->first;
+    }
+    
+    // Get total volume at best bid and ask
+    int getBestBidVolume() const {
+        return _bids.empty() ? 0 : _bids.begin()->second.getTotalQuantity();
+    }
+    
+    int getBestAskVolume() const {
+        return _asks.empty() ? 0 : _asks.begin()->second.getTotalQuantity();
+    }
+    
+    // Add an order to the book
+    void addOrder(const std::shared_ptr<Order>& order) {
+        if (order->isMarketOrder()) {
+            // Market orders are executed immediately so they don't go into the book
+            return;
+        }
+        
+        // Store order in the map
+        _orders_by_id[order->order_id] = order;
+        
+        // Add to the appropriate side
+        if (order->side == Side::BUY) {
+            if (_bids.find(order->price) == _bids.end()) {
+                _bids[order->price] = PriceLevel(order->price);
+            }
+            _bids[order->price].orders.push_back(order);
+        } else {
+            if (_asks.find(order->price) == _asks.end()) {
+                _asks[order->price] = PriceLevel(order->price);
+            }
+            _asks[order->price].orders.push_back(order);
+        }
+    }
+    
+    // Remove an order from the book
+    void removeOrder(const std::string& order_id) {
+        auto order_it = _orders_by_id.find(order_id);
+        if (order_it == _orders_by_id.end()) {
+            return; // Order not found
+        }
+        
+        auto order = order_it->second;
+        
+        // Remove from the price level
+        if (order->side == Side::BUY) {
+            auto price_it = _bids.find(order->price);
+            if (price_it != _bids.end()) {
+                auto& orders = price_it->second.orders;
+                orders.erase(std::remove_if(orders.begin(), orders.end(),
+                    [&order_id](const std::shared_ptr<Order>& o) {
+                        return o->order_id == order_id;
+                    }), orders.end());
+                
+                // Remove price level if empty
+                if (orders.empty()) {
+                    _bids.erase(price_it);
+                }
+            }
+        } else {
+            auto price_it = _asks.find(order->price);
+            if (price_it != _asks.end()) {
+                auto& orders = price_it->second.orders;
+                orders.erase(std::remove_if(orders.begin(), orders.end(),
+                    [&order_id](const std::shared_ptr<Order>& o) {
+                        return o->order_id == order_id;
+                    }), orders.end());
+                
+                // Remove price level if empty
+                if (orders.empty()) {
+                    _asks.erase(price_it);
+                }
+            }
+        }
+        
+        // Remove from the map
+        _orders_by_id.erase(order_id);
+    }
+    
+    // Match orders and return resulting trades
+    std::vector<Trade> matchOrders(const std::shared_ptr<Order>& incoming_order) {
+        std::vector<Trade> trades;
+        
+        if (incoming_order->side == Side::BUY) {
+            // Buy order - match with asks
+            matchBuyOrder(incoming_order, trades);
+        } else {
+            // Sell order - match with bids
+            matchSellOrder(incoming_order, trades);
+        }
+        
+        // If there's any remaining quantity and it's not a market order, add to book
+        if (incoming_order->getRemainingQuantity() > 0 && !incoming_order->isMarketOrder()) {
+            addOrder(incoming_order);
+        }
+        
+        return trades;
+    }
+    
+private:
+    // Match a buy order against the available asks
+    void matchBuyOrder(const std::shared_ptr<Order>& buy_order, std::vector<Trade>& trades) {
+        // For market orders, use the best available price
+        double max_price = buy_order->isMarketOrder() ? 
+            std::numeric_limits<double>::max() : buy_order->price;
+        
+        // Continue matching as long as there are matching asks and the order has remaining quantity
+        while (!_asks.empty() && buy_order->getRemainingQuantity() > 0) {
+            // Get the best (lowest) ask price
+            auto ask_it = _asks.begin();
+            double ask_price = ask_it->first;
+            
+            // Check if we can match at this price
+            if (ask_price > max_price) {
+                break; // No matching ask prices
+            }
+            
+            // Get the orders at this price level
+            auto& ask_level = ask_it->second;
+            auto& ask_orders = ask_level.orders;
+            
+            // Match with orders at this price level
+            while (!ask_orders.empty() && buy_order->getRemainingQuantity() > 0) {
+                auto& sell_order = ask_orders.front();
+                
+                // Calculate the matched quantity
+                int match_qty = std::min(buy_order->getRemainingQuantity(), 
+                                        sell_order->getRemainingQuantity());
+                
+                // Update order quantities
+                buy_order->filled_quantity += match_qty;
+                sell_order->filled_quantity += match_qty;
+                
+                // Create a trade
+                trades.emplace_back(buy_order->order_id, sell_order->order_id, 
+                                   _symbol, ask_price, match_qty);
+                
+                // Update market stats
+                _total_volume += match_qty;
+                _last_price = ask_price;
+                _last_trade_time = getCurrentTimestamp();
+                
+                if (_high_price < ask_price) _high_price = ask_price;
+                if (_low_price > ask_price) _low_price = ask_price;
+                if (_open_price == 0) _open_price = ask_price;
+                
+                // Update order status
+                if (sell_order->isFullyFilled()) {
+                    sell_order->status = OrderStatus::FILLED;
+                    ask_orders.pop_front(); // Remove the filled order
+                } else {
+                    sell_order->status = OrderStatus::PARTIALLY_FILLED;
+                    break; // The sell order still has quantity, so we're done with this buy order
+                }
+            }
+            
+            // If no more orders at this price level, remove it
+            if (ask_orders.empty()) {
+                _asks.erase(ask_it);
+            }
+        }
+        
+        // Update the buy order status
+        if (buy_order->isFullyFilled()) {
+            buy_order->status = OrderStatus::FILLED;
+        } else if (buy_order->filled_quantity > 0) {
+            buy_order->status = OrderStatus::PARTIALLY_FILLED;
+        }
+    }
+    
+    // Match a sell order against the available bids
+    void matchSellOrder(const std::shared_ptr<Order>& sell_order, std::vector<Trade>& trades) {
+        // For market orders, use any bid price
+        double min_price = sell_order->isMarketOrder() ? 0.0 : sell_order->price;
+        
+        // Continue matching as long as there are matching bids and the order has remaining quantity
+        while (!_bids.empty() && sell_order->getRemainingQuantity() > 0) {
+            // Get the best (highest) bid price
+            auto bid_it = _bids.begin();
+            double bid_price = bid_it->first;
+            
+            // Check if we can match at this price
+            if (bid_price < min_price) {
+                break; // No matching bid prices
+            }
+            
+            // Get the orders at this price level
+            auto& bid_level = bid_it->second;
+            auto& bid_orders = bid_level.orders;
+            
+            // Match with orders at this price level
+            while (!bid_orders.empty() && sell_order->getRemainingQuantity() > 0) {
+                auto& buy_order = bid_orders.front();
+                
+                // Calculate the matched quantity
+                int match_qty = std::min(sell_order->getRemainingQuantity(), 
+                                        buy_order->getRemainingQuantity());
+                
+                // Update order quantities
+                sell_order->filled_quantity += match_qty;
+                buy_order->filled_quantity += match_qty;
+                
+                // Create a trade
+                trades.emplace_back(buy_order->order_id, sell_order->order_id, 
+                                   _symbol, bid_price, match_qty);
+                
+                // Update market stats
+                _total_volume += match_qty;
+                _last_price = bid_price;
+                _last_trade_time = getCurrentTimestamp();
+                
+                if (_high_price < bid_price) _high_price = bid_price;
+                if (_low_price > bid_price) _low_price = bid_price;
+                if (_open_price == 0) _open_price = bid_price;
+                
+                // Update order status
+                if (buy_order->isFullyFilled()) {
+                    buy_order->status = OrderStatus::FILLED;
+                    bid_orders.pop_front(); // Remove the filled order
+                } else {
+                    buy_order->status = OrderStatus::PARTIALLY_FILLED;
+                    break; // The buy order still has quantity, so we're done with this sell order
+                }
+            }
+            
+            // If no more orders at this price level, remove it
+            if (bid_orders.empty()) {
+                _bids.erase(bid_it);
+            }
+        }
+        
+        // Update the sell order status
+        if (sell_order->isFullyFilled()) {
+            sell_order->status = OrderStatus::FILLED;
+        } else if (sell_order->filled_quantity > 0) {
+            sell_order->status = OrderStatus::PARTIALLY_FILLED;
+        }
+    }
+};
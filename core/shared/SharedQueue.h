@@ -0,0 +1,49 @@
+/**
+ * @file examples/core/shared/SharedQueue.h
+ * @brief Mutex-protected FIFO shared by the producer and consumers of the shared queue example.
+ *
+ * @details
+ * Every operation takes the same `std::mutex`, so producers and consumers on different
+ * cores serialize on it. `benchmarks/bench_shared_queue.cpp` measures its cost alone and
+ * under contention.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <queue>
+
+// Thread-safe shared queue for actors
+template <typename T>
+class SharedQueue {
+public:
+    void push(const T& item) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push(item);
+    }
+
+    bool pop(T& item) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_queue.empty()) {
+            return false;
+        }
+        item = _queue.front();
+        _queue.pop();
+        return true;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.size();
+    }
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.empty();
+    }
+
+private:
+    std::queue<T> _queue;
+    mutable std::mutex _mutex;
+};
@@ -0,0 +1,54 @@
+/**
+ * @file examples/core/shared/TransitionTable.h
+ * @brief State machine transition table of the coffee machine example.
+ *
+ * @details
+ * Maps a (state, input) pair to the handler that performs the transition. Handlers are
+ * registered with `table[state][input] = handler` and looked up with `dispatch()`, which
+ * runs on every input the state machine receives. `benchmarks/bench_fsm.cpp` measures
+ * that lookup.
+ *
+ * @tparam State   Enumeration of the machine states
+ * @tparam Input   Enumeration of the inputs that trigger transitions
+ * @tparam Message Message passed to the handlers
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+
+template <typename State, typename Input, typename Message>
+class TransitionTable {
+public:
+    using Handler = std::function<void(const Message&)>;
+    using Handlers = std::map<Input, Handler>;
+
+    /// Handlers of one state, created empty on first access
+    Handlers& operator[](State state) {
+        return _table[state];
+    }
+
+    /// True if a handler is registered for the pair
+    bool contains(State state, Input input) const {
+        auto state_it = _table.find(state);
+        return state_it != _table.end() && state_it->second.count(input) > 0;
+    }
+
+    /// Runs the handler of the pair; returns false if there is none
+    bool dispatch(State state, Input input, const Message& msg) const {
+        auto state_it = _table.find(state);
+        if (state_it == _table.end()) {
+            return false;
+        }
+        auto it = state_it->second.find(input);
+        if (it == state_it->second.end()) {
+            return false;
+        }
+        it->second(msg);
+        return true;
+    }
+
+private:
+    std::map<State, Handlers> _table;
+};
@@ -76,6 +76,8 @@ void ClientActor::on(const chat::Message& msg) {
         case chat::MessageType::AUTH_RESPONSE:
             qb::io::cout() << "Server: " << msg.payload << std::endl;
             _authenticated = true;
+            // Let the input actor start reading messages
+            push<ClientReadyEvent>(_input_actor).ready = true;
             break;
             
         case chat::MessageType::CHAT_MESSAGE:
@@ -107,6 +109,7 @@ void ClientActor::on(qb::io::async::event::disconnected const&) {
     qb::io::cout() << "Disconnected from server" << std::endl;
     _connected = false;
     _authenticated = false;
+    push<ClientReadyEvent>(_input_actor).ready = false;
     
     if (_should_reconnect) {
         // Schedule async reconnection with delay
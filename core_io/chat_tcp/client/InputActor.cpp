@@ -5,31 +5,35 @@
  *
  * @details
  * This file contains the implementation of `InputActor`.
- * - `onInit()`: Registers the `qb::ICallback` and displays initial user prompts.
- * - `onCallback()`: This method is called periodically by the QB engine. It attempts
- *   to read a line from `std::cin`. If input is available (e.g., user pressed Enter),
- *   it processes the input. The `std::getline` itself can be blocking if input isn't ready,
- *   so for a truly non-blocking GUI or more complex console input, platform-specific
- *   non-blocking I/O or a separate input thread that messages the actor would be more robust.
- *   However, for simple console examples, `ICallback` with `std::getline` is often used for simplicity.
+ * - `onInit()`: Creates an `ev::io` read watcher on stdin and
+ *   displays initial user prompts.
+ * - `onStdinReadable()`: Called by the event loop when stdin has data. Reads what is
+ *   available with `read()`, polling before each one (up to a 64 KiB budget), so the core is never blocked waiting for the user,
+ *   splits the buffer into lines and processes each complete one; end of input is treated as "quit".
+ * - `processLine()`:
  *   - If the input is "quit", it signals the `ClientActor` and itself to terminate using `qb::KillEvent`.
  *   - Otherwise, non-empty input is sent as a `ChatInputEvent` to the `ClientActor`.
  *
  * QB Features Demonstrated (in context of this implementation):
- * - `qb::ICallback` usage for periodic actions.
+ * - `ev::io` watcher on the core's event loop for readiness-driven input.
  * - Sending events (`ChatInputEvent`, `qb::KillEvent`) to other actors and self.
  * - `qb::io::cout()` for console output.
  */
 
 #include "InputActor.h"
-#include <iostream>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
 
 InputActor::InputActor(qb::ActorId client_id)
     : _client_id(client_id) {}
 
 bool InputActor::onInit() {
-    // Register for non-blocking input handling
-    registerCallback(*this);
+    // Wake up only when stdin is readable, started once the client is ready
+    _stdin_watcher = std::make_unique<ev::io>(qb::io::async::listener::current.loop());
+    _stdin_watcher->set<InputActor, &InputActor::onStdinReadable>(this);
+    _stdin_watcher->set(STDIN_FILENO, ev::READ);
+    registerEvent<ClientReadyEvent>(*this);
     
     // Display initialization and usage information
     qb::io::cout() << "InputActor initialized with ID: " << id() << std::endl;
@@ -38,18 +42,71 @@ bool InputActor::onInit() {
     return true;
 }
 
-void InputActor::onCallback() {
-    std::string line;
+void InputActor::on(const ClientReadyEvent& evt) {
+    if (!_running)
+        return;
+    if (evt.ready)
+        _stdin_watcher->start();
+    else
+        _stdin_watcher->stop();
+}
+
+void InputActor::onStdinReadable(ev::io&, int) {
+    char chunk[4096];
+    std::size_t total = 0;
+    bool eof = false;
+
+    // Drain what is available, many lines per wakeup for piped input; the read
+    // budget keeps other actors of the core running, the watcher fires again.
+    // stdin stays in blocking mode (on a tty its file description is shared with
+    // stdout and stderr): a read is only issued when poll() reports data, so it
+    // returns without waiting.
+    while (total < MAX_READ_PER_WAKEUP) {
+        pollfd pfd{STDIN_FILENO, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, 0);
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready <= 0) {
+            eof = ready < 0;
+            break;
+        }
+        const ssize_t n = ::read(STDIN_FILENO, chunk, sizeof(chunk));
+        if (n > 0) {
+            _buffer.append(chunk, static_cast<std::size_t>(n));
+            total += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        eof = true;  // end of input, or a read error
+        break;
+    }
+
+    // Process every complete line, keep the remainder for the next wakeup
+    std::size_t begin = 0;
+    for (auto end = _buffer.find('\n'); end != std::string::npos; end = _buffer.find('\n', begin)) {
+        if (!processLine(_buffer.substr(begin, end - begin)))
+            return;
+        begin = end + 1;
+    }
+    _buffer.erase(0, begin);
+
+    // End of input (Ctrl-D or end of a piped file) behaves like 'quit'
+    if (eof) {
+        if (!_buffer.empty() && !processLine(std::move(_buffer)))
+            return;
+        quit();
+    }
+}
 
-    // Read user input non-blockingly
-    std::getline(std::cin, line);
+bool InputActor::processLine(std::string line) {
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
     
     // Handle quit command
     if (line == "quit") {
-        _running = false;
-        push<qb::KillEvent>(_client_id);  // Signal client to shutdown
-        push<qb::KillEvent>(id());        // Schedule own termination
-        return;
+        quit();
+        return false;
     }
 
     // Process non-empty input as chat message
@@ -57,4 +114,14 @@ void InputActor::onCallback() {
         auto& evt = push<ChatInputEvent>(_client_id);
         evt.message = std::move(line);
     }
-} 
\ No newline at end of file
+    return true;
+}
+
+void InputActor::quit() {
+    if (!_running)
+        return;
+    _running = false;
+    _stdin_watcher->stop();
+    push<qb::KillEvent>(_client_id);  // Signal client to shutdown
+    push<qb::KillEvent>(id());        // Schedule own termination
+}
@@ -4,20 +4,19 @@
  * @brief Actor responsible for handling user console input in a non-blocking manner.
  *
  * @details
- * This actor interfaces with the user via the console. It uses `qb::ICallback` to
- * periodically check for console input without blocking the actor's thread or the
- * QB engine's event loop. When input is detected, it's packaged into a
- * `ChatInputEvent` and sent to the `ClientActor` for processing and network transmission.
+ * This actor interfaces with the user via the console. Standard input is registered with
+ * the core's event loop through an `ev::io` watcher and only read when `poll()` reports data,
+ * so the actor only runs when input is ready and never blocks the other actors of its core.
+ * Each wakeup drains all available input and sends every complete line as a
+ * `ChatInputEvent` to the `ClientActor` for processing and network transmission.
  *
- * It demonstrates a common pattern for integrating blocking I/O (like `std::getline`
- * from `std::cin` in a naive way) into the QB actor model by using a non-blocking check
- * within a periodic callback.
+ * It demonstrates how to integrate a raw file descriptor into the QB actor model:
+ * messages can also be piped from a file (`client < messages.txt`) at full speed,
+ * and end of input behaves like "quit".
  *
  * QB Features Demonstrated:
  * - `qb::Actor`: Base class for concurrent entities.
- * - `qb::ICallback`: Interface for periodic execution within an actor's lifecycle.
- *   - `registerCallback(*this)`: To enable periodic calls to `onCallback()`.
- *   - `onCallback()`: Method called by the QB engine periodically.
+ * - `ev::io` watcher on `qb::io::async::listener::current.loop()`: Readiness-driven stdin reads.
  * - `qb::Event`: Base for `ChatInputEvent`.
  * - Inter-Actor Communication: `push<ChatInputEvent>(_client_id, ...)` to send user input to the `ClientActor`.
  * - Actor Lifecycle: Handles `qb::KillEvent` implicitly for shutdown (though explicit handling could be added).
@@ -26,7 +25,8 @@
 #pragma once
 
 #include <qb/actor.h>
-#include <qb/icallback.h>
+#include <qb/io/async.h>
+#include <memory>
 #include <string>
 #include "ClientActor.h"
 #include "../shared/Events.h"
@@ -35,7 +35,7 @@
  * @brief Actor managing user input and command processing
  * 
  * Architecture:
- * - Uses QB's callback system for non-blocking I/O
+ * - Watches stdin with the core's event loop for non-blocking I/O
  * - Maintains clean separation from network logic
  * - Implements command parsing and routing
  * - Handles graceful shutdown sequences
@@ -46,11 +46,15 @@
  * - Routes chat messages to ClientActor
  * - Manages application lifecycle
  */
-class InputActor : public qb::Actor,
-                  public qb::ICallback {
+class InputActor : public qb::Actor {
 private:
     qb::ActorId _client_id;    ///< Reference to network handler
     bool _running{true};        ///< Actor lifecycle control
+    std::unique_ptr<ev::io> _stdin_watcher; ///< Readiness watcher on stdin, stopped on destruction
+    std::string _buffer;        ///< Bytes read but not yet terminated by a newline
+
+    /// Bytes read from stdin per wakeup at most
+    static constexpr std::size_t MAX_READ_PER_WAKEUP = 64 * 1024;
 
 public:
     /**
@@ -64,32 +68,49 @@ public:
      * @brief Initializes input handling system
      * 
      * Setup sequence:
-     * 1. Registers callback handler
+     * 1. Creates the stdin watcher on the core's event loop
      * 2. Displays user instructions
-     * 3. Prepares input processing
+     * 
+     * Reading starts once the client reports it is ready.
      * 
      * @return true if initialization succeeds
      */
     bool onInit() override;
 
-    /// Ensures clean shutdown
-    ~InputActor() = default;
+    /**
+     * @brief Starts or stops reading stdin
+     * 
+     * Input is only read while the client can send it; otherwise it
+     * waits in the stdin pipe.
+     * 
+     * @param evt Readiness notification from the ClientActor
+     */
+    void on(const ClientReadyEvent& evt);
 
 private:
     /**
-     * @brief Processes user input non-blockingly
+     * @brief Drains stdin when the event loop reports it readable
+     * 
+     * Reads while poll() reports data, until the per-wakeup budget
+     * is used, then processes every complete line in the buffer. A partial line is kept for the next
+     * wakeup. End of input flushes the partial line and quits.
+     */
+    void onStdinReadable(ev::io& watcher, int revents);
+
+    /**
+     * @brief Processes one input line
      * 
      * Input handling:
-     * 1. Reads console input
+     * 1. Strips a trailing carriage return
      * 2. Processes commands:
      *    - 'quit': Initiates shutdown
      *    - Other: Routes as chat message
      * 3. Manages actor lifecycle
      * 
-     * Command flow:
-     * - Empty lines are ignored
-     * - 'quit' triggers clean shutdown
-     * - Other input creates ChatInputEvent
+     * @return false once the actor is shutting down
      */
-    void onCallback() override;
+    bool processLine(std::string line);
+
+    /// Stops reading and terminates the client and this actor
+    void quit();
 }; 
\ No newline at end of file
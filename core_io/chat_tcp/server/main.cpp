@@ -7,12 +7,12 @@
  * This file sets up and launches the server-side actor system for the TCP chat application.
  * It demonstrates a multi-core deployment strategy for different server components:
  * 1.  Initializes the `qb::Main` engine.
- * 2.  Creates the `ChatRoomActor` on a dedicated core (core 3). This actor manages the
+ * 2.  Creates the `ChatRoomActor` on a dedicated core (default core 3). This actor manages the
  *     central chat logic and state.
- * 3.  Creates a pool of `ServerActor`s on another dedicated core (core 1). These actors
+ * 3.  Creates a pool of `ServerActor`s on another dedicated core (default core 1). These actors
  *     are responsible for handling individual client connections and I/O, delegating
  *     application logic to the `ChatRoomActor`.
- * 4.  Creates multiple `AcceptActor`s on a third core (core 0). Each `AcceptActor` listens
+ * 4.  Creates multiple `AcceptActor`s on a third core (default core 0). Each `AcceptActor` listens
  *     on a different port (e.g., 3001 and 3002) and distributes incoming connections
  *     to the pool of `ServerActor`s in a round-robin fashion.
  * 5.  Starts the QB engine asynchronously (`engine.start(true)`).
@@ -24,11 +24,12 @@
  * - I/O and session management for individual clients are handled by `ServerActor`s.
  * - Core chat application logic and state are centralized in `ChatRoomActor`.
  * Distributing these across different cores can improve performance under load.
+ * The cores of the roles `chatroom`, `server` and `acceptor` can be changed without
+ * recompiling with `--placement FILE` or `--place role=spec` (`common/placement`).
  *
  * QB Features Demonstrated:
  * - `qb::Main`: The main engine for the actor system.
  * - `engine.addActor<ActorType>(core_id, args...)`: Creating actors and assigning them to specific CPU cores.
- * - `engine.core(core_id).builder()`: Fluent API for adding multiple actors to the same core.
  * - `qb::ActorIdList`: Used to pass the list of `ServerActor` IDs to `AcceptActor`s.
  * - Multi-Core Actor Deployment: Strategically placing actors on different cores.
  * - Asynchronous Engine Start: `engine.start(true)`.
@@ -40,6 +41,7 @@
 #include "AcceptActor.h"
 #include "ServerActor.h"
 #include "ChatRoomActor.h"
+#include <placement/Placement.h>
 #include <iostream>
 
 int main(int argc, char* argv[]) {
@@ -47,27 +49,33 @@ int main(int argc, char* argv[]) {
     qb::Main engine;
 
     try {
-        // Step 1: Create ChatRoomActor (Core 3)
+        // Core of each actor role, overridable with --placement FILE / --place role=spec
+        auto placement = placement::Placement::fromArgs({
+            {"chatroom", 1, "3"},
+            {"server", 2, "1"},
+            {"acceptor", 2, "0"},
+        }, argc, argv);
+        qb::io::cout() << placement.describe();
+
+        // Step 1: Create ChatRoomActor (default core 3)
         // - Central component for state management
         // - Placed on separate core to handle broadcasts
-        auto chatroom_id = engine.addActor<ChatRoomActor>(3);
+        auto chatroom_id = engine.addActor<ChatRoomActor>(placement.core("chatroom"));
 
-        // Step 2: Create ServerActors (Core 1)
+        // Step 2: Create ServerActors (default core 1)
         // - Multiple instances for connection handling
         // - Share chatroom_id for message routing
-        // - Builder pattern for multiple actors
-        auto server_ids = engine.core(1).builder()
-            .addActor<ServerActor>(chatroom_id)
-            .addActor<ServerActor>(chatroom_id)
-            .idList();
+        qb::ActorIdList server_ids;
+        for (auto core : placement.cores("server"))
+            server_ids.push_back(engine.addActor<ServerActor>(core, chatroom_id));
 
-        // Step 3: Create AcceptActors (Core 0)
+        // Step 3: Create AcceptActors (default core 0)
         // - Multiple listeners on different ports
         // - Share server_ids for connection distribution
         // - Demonstrate QB's URI-based configuration
-        engine.core(0).builder()
-            .addActor<AcceptActor>(qb::io::uri{"tcp://0.0.0.0:3001"}, server_ids)
-            .addActor<AcceptActor>(qb::io::uri{"tcp://0.0.0.0:3002"}, server_ids);
+        engine.addActor<AcceptActor>(placement.core("acceptor", 0), qb::io::uri{"tcp://0.0.0.0:3001"}, server_ids);
+        engine.addActor<AcceptActor>(placement.core("acceptor", 1), qb::io::uri{"tcp://0.0.0.0:3002"}, server_ids);
+        placement.pin(engine);
 
         // Step 4: Log system configuration
         // - Display actor IDs for debugging
@@ -20,6 +20,8 @@
  *   Contains the target session ID and the `chat::Message`.
  * - `DisconnectEvent`: Sent by a `ServerActor` (notified by a `ChatSession`) to the
  *   `ChatRoomActor` when a client disconnects. Contains the session ID of the disconnected client.
+ * - `ClientReadyEvent`: Sent by the client-side `ClientActor` to its `InputActor` when the
+ *   session becomes usable (authenticated) or is lost, so input is only consumed while it can be sent.
  * - `ChatInputEvent`: Sent by the client-side `InputActor` to its `ClientActor` when the
  *   user enters a line of text in the console. Contains the user's message.
  *
@@ -38,6 +40,7 @@
 #include <qb/io/tcp/socket.h>
 #include <qb/string.h>
 #include "Protocol.h"
+#include <audit/EventAudit.h>
 
 /**
  * @brief Event triggered when a new TCP connection is accepted
@@ -53,6 +56,7 @@
 struct NewSessionEvent : public qb::Event {
     qb::io::tcp::socket socket;  ///< Connected client socket with RAII management
 };
+QB_AUDIT_EVENT(NewSessionEvent, socket);
 
 /**
  * @brief Event for user authentication requests
@@ -72,6 +76,7 @@ struct AuthEvent : public qb::Event {
     qb::uuid session_id;        ///< Unique session identifier
     qb::string<32> username;    ///< Requested username (max 32 chars)
 };
+QB_AUDIT_EVENT(AuthEvent, session_id, username);
 
 /**
  * @brief Event for chat message distribution
@@ -91,6 +96,7 @@ struct ChatEvent : public qb::Event {
     qb::uuid session_id;          ///< Message sender's session ID
     qb::string<256> message;      ///< Message content (max 256 chars)
 };
+QB_AUDIT_EVENT(ChatEvent, session_id, message);
 
 /**
  * @brief Event for targeted message delivery
@@ -107,6 +113,7 @@ struct SendMessageEvent : public qb::Event {
     qb::uuid session_id;     ///< Target client's session ID
     chat::Message message;   ///< Protocol message to deliver
 };
+QB_AUDIT_EVENT(SendMessageEvent, session_id, message);
 
 /**
  * @brief Event for client disconnection handling
@@ -125,6 +132,7 @@ struct SendMessageEvent : public qb::Event {
 struct DisconnectEvent : public qb::Event {
     qb::uuid session_id;     ///< ID of the disconnected session
 };
+QB_AUDIT_HOT_EVENT(DisconnectEvent, audit::CACHE_LINE, session_id);
 
 /**
  * @brief Event for client-side user input handling
@@ -141,4 +149,22 @@ struct DisconnectEvent : public qb::Event {
  */
 struct ChatInputEvent : public qb::Event {
     qb::string<256> message;    ///< User input message (max 256 chars)
-}; 
\ No newline at end of file
+};
+QB_AUDIT_EVENT(ChatInputEvent, message);
+
+/**
+ * @brief Event for client-side flow control of user input
+ * 
+ * Flow:
+ * 1. ClientActor is authenticated by (or disconnected from) the server
+ * 2. ClientActor sends ClientReadyEvent to InputActor
+ * 3. InputActor starts (or stops) reading stdin
+ * 
+ * Input that arrives while the client is not ready stays in the
+ * stdin pipe instead of being read and discarded, so a scripted
+ * message file piped into the client is replayed in full.
+ */
+struct ClientReadyEvent : public qb::Event {
+    bool ready;    ///< true when chat messages can be sent to the server
+};
+QB_AUDIT_EVENT(ClientReadyEvent, ready);
@@ -0,0 +1,29 @@
+/**
+ * @file examples/core_io/file_monitor/hash.h
+ * @brief Content hash used by the file monitor to tell content changes from timestamp updates.
+ *
+ * @details
+ * A polynomial rolling hash (`h = h * 31 + byte`) over the whole file content, rendered
+ * as a decimal string. It is not collision resistant; it only has to change when the
+ * content changes. `FileProcessor::extractMetadata()` calls it on every created or
+ * modified file, and `benchmarks/bench_file_hash.cpp` measures it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Hashes a buffer
+ * @param data First byte of the content
+ * @param size Number of bytes
+ * @return The hash as a decimal string
+ */
+inline std::string contentHash(const char* data, std::size_t size) {
+    std::size_t hash = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = hash * 31 + static_cast<unsigned char>(data[i]);
+    }
+    return std::to_string(hash);
+}
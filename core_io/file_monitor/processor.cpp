@@ -22,7 +22,7 @@
  * - `processFileDeleted()`: Removes the file from the `_tracked_files` map.
  * - `shouldProcessFile()`: Contains logic to skip directories or hidden files based on configuration.
  * - `extractMetadata()`: Uses `std::filesystem` and `qb::io::system::file` to get path, size,
- *   last modification time, and a simple content hash of a file.
+ *   last modification time, and a simple content hash of a file (`contentHash()`, `hash.h`).
  * - `updateStats()`: Increments counters in the `_stats` object based on event type.
  *
  * QB Features Demonstrated (in context of this implementation):
@@ -33,6 +33,7 @@
  */
 
 #include "processor.h"
+#include "hash.h"
 #include <iostream>
 #include <functional>
 #include <cstring>
@@ -205,11 +206,7 @@ FileMetadata FileProcessor::extractMetadata(const std::string& path) {
         
         if (bytes_read >= 0) {
             // Calculate simple hash
-            size_t hash = 0;
-            for (char c : content) {
-                hash = hash * 31 + static_cast<unsigned char>(c);
-            }
-            metadata.content_hash = std::to_string(hash);
+            metadata.content_hash = contentHash(content.data(), content.size());
         }
     }
     
@@ -39,6 +39,7 @@
 #include <queue>
 #include <unordered_set>
 #include <atomic>
+#include <logging/Logger.h>
 #include "messages.h"
 
 namespace file_processor {
@@ -98,19 +99,19 @@ public:
             request.request_id = ++_request_counter;
         }
         
-        qb::io::cout() << "FileManager received a read request for "
-                  << request.filepath.c_str() << " (ID: " << request.request_id << ")" << std::endl;
+        QB_LOG_INFO("FileManager received a read request for {} (ID: {})",
+                    request.filepath.c_str(), request.request_id);
         
         // If a worker is available, assign the task
         if (!_available_workers.empty()) {
             qb::ActorId worker_id = *_available_workers.begin();
             _available_workers.erase(worker_id);
             
-            qb::io::cout() << "FileManager assigns the read task to worker " << worker_id << std::endl;
+            QB_LOG_DEBUG("FileManager assigns the read task to worker {}", worker_id);
             push<ReadFileRequest>(worker_id, request.filepath.c_str(), request.requestor, request.request_id);
         } else {
             // Otherwise, queue the request
-            qb::io::cout() << "FileManager queues the read request" << std::endl;
+            QB_LOG_DEBUG("FileManager queues the read request");
             _read_requests.push(request);
         }
     }
@@ -129,15 +130,15 @@ public:
             request.request_id = ++_request_counter;
         }
         
-        qb::io::cout() << "FileManager received a write request for "
-                  << request.filepath.c_str() << " (ID: " << request.request_id << ")" << std::endl;
+        QB_LOG_INFO("FileManager received a write request for {} (ID: {})",
+                    request.filepath.c_str(), request.request_id);
         
         // If a worker is available, assign the task
         if (!_available_workers.empty()) {
             qb::ActorId worker_id = *_available_workers.begin();
             _available_workers.erase(worker_id);
             
-            qb::io::cout() << "FileManager assigns the write task to worker " << worker_id << std::endl;
+            QB_LOG_DEBUG("FileManager assigns the write task to worker {}", worker_id);
             push<WriteFileRequest>(
                 worker_id, 
                 request.filepath.c_str(), 
@@ -147,7 +148,7 @@ public:
             );
         } else {
             // Otherwise, queue the request
-            qb::io::cout() << "FileManager queues the write request" << std::endl;
+            QB_LOG_DEBUG("FileManager queues the write request");
             _write_requests.push(request);
         }
     }
@@ -156,8 +157,8 @@ public:
      * @brief Handles notification from an available worker
      */
     void on(WorkerAvailable& msg) {
-        qb::io::cout() << "FileManager received an availability notification from worker "
-                  << msg.worker_id << std::endl;
+        QB_LOG_DEBUG("FileManager received an availability notification from worker {}",
+                    msg.worker_id);
         
         // Try to assign a task to the available worker
         if (!_read_requests.empty()) {
@@ -165,8 +166,7 @@ public:
             ReadFileRequest request = _read_requests.front();
             _read_requests.pop();
             
-            qb::io::cout() << "FileManager assigns a queued read task to worker "
-                      << msg.worker_id << std::endl;
+            QB_LOG_DEBUG("FileManager assigns a queued read task to worker {}", msg.worker_id);
                       
             push<ReadFileRequest>(
                 msg.worker_id,
@@ -179,8 +179,7 @@ public:
             WriteFileRequest request = _write_requests.front();
             _write_requests.pop();
             
-            qb::io::cout() << "FileManager assigns a queued write task to worker "
-                      << msg.worker_id << std::endl;
+            QB_LOG_DEBUG("FileManager assigns a queued write task to worker {}", msg.worker_id);
                       
             push<WriteFileRequest>(
                 msg.worker_id,
@@ -199,8 +198,8 @@ public:
      * @brief Forwards a read response
      */
     void on(ReadFileResponse& response) {
-        qb::io::cout() << "FileManager received a read response for "
-                  << response.filepath.c_str() << " (ID: " << response.request_id << ")" << std::endl;
+        QB_LOG_INFO("FileManager received a read response for {} (ID: {})",
+                    response.filepath.c_str(), response.request_id);
         
         // Forward the response to the requesting actor
         push<ReadFileResponse>(
@@ -217,8 +216,8 @@ public:
      * @brief Forwards a write response
      */
     void on(WriteFileResponse& response) {
-        qb::io::cout() << "FileManager received a write response for "
-                  << response.filepath.c_str() << " (ID: " << response.request_id << ")" << std::endl;
+        QB_LOG_INFO("FileManager received a write response for {} (ID: {})",
+                    response.filepath.c_str(), response.request_id);
         
         // Forward the response to the requesting actor
         push<WriteFileResponse>(
@@ -29,7 +29,9 @@
  * - Asynchronous Task Execution: Using `qb::io::async::callback` to perform blocking I/O
  *   operations without stalling the actor's event loop.
  * - `qb::io::system::file`: For performing synchronous file open, read, write, and close operations
- *   within the `qb::io::async::callback`.
+ *   within the `qb::io::async::callback`. The callback still runs on the worker's core, so a
+ *   large file blocks that core while it is read; both callbacks are watched by the stall
+ *   detector (`QB_WATCHDOG_SCOPE`, see `common/watchdog`).
  * - Inter-Actor Communication: Sending response events (`ReadFileResponse`, `WriteFileResponse`)
  *   and status events (`WorkerAvailable`) using `push<Event>(...)`.
  * - Managing Actor State: `_is_busy` flag.
@@ -45,6 +47,8 @@
 #include <chrono>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <logging/Logger.h>
+#include <watchdog/Watchdog.h>
 #include "messages.h"
 
 namespace file_processor {
@@ -90,14 +94,15 @@ public:
      */
     void on(ReadFileRequest& request) {
         _is_busy = true;
-        qb::io::cout() << "FileWorker " << id() << " processing read request: "
-                  << request.filepath.c_str() << std::endl;
+        QB_LOG_DEBUG("FileWorker {} processing read request: {}", id(), request.filepath.c_str());
         
         // Create a buffer to store the file content
         auto file_content = std::make_shared<std::vector<char>>();
         
         // Open the file asynchronously
         qb::io::async::callback([this, request, file_content]() {
+            // Synchronous read on this core's loop: reported if it exceeds the watchdog threshold
+            QB_WATCHDOG_SCOPE("readFile");
             qb::io::sys::file file;
             bool success = false;
             std::string error_msg;
@@ -155,11 +160,11 @@ public:
      */
     void on(WriteFileRequest& request) {
         _is_busy = true;
-        qb::io::cout() << "FileWorker " << id() << " processing write request: "
-                  << request.filepath.c_str() << std::endl;
+        QB_LOG_DEBUG("FileWorker {} processing write request: {}", id(), request.filepath.c_str());
         
         // Perform the write operation asynchronously
         qb::io::async::callback([this, request]() {
+            QB_WATCHDOG_SCOPE("writeFile");
             qb::io::sys::file file;
             bool success = false;
             size_t bytes_written = 0;
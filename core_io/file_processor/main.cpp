@@ -50,6 +50,8 @@
 #include <chrono>
 #include <filesystem>
 
+#include <logging/Logger.h>
+#include <watchdog/Watchdog.h>
 #include "file_manager.h"
 #include "file_worker.h"
 #include "messages.h"
@@ -228,11 +230,17 @@ int main(int argc, char** argv) {
         // Create the client on core 0
         auto client_id = engine.addActor<ClientActor>(0, manager_id, test_dir);
         
+        // Asynchronous logging (QB_LOG_FILE, QB_LOG_LEVEL) and blocking-call reports (QB_WATCHDOG_MS)
+        logging::Logger::instance().startFromEnv();
+        watchdog::Watchdog::instance().startFromEnv();
+        
         // Start the system
         engine.start();
         
         // Wait for all actors to terminate - qb::Main automatically handles signals
         engine.join();
+        watchdog::Watchdog::instance().stop();
+        logging::Logger::instance().stop();
         qb::io::cout() << "System shut down correctly" << std::endl;
         
     } catch (const std::exception& e) {
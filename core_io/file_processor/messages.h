@@ -35,6 +35,7 @@
 #include <qb/actor.h>
 #include <qb/event.h>
 #include <qb/string.h>
+#include <audit/EventAudit.h>
 #include <string>
 #include <vector>
 #include <memory>
@@ -52,6 +53,7 @@ struct ReadFileRequest : public qb::Event {
     ReadFileRequest(const char* path, qb::ActorId req_id, uint32_t id)
         : filepath(path), requestor(req_id), request_id(id) {}
 };
+QB_AUDIT_EVENT(ReadFileRequest, filepath, requestor, request_id);
 
 /**
  * @brief Response to a read request
@@ -67,6 +69,7 @@ struct ReadFileResponse : public qb::Event {
                     bool ok, const char* error, uint32_t id)
         : filepath(path), data(content), success(ok), error_msg(error), request_id(id) {}
 };
+QB_AUDIT_EVENT(ReadFileResponse, filepath, data, success, error_msg, request_id);
 
 /**
  * @brief File write request
@@ -81,6 +84,7 @@ struct WriteFileRequest : public qb::Event {
                     qb::ActorId req_id, uint32_t id)
         : filepath(path), data(content), requestor(req_id), request_id(id) {}
 };
+QB_AUDIT_EVENT(WriteFileRequest, filepath, data, requestor, request_id);
 
 /**
  * @brief Response to a write request
@@ -95,6 +99,7 @@ struct WriteFileResponse : public qb::Event {
     WriteFileResponse(const char* path, size_t bytes, bool ok, const char* error, uint32_t id)
         : filepath(path), bytes_written(bytes), success(ok), error_msg(error), request_id(id) {}
 };
+QB_AUDIT_EVENT(WriteFileResponse, filepath, bytes_written, success, error_msg, request_id);
 
 /**
  * @brief Worker availability message
@@ -104,5 +109,6 @@ struct WorkerAvailable : public qb::Event {
 
     explicit WorkerAvailable(qb::ActorId id) : worker_id(id) {}
 };
+QB_AUDIT_HOT_EVENT(WorkerAvailable, audit::CACHE_LINE, worker_id);
 
 } // namespace file_processor 
\ No newline at end of file
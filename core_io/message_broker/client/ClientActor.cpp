@@ -65,6 +65,7 @@ bool ClientActor::onInit() {
  * Message handling by type:
  * - RESPONSE: Command responses
  * - MESSAGE: Topic messages from subscriptions
+ * - GROUP_MESSAGE: Consumer group messages, acknowledged with ACK
  * - ERROR: Error notifications
  * 
  * All messages are displayed to the user with appropriate formatting.
@@ -80,6 +81,12 @@ void ClientActor::on(const broker::Message& msg) {
         case broker::MessageType::MESSAGE:
             qb::io::cout() << "Message: " << msg.payload << std::endl;
             break;
+
+        case broker::MessageType::GROUP_MESSAGE:
+            // Consumer group delivery: acknowledge once processed (here, displayed)
+            qb::io::cout() << "Group message: " << msg.payload << std::endl;
+            *this << broker::Message(broker::MessageType::ACK, "1");
+            break;
             
         case broker::MessageType::ERROR:
             qb::io::cerr() << "Error: " << msg.payload << std::endl;
@@ -104,6 +111,7 @@ void ClientActor::on(const broker::Message& msg) {
 void ClientActor::on(qb::io::async::event::disconnected const&) {
     qb::io::cout() << "Disconnected from server" << std::endl;
     _connected = false;
+    push<ClientReadyEvent>(_input_actor).ready = false;
     
     if (_should_reconnect) {
         // Schedule async reconnection with delay
@@ -159,6 +167,9 @@ void ClientActor::onConnected(qb::io::tcp::socket&& socket) {
     this->transport() = std::move(socket);
     this->template switch_protocol<Protocol>(*this);
     this->start();
+    
+    // Let the input actor start reading commands
+    push<ClientReadyEvent>(_input_actor).ready = true;
 }
 
 /**
@@ -189,7 +200,7 @@ void ClientActor::onConnectionFailed() {
  * 2. Creates protocol message
  * 3. Routes to server
  * 
- * @param topic Topic to subscribe to
+ * @param topic Topic to subscribe to, optionally followed by "<group> [strategy]"
  */
 void ClientActor::sendSubscribe(const std::string& topic) {
     if (!_connected) {
@@ -211,7 +222,7 @@ void ClientActor::sendSubscribe(const std::string& topic) {
  * 2. Creates protocol message
  * 3. Routes to server
  * 
- * @param topic Topic to unsubscribe from
+ * @param topic Topic to unsubscribe from, optionally followed by "<group>"
  */
 void ClientActor::sendUnsubscribe(const std::string& topic) {
     if (!_connected) {
@@ -281,8 +292,8 @@ void ClientActor::on(const BrokerInputEvent& evt) {
  * @brief Parses and handles user commands
  * 
  * Command format:
- * - SUB <topic> - Subscribe to a topic
- * - UNSUB <topic> - Unsubscribe from a topic
+ * - SUB <topic> [<group> [strategy]] - Subscribe to a topic, or join a consumer group
+ * - UNSUB <topic> [<group>] - Unsubscribe from a topic, or leave a consumer group
  * - PUB <topic> <message> - Publish to a topic
  * 
  * @param command The command string to process
@@ -303,16 +314,20 @@ void ClientActor::processCommand(const std::string& command) {
     // Handle command based on type
     if (cmd == "SUB" || cmd == "SUBSCRIBE") {
         if (!(iss >> topic)) {
-            qb::io::cerr() << "Missing topic. Format: SUB <topic>" << std::endl;
+            qb::io::cerr() << "Missing topic. Format: SUB <topic> [<group> [round_robin|least_outstanding|sticky]]" << std::endl;
             return;
         }
+        // Optional consumer group and strategy, sent as "topic group strategy"
+        for (std::string word; iss >> word;) topic += " " + word;
         sendSubscribe(topic);
     }
     else if (cmd == "UNSUB" || cmd == "UNSUBSCRIBE") {
         if (!(iss >> topic)) {
-            qb::io::cerr() << "Missing topic. Format: UNSUB <topic>" << std::endl;
+            qb::io::cerr() << "Missing topic. Format: UNSUB <topic> [<group>]" << std::endl;
             return;
         }
+        std::string group;
+        if (iss >> group) topic += " " + group;
         sendUnsubscribe(topic);
     }
     else if (cmd == "PUB" || cmd == "PUBLISH") {
@@ -99,6 +99,7 @@ public:
      * Handles various message types:
      * - RESPONSE: Command responses
      * - MESSAGE: Published messages from subscribed topics
+     * - GROUP_MESSAGE: Messages of a consumer group, acknowledged with ACK
      * - ERROR: Server-side error notifications
      * 
      * @param msg The received protocol message
@@ -134,7 +135,7 @@ public:
      * 2. Formats protocol message
      * 3. Handles delivery failures
      * 
-     * @param topic Topic to subscribe to
+     * @param topic Topic to subscribe to, optionally followed by "<group> [strategy]"
      */
     void sendSubscribe(const std::string& topic);
 
@@ -146,7 +147,7 @@ public:
      * 2. Formats protocol message
      * 3. Handles delivery failures
      * 
-     * @param topic Topic to unsubscribe from
+     * @param topic Topic to unsubscribe from, optionally followed by "<group>"
      */
     void sendUnsubscribe(const std::string& topic);
 
@@ -5,28 +5,36 @@
  *
  * @details
  * This file provides the `InputActor` implementation.
- * - `onInit()`: Registers the `qb::ICallback` and displays a welcome message and help info.
- * - `onCallback()`: Periodically called to read from `std::cin` using `std::getline`.
- *   Handles "quit" to shut down the client and itself (by sending `qb::KillEvent`).
+ * - `onInit()`: Creates an `ev::io` read watcher on stdin and
+ *   displays a welcome message and help info.
+ * - `onStdinReadable()`: Called by the event loop when stdin has data. Reads what is
+ *   available with `read()`, polling before each one (up to a 64 KiB budget), splits the buffer into lines and processes
+ *   each complete one; end of input is treated as "quit".
+ * - `processLine()`: Handles "quit" to shut down the client and itself (by sending `qb::KillEvent`).
  *   Handles "help" to redisplay command usage.
  *   Other non-empty input is sent as a `BrokerInputEvent` to the `ClientActor`.
  * - `displayHelp()`: Prints available commands and usage examples to the console.
  *
  * QB Features Demonstrated (in context of this implementation):
- * - `qb::ICallback` for periodic input polling.
+ * - `ev::io` watcher on the core's event loop for readiness-driven input.
  * - Sending events (`BrokerInputEvent`, `qb::KillEvent`).
  * - `qb::io::cout()` for console output.
  */
 
 #include "InputActor.h"
-#include <iostream>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
 
 InputActor::InputActor(qb::ActorId client_id)
     : _client_id(client_id) {}
 
 bool InputActor::onInit() {
-    // Register for non-blocking input handling
-    registerCallback(*this);
+    // Wake up only when stdin is readable, started once the client is ready
+    _stdin_watcher = std::make_unique<ev::io>(qb::io::async::listener::current.loop());
+    _stdin_watcher->set<InputActor, &InputActor::onStdinReadable>(this);
+    _stdin_watcher->set(STDIN_FILENO, ev::READ);
+    registerEvent<ClientReadyEvent>(*this);
     
     // Display initialization and usage information
     qb::io::cout() << "InputActor initialized with ID: " << id() << std::endl;
@@ -36,23 +44,76 @@ bool InputActor::onInit() {
     return true;
 }
 
-void InputActor::onCallback() {
-    std::string line;
+void InputActor::on(const ClientReadyEvent& evt) {
+    if (!_running)
+        return;
+    if (evt.ready)
+        _stdin_watcher->start();
+    else
+        _stdin_watcher->stop();
+}
+
+void InputActor::onStdinReadable(ev::io&, int) {
+    char chunk[4096];
+    std::size_t total = 0;
+    bool eof = false;
+
+    // Drain what is available, many lines per wakeup for piped input; the read
+    // budget keeps other actors of the core running, the watcher fires again.
+    // stdin stays in blocking mode (on a tty its file description is shared with
+    // stdout and stderr): a read is only issued when poll() reports data, so it
+    // returns without waiting.
+    while (total < MAX_READ_PER_WAKEUP) {
+        pollfd pfd{STDIN_FILENO, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, 0);
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready <= 0) {
+            eof = ready < 0;
+            break;
+        }
+        const ssize_t n = ::read(STDIN_FILENO, chunk, sizeof(chunk));
+        if (n > 0) {
+            _buffer.append(chunk, static_cast<std::size_t>(n));
+            total += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        eof = true;  // end of input, or a read error
+        break;
+    }
+
+    // Process every complete line, keep the remainder for the next wakeup
+    std::size_t begin = 0;
+    for (auto end = _buffer.find('\n'); end != std::string::npos; end = _buffer.find('\n', begin)) {
+        if (!processLine(_buffer.substr(begin, end - begin)))
+            return;
+        begin = end + 1;
+    }
+    _buffer.erase(0, begin);
+
+    // End of input (Ctrl-D or end of a piped file) behaves like 'quit'
+    if (eof) {
+        if (!_buffer.empty() && !processLine(std::move(_buffer)))
+            return;
+        quit();
+    }
+}
 
-    // Read user input non-blockingly
-    std::getline(std::cin, line);
+bool InputActor::processLine(std::string line) {
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
     
     // Handle special commands
     if (line == "quit") {
-        _running = false;
-        push<qb::KillEvent>(_client_id);  // Signal client to shutdown
-        push<qb::KillEvent>(id());        // Schedule own termination
-        return;
+        quit();
+        return false;
     }
     
     if (line == "help") {
         displayHelp();
-        return;
+        return true;
     }
 
     // Process non-empty input as broker command
@@ -60,12 +121,25 @@ void InputActor::onCallback() {
         auto& evt = push<BrokerInputEvent>(_client_id);
         evt.command = std::move(line);
     }
+    return true;
+}
+
+void InputActor::quit() {
+    if (!_running)
+        return;
+    _running = false;
+    _stdin_watcher->stop();
+    push<qb::KillEvent>(_client_id);  // Signal client to shutdown
+    push<qb::KillEvent>(id());        // Schedule own termination
 }
 
 void InputActor::displayHelp() {
     qb::io::cout() << "\nAvailable commands:" << std::endl;
     qb::io::cout() << "  SUB <topic>            - Subscribe to a topic" << std::endl;
     qb::io::cout() << "  UNSUB <topic>          - Unsubscribe from a topic" << std::endl;
+    qb::io::cout() << "  SUB <topic> <group> [round_robin|least_outstanding|sticky]" << std::endl;
+    qb::io::cout() << "                         - Join a consumer group: each message goes to one member" << std::endl;
+    qb::io::cout() << "  UNSUB <topic> <group>  - Leave a consumer group" << std::endl;
     qb::io::cout() << "  PUB <topic> <message>  - Publish a message to a topic" << std::endl;
     qb::io::cout() << "  help                   - Display this help message" << std::endl;
     qb::io::cout() << "  quit                   - Exit the client" << std::endl;
@@ -73,5 +147,6 @@ void InputActor::displayHelp() {
     qb::io::cout() << "  SUB news               - Subscribe to the 'news' topic" << std::endl;
     qb::io::cout() << "  PUB news Hello World   - Publish 'Hello World' to the 'news' topic" << std::endl;
     qb::io::cout() << "  UNSUB news             - Unsubscribe from the 'news' topic" << std::endl;
+    qb::io::cout() << "  SUB orders workers sticky - Share 'orders' with the 'workers' group, by key" << std::endl;
     qb::io::cout() << "\nEnter commands below:" << std::endl;
 } 
\ No newline at end of file
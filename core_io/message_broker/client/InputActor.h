@@ -5,15 +5,19 @@
  *
  * @details
  * This actor captures user commands from the console for interacting with the message broker.
- * It uses `qb::ICallback` for non-blocking input reading, periodically checking `std::cin`.
+ * Standard input is registered with the core's event loop through an `ev::io` watcher and
+ * only read when `poll()` reports data, without changing its flags: the actor only runs
+ * when input is ready, never stalls the other actors of its core, and drains every
+ * complete line available on each wakeup.
+ * Commands can therefore also be piped from a file (`client < commands.txt`) at full speed;
+ * end of input behaves like "quit".
  * Entered commands are packaged into `BrokerInputEvent`s and sent to the `ClientActor`
  * for parsing and network transmission.
  * Special commands like "quit" and "help" are handled locally.
  *
  * QB Features Demonstrated:
  * - `qb::Actor`: Base class.
- * - `qb::ICallback`: For periodic, non-blocking console input checks.
- *   - `registerCallback(*this)` and `onCallback()`.
+ * - `ev::io` watcher on `qb::io::async::listener::current.loop()`: Readiness-driven stdin reads.
  * - `qb::Event`: Base for `BrokerInputEvent`.
  * - Inter-Actor Communication: `push<BrokerInputEvent>(...)` to `ClientActor`.
  * - Local Command Handling: Processing "quit" and "help" directly.
@@ -22,7 +26,8 @@
 #pragma once
 
 #include <qb/actor.h>
-#include <qb/icallback.h>
+#include <qb/io/async.h>
+#include <memory>
 #include <string>
 #include "ClientActor.h"
 #include "../shared/Events.h"
@@ -31,7 +36,7 @@
  * @brief Actor managing user input and command processing
  * 
  * Architecture:
- * - Uses QB's callback system for non-blocking I/O
+ * - Watches stdin with the core's event loop for non-blocking I/O
  * - Maintains clean separation from network logic
  * - Implements command parsing and routing
  * - Handles graceful shutdown sequences
@@ -42,11 +47,15 @@
  * - Routes broker commands to ClientActor
  * - Manages application lifecycle
  */
-class InputActor : public qb::Actor,
-                  public qb::ICallback {
+class InputActor : public qb::Actor {
 private:
     qb::ActorId _client_id;    ///< Reference to network handler
     bool _running{true};        ///< Actor lifecycle control
+    std::unique_ptr<ev::io> _stdin_watcher; ///< Readiness watcher on stdin, stopped on destruction
+    std::string _buffer;        ///< Bytes read but not yet terminated by a newline
+
+    /// Bytes read from stdin per wakeup at most
+    static constexpr std::size_t MAX_READ_PER_WAKEUP = 64 * 1024;
 
 public:
     /**
@@ -60,35 +69,52 @@ public:
      * @brief Initializes input handling system
      * 
      * Setup sequence:
-     * 1. Registers callback handler
+     * 1. Creates the stdin watcher on the core's event loop
      * 2. Displays user instructions
-     * 3. Prepares input processing
+     * 
+     * Reading starts once the client reports it is ready.
      * 
      * @return true if initialization succeeds
      */
     bool onInit() override;
 
-    /// Ensures clean shutdown
-    ~InputActor() = default;
+    /**
+     * @brief Starts or stops reading stdin
+     * 
+     * Input is only read while the client can send it; otherwise it
+     * waits in the stdin pipe.
+     * 
+     * @param evt Readiness notification from the ClientActor
+     */
+    void on(const ClientReadyEvent& evt);
 
 private:
     /**
-     * @brief Processes user input non-blockingly
+     * @brief Drains stdin when the event loop reports it readable
+     * 
+     * Reads while poll() reports data, until the per-wakeup budget
+     * is used, then processes every complete line in the buffer. A partial line is kept for the next
+     * wakeup. End of input flushes the partial line and quits.
+     */
+    void onStdinReadable(ev::io& watcher, int revents);
+
+    /**
+     * @brief Processes one input line
      * 
      * Input handling:
-     * 1. Reads console input
+     * 1. Strips a trailing carriage return
      * 2. Processes commands:
      *    - 'quit': Initiates shutdown
      *    - 'help': Displays usage help
      *    - Other: Routes as broker command
      * 3. Manages actor lifecycle
      * 
-     * Command flow:
-     * - Empty lines are ignored
-     * - 'quit' triggers clean shutdown
-     * - Other input creates BrokerInputEvent
+     * @return false once the actor is shutting down
      */
-    void onCallback() override;
+    bool processLine(std::string line);
+
+    /// Stops reading and terminates the client and this actor
+    void quit();
     
     /**
      * @brief Displays help information
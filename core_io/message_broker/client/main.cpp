@@ -5,7 +5,8 @@
  *
  * @details
  * Sets up and launches the client-side actor system for the message broker.
- * 1.  Parses command-line arguments: server host and port.
+ * 1.  Parses command-line arguments: server host and port, or `--unix <path>` for a broker
+ *     listening on a Unix domain socket (`broker_server --unix <path>`).
  * 2.  Initializes the `qb::Main` engine.
  * 3.  Creates actors with core assignments:
  *     -   `InputActor` (core 0): Handles console input.
@@ -34,6 +35,7 @@
  * Command-line usage:
  * @code
  * broker_client <host> <port>
+ * broker_client --unix <path>
  * @endcode
  * 
  * Initialization flow:
@@ -52,6 +54,7 @@ int main(int argc, char* argv[]) {
     // Validate command-line arguments
     if (argc != 3) {
         qb::io::cerr() << "Usage: " << argv[0] << " <host> <port>" << std::endl;
+        qb::io::cerr() << "       " << argv[0] << " --unix <path>" << std::endl;
         return 1;
     }
 
@@ -59,8 +62,12 @@ int main(int argc, char* argv[]) {
         // Initialize QB engine
         qb::Main engine;
 
-        // Prepare server connection URI
-        qb::io::uri server_uri("tcp://" + std::string(argv[1]) + ":" + std::string(argv[2]));
+        // Prepare server connection URI (a broker started with --unix on the same host
+        // is reached through its Unix domain socket, without the TCP loopback stack)
+        const std::string first = argv[1];
+        qb::io::uri server_uri(first == "--unix"
+                                   ? "unix://" + std::string(argv[2])
+                                   : "tcp://" + first + ":" + std::string(argv[2]));
 
         // Create actor system with proper core distribution
         auto client_id = qb::ActorId();  // Placeholder for client ID
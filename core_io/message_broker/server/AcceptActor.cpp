@@ -36,9 +36,10 @@
  *    - Enables load distribution
  *    - Supports scaling
  */
-AcceptActor::AcceptActor(qb::io::uri listen_at, qb::ActorIdList pool)
+AcceptActor::AcceptActor(qb::io::uri listen_at, qb::ActorIdList pool, bool shared_memory)
     : _listen_at(std::move(listen_at))
-    , _server_pool(std::move(pool)) {}
+    , _server_pool(std::move(pool))
+    , _shared_memory(shared_memory) {}
 
 /**
  * Initialization demonstrating QB's acceptor setup:
@@ -99,6 +100,7 @@ void AcceptActor::on(accepted_socket_type&& new_io) {
     // Forward socket to selected server
     auto& evt = push<NewSessionEvent>(server_id);
     evt.socket = std::move(new_io);
+    evt.shared_memory = _shared_memory;
 }
 
 /**
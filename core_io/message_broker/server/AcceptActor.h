@@ -9,6 +9,10 @@
  * `chat_tcp` example. It listens on a network port and forwards new client sockets
  * to a pool of `ServerActor`s using a round-robin strategy.
  *
+ * The same actor serves the Unix domain socket of `--unix PATH` (URI `unix://PATH`), whose
+ * connections are ordinary `BrokerSession`s, and the socket of `--shm PATH`
+ * (`shared_memory`), whose connections become `ShmSession`s.
+ *
  * Inherits from `qb::Actor` and `qb::io::use<AcceptActor>::tcp::acceptor`.
  *
  * QB Features Demonstrated:
@@ -57,6 +61,7 @@ private:
     const qb::io::uri _listen_at;      // URI specifying the listening address and port
     const qb::ActorIdList _server_pool; // List of ServerActors for connection distribution
     std::size_t _session_counter{0};    // Counter for round-robin load balancing
+    const bool _shared_memory;          // Connections ask for a shared-memory channel
 
 public:
     /**
@@ -69,8 +74,9 @@ public:
      * 
      * @param listen_at URI specifying where to listen (e.g., "tcp://0.0.0.0:12345")
      * @param pool List of ServerActor IDs for connection distribution
+     * @param shared_memory true for the --shm socket
      */
-    AcceptActor(qb::io::uri listen_at, qb::ActorIdList pool);
+    AcceptActor(qb::io::uri listen_at, qb::ActorIdList pool, bool shared_memory = false);
     
     /**
      * @brief Initializes the accept actor
@@ -15,7 +15,17 @@
  *     It creates a `broker::MessageContainer` to manage the lifetime of the original message data,
  *     allowing the `string_view`s to be safely used when forwarding to `ServerActor::handlePublish`.
  *     This is a key zero-copy optimization technique.
+ *     A sampled publish starts its trace here (`tracing::Span` root, see `common/tracing`).
+ *   - `PEER_PUBLISH` (from a federated broker node) is parsed like `PUBLISH`; the message type
+ *     stays in the container, so `TopicManagerActor` knows not to forward it again.
+ *   - `ACK` (from a consumer group member) is passed to `ServerActor::handleAck()`.
+ *   - `PEER_HELLO` marks the session as a peer link: its timeout is disabled and the
+ *     `ServerActor` registers it with `TopicManagerActor`.
  *   - Updates session timeout on activity.
+ *   - Spends one publish credit per forwarded `PUBLISH`.
+ * - `AdmissionProtocol::getMessageSize()` / `admits()` / `grant()`: Admission control. A
+ *   `PUBLISH` frame that arrives without credit stays in the input buffer, and the session
+ *   is paused until the `TopicManagerActor` grants credits.
  * - `on(qb::io::async::event::disconnected const &)`: Notifies `ServerActor` of disconnection.
  * - `on(qb::io::async::event::timer const &)`: Handles session timeout by closing the connection.
  *
@@ -29,6 +39,8 @@
 
 #include "BrokerSession.h"
 #include "ServerActor.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 /**
@@ -39,7 +51,8 @@
  * 4. Logging helps with debugging and monitoring
  */
 BrokerSession::BrokerSession(ServerActor& server)
-    : client(server) {
+    : client(server)
+    , _resume(*this) {
     // Set up protocol handler and timeout
     this->template switch_protocol<Protocol>(*this);
     this->setTimeout(600);  // 120 second timeout
@@ -88,12 +101,44 @@ void BrokerSession::on(broker::Message msg) {
             this->server().handleUnsubscribe(this->id(), std::move(msg));
             break;
             
+        case broker::MessageType::ACK: {
+            // Consumer group member: number of GROUP_MESSAGEs processed (default 1)
+            const auto count = std::strtoul(msg.payload.c_str(), nullptr, 10);
+            this->server().handleAck(this->id(), count ? static_cast<uint32_t>(count) : 1);
+            break;
+        }
+
+        case broker::MessageType::PEER_HELLO:
+            // Another broker node: peer links stay open while idle
+            _is_peer = true;
+            this->setTimeout(0);
+            this->server().handlePeerHello(this->id(), msg.payload);
+            break;
+
+        case broker::MessageType::PEER_PUBLISH:
+            // Only a session that introduced itself as a broker node may forward publishes
+            if (!_is_peer) {
+                broker::Message error_msg;
+                error_msg.type = broker::MessageType::ERROR;
+                error_msg.payload = "PEER_PUBLISH requires PEER_HELLO";
+                *this << error_msg;
+                break;
+            }
+            [[fallthrough]];
         case broker::MessageType::PUBLISH: {
             // Parse the publish message (format: "topic message")
             std::string_view payload_view = msg.payload;
             size_t space_pos = payload_view.find(' ');
             
-            if (space_pos != std::string_view::npos) {
+            if (payload_view.size() > MAX_PUBLISH_PAYLOAD) {
+                broker::Message error_msg;
+                error_msg.type = broker::MessageType::ERROR;
+                error_msg.payload = "Publish larger than " + std::to_string(MAX_PUBLISH_PAYLOAD) + " bytes";
+                *this << error_msg;
+            } else if (space_pos != std::string_view::npos) {
+                // Root span of a sampled publish (no-op for requests that are not sampled)
+                tracing::Span span("BrokerSession.publish", tracing::Tracer::instance().sample());
+
                 // 1. Create a MessageContainer that takes ownership of the message
                 broker::MessageContainer container(std::move(msg));
                 
@@ -102,12 +147,15 @@ void BrokerSession::on(broker::Message msg) {
                 std::string_view topic = container_payload.substr(0, space_pos);
                 std::string_view content = container_payload.substr(space_pos + 1);
                 
-                // 3. Pass the container and views to the server
+                // 3. Pass the container and views to the server (PEER_PUBLISH is not credited)
+                if (container.type() == broker::MessageType::PUBLISH)
+                    --_credits;
                 this->server().handlePublish(
                     this->id(), 
                     std::move(container),
                     topic, 
-                    content
+                    content,
+                    span.propagate()
                 );
             } else {
                 // Send error if format is incorrect
@@ -159,4 +207,57 @@ void BrokerSession::on(qb::io::async::event::timer const &) {
     // Handle session timeout by disconnecting the client
     qb::io::cout() << "Broker client timed out" << std::endl;
     this->disconnect();
-} 
\ No newline at end of file
+} 
+
+/**
+ * Admission gate of the protocol:
+ * - Peeks the type of the frame at the start of the input buffer
+ * - Returns 0 ("incomplete") for a PUBLISH the session cannot forward
+ */
+std::size_t AdmissionProtocol::getMessageSize() noexcept {
+    auto& buffer = this->_io.in();
+    if (buffer.size() >= sizeof(broker::MessageHeader)) {
+        broker::MessageHeader header;
+        std::memcpy(&header, buffer.cbegin(), sizeof(header));
+        if (!this->_io.admits(static_cast<broker::MessageType>(header.type)))
+            return 0;
+    }
+    return broker::BrokerProtocol<BrokerSession>::getMessageSize();
+}
+
+/**
+ * Admission check:
+ * - Only PUBLISH needs a credit, and PEER_PUBLISH from a session that is not a peer
+ * - Without one, the session pauses and keeps the frame unparsed
+ */
+bool BrokerSession::admits(broker::MessageType type) {
+    const bool credited = type == broker::MessageType::PUBLISH ||
+                          (type == broker::MessageType::PEER_PUBLISH && !_is_peer);
+    if (!credited || _credits > 0)
+        return true;
+    _paused = true;
+    return false;
+}
+
+/**
+ * Credit grant:
+ * - Resumes a paused session
+ * - Parses the complete frames held in the input buffer, as QB does after a read
+ */
+void BrokerSession::grant(uint32_t credits) {
+    _credits += credits;
+    if (!_paused)
+        return;
+    _paused = false;
+    auto& buffer = this->in();
+    std::size_t size;
+    _resume.reset();
+    while ((size = _resume.getMessageSize()) > 0 && buffer.size() >= size) {
+        _resume.onMessage(size);
+        buffer.free_front(size);
+    }
+}
+
+bool BrokerSession::overHeldInput() {
+    return _paused && this->in().size() > MAX_HELD_INPUT;
+}
@@ -13,6 +13,12 @@
  *   for the incoming message to enable potential zero-copy forwarding of the payload.
  *   It delegates handling to the parent `ServerActor` (e.g., `handleSubscribe`, `handlePublish`).
  * - Handles disconnection and timeout events, notifying the `ServerActor`.
+ * - Admission control: the session spends one credit per `PUBLISH` it forwards. Without
+ *   credit, `AdmissionProtocol` leaves the next `PUBLISH` frame unparsed in the input
+ *   buffer, so nothing more reaches the `TopicManagerActor`, and `grant()` parses the held
+ *   frames when credits come back (`CreditEvent`). QB keeps reading the socket meanwhile:
+ *   a session holding more than `MAX_HELD_INPUT` is disconnected by its `ServerActor`.
+ *   Publishes larger than `MAX_PUBLISH_PAYLOAD` are refused.
  *
  * QB Features Demonstrated:
  * - `qb::io::use<BrokerSession>::tcp::client<ServerActor>`: Server-side client session.
@@ -28,8 +34,25 @@
 
 #include <qb/io/async.h>
 #include "../shared/Protocol.h"
+#include "../shared/Events.h"
 
 class ServerActor;
+class BrokerSession;
+
+/**
+ * @brief BrokerProtocol that holds back PUBLISH frames while the session has no credit
+ *
+ * The type of the next frame is read from the start of the input buffer, which is
+ * always the frame being parsed, so the check does not depend on the parser's state.
+ * Other message types (and PEER_PUBLISH of federated brokers) are never held.
+ */
+class AdmissionProtocol : public broker::BrokerProtocol<BrokerSession> {
+public:
+    explicit AdmissionProtocol(BrokerSession& io) noexcept
+        : broker::BrokerProtocol<BrokerSession>(io) {}
+
+    std::size_t getMessageSize() noexcept override;
+};
 
 /**
  * @brief Handles individual client connections in the broker server
@@ -66,7 +89,18 @@ public:
      * 2. Configure protocol handlers
      * 3. Route protocol events correctly
      */
-    using Protocol = broker::BrokerProtocol<BrokerSession>;
+    using Protocol = AdmissionProtocol;
+
+    /**
+     * @brief Input held while out of credit above which the ServerActor drops the session
+     *
+     * QB keeps reading the socket while the session is paused, so the held bytes grow
+     * for as long as the publisher keeps sending. The bound is one window of the largest
+     * publishes: a publisher that sends more than its window ahead of its credits is
+     * disconnected, not slowed down.
+     */
+    static constexpr std::size_t MAX_HELD_INPUT =
+        std::size_t(PUBLISH_WINDOW) * (sizeof(broker::MessageHeader) + MAX_PUBLISH_PAYLOAD);
     
     /**
      * @brief Constructs a new broker session
@@ -136,4 +170,31 @@ public:
      * @param timer The QB timer event
      */
     void on(qb::io::async::event::timer const &);
+
+    /**
+     * @brief Admission check of AdmissionProtocol
+     * @param type Type of the next frame
+     * @return false if it is a PUBLISH (or a PEER_PUBLISH from a session that is not a
+     *         peer) and the session has no credit; the session is then paused until grant()
+     */
+    bool admits(broker::MessageType type);
+
+    /**
+     * @brief Adds publish credits and parses the frames held while paused
+     *
+     * QB only parses input when new bytes arrive, and a paused publisher may have
+     * nothing left to send, so the held frames are parsed here.
+     *
+     * @param credits Credits granted by the TopicManagerActor
+     */
+    void grant(uint32_t credits);
+
+    /// true if paused and holding more than MAX_HELD_INPUT unparsed bytes
+    bool overHeldInput();
+
+private:
+    uint32_t _credits = PUBLISH_WINDOW;  ///< Publishes this session may still forward
+    bool _paused = false;                ///< A PUBLISH frame waits for credit
+    bool _is_peer = false;               ///< Sent PEER_HELLO: may forward PEER_PUBLISH, uncredited
+    AdmissionProtocol _resume;           ///< Parser of the frames held while paused
 }; 
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file examples/core_io/message_broker/server/PeerLinkActor.cpp
+ * @example Message Broker Server - Federation Peer Link Implementation
+ * @brief Implements `PeerLinkActor`, the outgoing link of a broker node to a peer node.
+ *
+ * @details
+ * - `connect()` / `onConnected()`: Asynchronous connection to the peer, followed by
+ *   `PEER_HELLO`.
+ * - `on(const broker::Message&)`: Turns `PEER_INTEREST` into a `PeerInterestEvent` for the
+ *   local `TopicManagerActor`.
+ * - `on(PeerPublishEvent&)`: Writes the shared `PEER_PUBLISH` message to the link.
+ * - `on(disconnected)`: Sends an empty filter to the `TopicManagerActor`, so it stops
+ *   forwarding to this link, and reconnects after `RECONNECT_DELAY`.
+ */
+
+#include "PeerLinkActor.h"
+#include <logging/Logger.h>
+#include <iostream>
+
+PeerLinkActor::PeerLinkActor(std::string node, qb::io::uri peer_uri, qb::ActorId topic_manager_id)
+    : _node(std::move(node))
+    , _peer_uri(std::move(peer_uri))
+    , _topic_manager_id(topic_manager_id) {}
+
+bool PeerLinkActor::onInit() {
+    registerEvent<PeerPublishEvent>(*this);
+    qb::io::cout() << "PeerLinkActor initialized with ID: " << id()
+                   << ", peer " << _peer_uri.source() << std::endl;
+    connect();
+    return true;
+}
+
+void PeerLinkActor::connect() {
+    qb::io::async::tcp::connect<qb::io::tcp::socket>(
+        _peer_uri,
+        [this](qb::io::tcp::socket socket) {
+            if (socket.is_open()) {
+                onConnected(std::move(socket));
+            } else {
+                scheduleReconnect();
+            }
+        },
+        CONNECT_TIMEOUT
+    );
+}
+
+void PeerLinkActor::onConnected(qb::io::tcp::socket&& socket) {
+    this->transport().close();
+    this->in().reset();
+    this->out().reset();
+    this->transport() = std::move(socket);
+    this->template switch_protocol<Protocol>(*this);
+    this->start();
+    _connected = true;
+
+    // The peer answers with its interest filter
+    *this << broker::Message(broker::MessageType::PEER_HELLO, _node);
+    QB_LOG_INFO("Peer link {} -> {} connected", _node, _peer_uri.source());
+}
+
+void PeerLinkActor::scheduleReconnect() {
+    qb::io::async::callback([this]() { connect(); }, RECONNECT_DELAY);
+}
+
+void PeerLinkActor::on(const broker::Message& msg) {
+    if (msg.type != broker::MessageType::PEER_INTEREST) {
+        QB_LOG_WARN("Peer link {}: unexpected message type {}", _peer_uri.source(),
+                    static_cast<int>(msg.type));
+        return;
+    }
+    auto& evt = push<PeerInterestEvent>(_topic_manager_id);
+    if (!evt.filter.parse(msg.payload))
+        QB_LOG_WARN("Peer link {}: invalid interest filter of {} bytes", _peer_uri.source(),
+                    msg.payload.size());
+}
+
+void PeerLinkActor::on(PeerPublishEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
+    tracing::Span span("PeerLinkActor.forward", evt.trace);
+    if (!_connected) {
+        // Filters are cleared on disconnection; these were already in flight
+        ++_dropped;
+        return;
+    }
+    *this << evt.message_data.message();
+    ++_forwarded;
+}
+
+void PeerLinkActor::on(qb::io::async::event::disconnected const&) {
+    _connected = false;
+    QB_LOG_INFO("Peer link {} -> {} down after {} forwarded publishes ({} dropped), reconnecting",
+                _node, _peer_uri.source(), _forwarded, _dropped);
+    // An empty filter stops forwarding until the peer sends its interest again
+    push<PeerInterestEvent>(_topic_manager_id);
+    scheduleReconnect();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file examples/core_io/message_broker/server/PeerLinkActor.h
+ * @example Message Broker Server - Federation Peer Link Actor
+ * @brief Defines `PeerLinkActor`, the outgoing TCP link of a broker node to another node.
+ *
+ * @details
+ * A broker started with `--peer host:port` creates one `PeerLinkActor` per peer. The actor
+ * connects to the peer's client port like a broker client, then:
+ * - Sends `PEER_HELLO` with the local node name. The peer's `BrokerSession` marks the
+ *   session as a peer link and its `TopicManagerActor` answers with its interest filter.
+ * - Receives `PEER_INTEREST` messages and passes the filter to the local
+ *   `TopicManagerActor` (`PeerInterestEvent`), which forwards a publish to this link only
+ *   if the peer may have subscribers for its topic.
+ * - Writes the `PeerPublishEvent`s it receives as `PEER_PUBLISH` messages. The peer
+ *   delivers them to its local subscribers and never forwards them again, so every
+ *   publish crosses each link at most once and a full mesh of nodes has no loops.
+ *
+ * A link carries publishes in one direction, from this node to the peer. Two nodes that
+ * exchange messages both list each other with `--peer`.
+ *
+ * On disconnection the actor clears the link's filter (nothing is forwarded to a link
+ * that is down) and reconnects after `RECONNECT_DELAY` seconds.
+ *
+ * QB Features Demonstrated:
+ * - `qb::io::use<PeerLinkActor>::tcp::client<>`: An actor that is also a TCP client.
+ * - `qb::io::async::tcp::connect` and `qb::io::async::callback` for (re)connection.
+ * - Reusing `BrokerProtocol` for broker-to-broker traffic.
+ */
+
+#pragma once
+
+#include <qb/actor.h>
+#include <qb/io/async.h>
+#include <qb/io/uri.h>
+#include "../shared/Protocol.h"
+#include "../shared/Events.h"
+#include <string>
+
+/**
+ * @brief Outgoing link to one peer broker node
+ */
+class PeerLinkActor : public qb::Actor,
+                      public qb::io::use<PeerLinkActor>::tcp::client<> {
+public:
+    using Protocol = broker::BrokerProtocol<PeerLinkActor>;
+
+private:
+    const std::string _node;            ///< Name of this node, sent in PEER_HELLO
+    const qb::io::uri _peer_uri;        ///< Client port of the peer node
+    const qb::ActorId _topic_manager_id;
+    bool _connected = false;
+    uint64_t _forwarded = 0;            ///< Publishes written to the link
+    uint64_t _dropped = 0;              ///< Publishes received while the link was down
+
+    /// Maximum time to wait for connection establishment
+    static constexpr double CONNECT_TIMEOUT = 5.0;
+    /// Delay between reconnection attempts
+    static constexpr double RECONNECT_DELAY = 1.0;
+
+public:
+    /**
+     * @param node Name of this node
+     * @param peer_uri Client port of the peer, e.g. `tcp://127.0.0.1:12346`
+     * @param topic_manager_id Local TopicManagerActor
+     */
+    PeerLinkActor(std::string node, qb::io::uri peer_uri, qb::ActorId topic_manager_id);
+
+    /**
+     * @brief Registers for PeerPublishEvent and starts connecting
+     * @return true
+     */
+    bool onInit() override;
+
+    /**
+     * @brief Handles the messages of the peer
+     *
+     * Only PEER_INTEREST is expected; it is passed on to the TopicManagerActor.
+     *
+     * @param msg Message parsed by BrokerProtocol
+     */
+    void on(const broker::Message& msg);
+
+    /**
+     * @brief Writes a forwarded publish to the link
+     * @param evt Publish selected by the TopicManagerActor for this link
+     */
+    void on(PeerPublishEvent& evt);
+
+    /**
+     * @brief Clears the link's interest and schedules a reconnection
+     */
+    void on(qb::io::async::event::disconnected const&);
+
+private:
+    void connect();
+    void onConnected(qb::io::tcp::socket&& socket);
+    void scheduleReconnect();
+};
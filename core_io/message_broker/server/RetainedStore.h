@@ -0,0 +1,118 @@
+/**
+ * @file examples/core_io/message_broker/server/RetainedStore.h
+ * @example Message Broker Server - Retained Last-Value Cache
+ * @brief Defines `RetainedStore`, the per-topic last-message cache of `TopicManagerActor`.
+ *
+ * @details
+ * With `--retain BYTES`, `TopicManagerActor` keeps the last message published on each topic
+ * and sends it to a client as soon as it subscribes, so subscribers of slow-changing topics
+ * (configuration, prices) get the current value without waiting for the next publish.
+ *
+ * - The store keeps the `broker::MessageContainer` that was broadcast to the subscribers,
+ *   so a retained message is the exact `MESSAGE` frame content, shared by reference with
+ *   the deliveries in flight. Sending it again does not format or copy the payload.
+ * - Memory is bounded by `capacity` bytes, counting the topic, the payload and a fixed
+ *   per-entry overhead. When a new message does not fit, the least recently used topics
+ *   (published or subscribed to the longest time ago) are evicted first.
+ * - A message larger than the whole capacity is not retained, and replaces nothing: the
+ *   topic's previous value is dropped, since it is no longer the last one.
+ *
+ * The store belongs to the `TopicManagerActor` and is only used from its core.
+ */
+
+#pragma once
+
+#include "../shared/Events.h"
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief LRU cache of the last message of each topic, bounded in bytes
+ */
+class RetainedStore {
+public:
+    /// Bookkeeping counted per entry on top of topic and payload (list and hash nodes)
+    static constexpr std::size_t ENTRY_OVERHEAD = 128;
+
+    /**
+     * @param capacity Maximum number of bytes retained; 0 disables retention
+     */
+    explicit RetainedStore(std::size_t capacity = 0) : _capacity(capacity) {}
+
+    bool enabled() const { return _capacity > 0; }
+
+    /**
+     * @brief Retains the last message of a topic, evicting the oldest topics if needed
+     * @param topic Topic of the message
+     * @param message Container shared with the deliveries of the publish
+     */
+    void put(const std::string& topic, const broker::MessageContainer& message) {
+        erase(topic);
+        const std::size_t bytes = cost(topic, message);
+        if (bytes > _capacity) {
+            ++_rejected;
+            return;
+        }
+        while (_bytes + bytes > _capacity)
+            evictOldest();
+        _entries.push_front(Entry{topic, message, bytes});
+        _index.emplace(_entries.front().topic, _entries.begin());
+        _bytes += bytes;
+    }
+
+    /**
+     * @brief Last message of a topic, marked as recently used
+     * @return The retained container, or nullptr if none
+     */
+    const broker::MessageContainer* get(const std::string& topic) {
+        auto it = _index.find(topic);
+        if (it == _index.end()) return nullptr;
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return &it->second->message;
+    }
+
+    /// Drops the retained message of a topic, if any
+    void erase(const std::string& topic) {
+        auto it = _index.find(topic);
+        if (it == _index.end()) return;
+        _bytes -= it->second->bytes;
+        auto entry = it->second;
+        _index.erase(it);
+        _entries.erase(entry);
+    }
+
+    std::size_t size() const { return _entries.size(); }
+    std::size_t bytes() const { return _bytes; }
+    std::size_t capacity() const { return _capacity; }
+    uint64_t evictions() const { return _evictions; }
+    uint64_t rejected() const { return _rejected; }
+
+private:
+    struct Entry {
+        std::string topic;
+        broker::MessageContainer message;
+        std::size_t bytes;
+    };
+
+    std::size_t _capacity;
+    std::size_t _bytes = 0;
+    uint64_t _evictions = 0;
+    uint64_t _rejected = 0;
+    std::list<Entry> _entries;  // Most recently used first
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> _index;  // Keys view Entry::topic
+
+    static std::size_t cost(const std::string& topic, const broker::MessageContainer& message) {
+        return topic.size() + message.payload().size() + ENTRY_OVERHEAD;
+    }
+
+    void evictOldest() {
+        auto& oldest = _entries.back();
+        _bytes -= oldest.bytes;
+        _index.erase(oldest.topic);
+        _entries.pop_back();
+        ++_evictions;
+    }
+};
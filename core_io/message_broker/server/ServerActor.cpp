@@ -16,7 +16,12 @@
  * - `on(SendMessageEvent&)`: When `TopicManagerActor` needs to send a message to a client, this handler
  *   finds the appropriate `BrokerSession` and uses its stream operator (`*it->second << evt.message()`) to send
  *   the message data (obtained via `evt.message()` from the `SendMessageEvent`'s `MessageContainer`).
- *   Updates the session timeout after sending.
+ *   Updates the session timeout after sending. Targets that are not socket sessions are
+ *   looked up among the `ShmSession`s.
+ * - `on(CreditEvent&)` / `sampleBacklog()`: Admission control. Credits go to the session;
+ *   the output backlog is sampled periodically and reported to `TopicManagerActor`.
+ * - `createShmSession()` / `onCallback()`: Shared-memory clients, accepted on the `--shm` socket,
+ *   get a `broker::shm::Channel`; their rings are polled once per core loop pass.
  *
  * QB Features Demonstrated (in context of this implementation):
  * - `qb::Actor` event handling.
@@ -24,12 +29,20 @@
  * - `push<Event>(...)` for inter-actor messaging.
  * - Efficient message forwarding using `std::move` for `MessageContainer` and `std::string_view`s
  *   in conjunction with `Events.h` definitions.
+ * - Asynchronous logging (`QB_LOG_*`, `common/logging`) on the per-message paths.
+ * - Sampled tracing (`tracing::Span`) of a publish and of each delivery to a subscriber.
+ * - Optional profiling (`QB_PROFILE_HANDLER`, `QB_PROFILE_SEND`) of handlers and of the
+ *   events exchanged with `TopicManagerActor`, enabled with `QB_EXAMPLES_PROFILE`.
  */
 
 #include "ServerActor.h"
 #include "BrokerSession.h"
 #include "../shared/Events.h"
+#include <logging/Logger.h>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 /**
  * Constructor showing QB actor initialization:
@@ -54,6 +67,8 @@ ServerActor::ServerActor(qb::ActorId topic_manager_id)
 bool ServerActor::onInit() {
     registerEvent<NewSessionEvent>(*this);
     registerEvent<SendMessageEvent>(*this);
+    registerEvent<CreditEvent>(*this);
+    sampleBacklog();
     qb::io::cout() << "ServerActor initialized with ID: " << id() << std::endl;
     return true;
 }
@@ -71,9 +86,14 @@ bool ServerActor::onInit() {
  *    - Enables monitoring
  */
 void ServerActor::on(NewSessionEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
+    if (evt.shared_memory) {
+        createShmSession(std::move(evt.socket));
+        return;
+    }
     // Create and register a new broker session for the incoming connection
     auto& session = registerSession(std::move(evt.socket));
-    qb::io::cout() << "New broker session registered: " << session.id() << std::endl;
+    QB_LOG_INFO("New broker session registered: {}", session.id());
 }
 
 /**
@@ -92,9 +112,10 @@ void ServerActor::handleSubscribe(qb::uuid session_id, broker::Message&& msg) {
     // Forward subscription request to TopicManagerActor with optimized message handling
     // The SubscribeEvent constructor handles the message ownership and string_view creation
     auto& evt = push<SubscribeEvent>(_topic_manager_id, session_id, std::move(msg));
+    QB_PROFILE_SEND(evt);
     
-    qb::io::cout() << "Forwarding subscription request for topic: " << evt.topic
-              << " from session: " << session_id << std::endl;
+    QB_LOG_DEBUG("Forwarding subscription request for topic: {} from session: {}",
+                evt.topic, session_id);
 }
 
 /**
@@ -113,9 +134,10 @@ void ServerActor::handleUnsubscribe(qb::uuid session_id, broker::Message&& msg)
     // Forward unsubscription request to TopicManagerActor with optimized message handling
     // The UnsubscribeEvent constructor handles the message ownership and string_view creation
     auto& evt = push<UnsubscribeEvent>(_topic_manager_id, session_id, std::move(msg));
+    QB_PROFILE_SEND(evt);
     
-    qb::io::cout() << "Forwarding unsubscription request for topic: " << evt.topic
-              << " from session: " << session_id << std::endl;
+    QB_LOG_DEBUG("Forwarding unsubscription request for topic: {} from session: {}",
+                evt.topic, session_id);
 }
 
 /**
@@ -131,13 +153,16 @@ void ServerActor::handleUnsubscribe(qb::uuid session_id, broker::Message&& msg)
  *    - Maintains message flow
  */
 void ServerActor::handlePublish(qb::uuid session_id, broker::MessageContainer&& container, 
-                                std::string_view topic, std::string_view content) {
+                                std::string_view topic, std::string_view content,
+                                const tracing::Context& trace) {
+    tracing::Span span("ServerActor.handlePublish", trace);
     // Forward publish message to TopicManagerActor for broadcasting
     // Using the PublishEvent constructor that takes a MessageContainer
     auto& evt = push<PublishEvent>(_topic_manager_id, session_id, std::move(container), topic, content);
+    QB_PROFILE_SEND(evt);
+    evt.trace = span.propagate();
     
-    qb::io::cout() << "Forwarding publish request to topic: " << evt.topic
-              << " from session: " << session_id << std::endl;
+    QB_LOG_DEBUG("Forwarding publish request to topic: {} from session: {}", evt.topic, session_id);
 }
 
 /**
@@ -156,8 +181,34 @@ void ServerActor::handleDisconnect(qb::uuid session_id) {
     // Notify TopicManagerActor about client disconnection
     auto& evt = push<DisconnectEvent>(_topic_manager_id);
     evt.session_id = session_id;
+    QB_PROFILE_SEND(evt);
     
-    qb::io::cout() << "Notifying topic manager about disconnected session: " << session_id << std::endl;
+    QB_LOG_DEBUG("Notifying topic manager about disconnected session: {}", session_id);
+}
+
+/**
+ * Acknowledgement handler for consumer groups:
+ * - Forwards the count to TopicManager
+ * - TopicManager uses it for least-outstanding selection
+ */
+void ServerActor::handleAck(qb::uuid session_id, uint32_t count) {
+    auto& evt = push<AckEvent>(_topic_manager_id);
+    evt.session_id = session_id;
+    evt.count = count;
+    QB_PROFILE_SEND(evt);
+}
+
+/**
+ * Peer link handler for federation:
+ * - Registers the session as a peer with TopicManager
+ * - TopicManager answers with the local interest filter
+ */
+void ServerActor::handlePeerHello(qb::uuid session_id, const std::string& node) {
+    auto& evt = push<PeerHelloEvent>(_topic_manager_id);
+    evt.session_id = session_id;
+    evt.node = node;
+    
+    QB_LOG_INFO("Peer node {} connected on session {}", node, session_id);
 }
 
 /**
@@ -173,11 +224,113 @@ void ServerActor::handleDisconnect(qb::uuid session_id) {
  *    - Maintains system stability
  */
 void ServerActor::on(SendMessageEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
+    tracing::Span span("ServerActor.deliver", evt.trace);
     // Send message to specific session if it exists
     auto it = sessions().find(evt.session_id);
     if (it != sessions().end()) {
         // Use the message accessor to get the properly owned message for sending
         *it->second << evt.message(); // Send message to session
         it->second->updateTimeout(); // Update session timeout to prevent disconnection
+        return;
+    }
+    auto shm_it = _shm_sessions.find(evt.session_id);
+    if (shm_it != _shm_sessions.end())
+        *shm_it->second << evt.message_data;  // Shared container, copied into the ring
+}
+
+/**
+ * Credit handler for admission control:
+ * - Finds the socket or shared-memory session
+ * - Adds the credits, resuming a paused session
+ */
+void ServerActor::on(CreditEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
+    auto it = sessions().find(evt.session_id);
+    if (it != sessions().end()) {
+        it->second->grant(evt.credits);
+        return;
+    }
+    auto shm_it = _shm_sessions.find(evt.session_id);
+    if (shm_it != _shm_sessions.end())
+        shm_it->second->grant(evt.credits);
+}
+
+/**
+ * Output backlog sampling, every BACKLOG_PERIOD:
+ * - Sums the bytes not yet written to the clients
+ * - Reports watermark crossings to TopicManager (hysteresis between LOW and HIGH)
+ * - Drops sessions holding too much input while out of credit
+ */
+void ServerActor::sampleBacklog() {
+    std::size_t pending = 0;
+    std::vector<qb::uuid> overflowing;
+    for (auto& [session_id, session] : sessions()) {
+        pending += session->out().size();
+        if (session->overHeldInput())
+            overflowing.push_back(session_id);
+    }
+    for (const auto& [session_id, session] : _shm_sessions)
+        pending += session->pendingBytes();
+
+    for (const auto& session_id : overflowing) {
+        auto it = sessions().find(session_id);
+        if (it == sessions().end()) continue;
+        QB_LOG_WARN("Session {} exceeded its held input while out of credit, disconnecting", session_id);
+        it->second->disconnect();
+    }
+
+    if (_congested ? pending < BACKLOG_LOW : pending > BACKLOG_HIGH) {
+        _congested = !_congested;
+        auto& evt = push<BacklogEvent>(_topic_manager_id);
+        evt.congested = _congested;
+        evt.bytes = pending;
+        QB_LOG_INFO("ServerActor {} output backlog {} ({} bytes)", id(),
+                    _congested ? "congested" : "drained", pending);
+    }
+    qb::io::async::callback([this]() { sampleBacklog(); }, BACKLOG_PERIOD);
+}
+
+/**
+ * Shared-memory session creation:
+ * - Creates the client's channel and sends it over the accepted Unix socket
+ * - Starts polling on the first shm session of this actor
+ */
+void ServerActor::createShmSession(qb::io::tcp::socket&& control) {
+    broker::shm::Channel channel;
+    if (!channel.create() || !broker::shm::sendChannel(control.native_handle(), channel)) {
+        QB_LOG_ERROR("Cannot set up a shared-memory channel: {}", std::strerror(errno));
+        return;
+    }
+    auto session = std::make_unique<ShmSession>(*this, std::move(control), std::move(channel));
+    const auto session_id = session->id();
+    if (_shm_sessions.empty())
+        registerCallback(*this);
+    _shm_sessions.emplace(session_id, std::move(session));
+    QB_LOG_INFO("New shared-memory session registered: {}", session_id);
+}
+
+/**
+ * Shared-memory polling:
+ * - Drains each session's ring into the usual handlers
+ * - Drops sessions whose rings are corrupt, and periodically those whose client exited
+ */
+void ServerActor::onCallback() {
+    const bool check_liveness = (++_shm_polls & (SHM_LIVENESS_PERIOD - 1)) == 0;
+    for (auto it = _shm_sessions.begin(); it != _shm_sessions.end();) {
+        auto& session = *it->second;
+        session.poll();
+        if (session.corrupt()) {
+            QB_LOG_WARN("Shared-memory session {} dropped: inconsistent ring indexes or frame", it->first);
+        } else if (!check_liveness || session.alive()) {
+            ++it;
+            continue;
+        } else {
+            QB_LOG_INFO("Shared-memory session {} closed", it->first);
+        }
+        handleDisconnect(it->first);
+        it = _shm_sessions.erase(it);
     }
+    if (_shm_sessions.empty())
+        unregisterCallback(*this);
 } 
\ No newline at end of file
@@ -16,8 +16,23 @@
  *   accepts a `broker::MessageContainer&&` and `std::string_view`s to enable zero-copy forwarding.
  * - `handleDisconnect()`: Called by `BrokerSession` upon client disconnection, forwards a
  *   `DisconnectEvent` to `TopicManagerActor`.
+ * - `handleAck()`: Called by `BrokerSession` when a consumer group member acknowledges messages,
+ *   forwards an `AckEvent` to `TopicManagerActor`.
+ * - `handlePeerHello()`: Called by `BrokerSession` when another broker node opens a peer link,
+ *   forwards a `PeerHelloEvent` to `TopicManagerActor`. The link's `PEER_PUBLISH` messages go
+ *   through `handlePublish()` like client publishes.
  * - `on(SendMessageEvent&)`: Receives messages from `TopicManagerActor` intended for a specific
  *   client, looks up the `BrokerSession`, and sends the message through it.
+ * - Admission control: `on(CreditEvent&)` passes the publish credits of `TopicManagerActor` to
+ *   the session. Every `BACKLOG_PERIOD` the actor sums the bytes its sessions still have to
+ *   write and reports crossing the watermarks (`BacklogEvent`), so that `TopicManagerActor`
+ *   stops granting credits while subscribers lag behind. Sessions paused with more than
+ *   `BrokerSession::MAX_HELD_INPUT` unparsed bytes (one window of the largest publishes)
+ *   are disconnected: QB keeps reading their socket, so they cannot be slowed down.
+ * - Shared-memory clients (`--shm`): a `NewSessionEvent` with `shared_memory` set creates a
+ *   `ShmSession`, whose ring is polled from `onCallback()` (`qb::ICallback`) while the actor
+ *   has at least one such session. Deliveries go to the `ShmSession` when the target is not
+ *   a TCP or Unix socket session.
  *
  * QB Features Demonstrated:
  * - `qb::Actor`.
@@ -35,6 +50,9 @@
 #include "../shared/Protocol.h"
 #include "../shared/Events.h"
 #include "BrokerSession.h"
+#include "ShmSession.h"
+#include <map>
+#include <memory>
 #include <string_view>
 
 /**
@@ -61,10 +79,27 @@
  *    - Shows how to handle async I/O in an actor system
  */
 class ServerActor : public qb::Actor,
+                    public qb::ICallback,
                     public qb::io::use<ServerActor>::tcp::io_handler<BrokerSession> {
 private:
     qb::ActorId _topic_manager_id;  // ID of the TopicManager actor for message routing
 
+    // Sessions of the shared-memory transport, polled from onCallback()
+    std::map<qb::uuid, std::unique_ptr<ShmSession>> _shm_sessions;
+    uint64_t _shm_polls = 0;
+
+    /// Polls between two checks of the shm clients' control sockets (power of two)
+    static constexpr uint64_t SHM_LIVENESS_PERIOD = 4096;
+
+    bool _congested = false;  // Last state reported to TopicManager (BacklogEvent)
+
+    /// Seconds between two samples of the output backlog
+    static constexpr double BACKLOG_PERIOD = 0.05;
+    /// Pending output bytes above which the actor reports congestion...
+    static constexpr std::size_t BACKLOG_HIGH = 8 * 1024 * 1024;
+    /// ...and below which it reports that the backlog drained
+    static constexpr std::size_t BACKLOG_LOW = 2 * 1024 * 1024;
+
 public:
     /**
      * @brief Constructs a new server actor
@@ -146,9 +181,11 @@ public:
      * @param container MessageContainer providing ownership of the message data
      * @param topic Topic to publish to (string_view into the container's payload)
      * @param content Message content (string_view into the container's payload)
+     * @param trace Trace context of the publish (empty if not sampled)
      */
     void handlePublish(qb::uuid session_id, broker::MessageContainer&& container, 
-                       std::string_view topic, std::string_view content);
+                       std::string_view topic, std::string_view content,
+                       const tracing::Context& trace = {});
 
     /**
      * @brief Handles session disconnections
@@ -162,6 +199,30 @@ public:
      * @param session_id ID of the disconnected session
      */
     void handleDisconnect(qb::uuid session_id);
+
+    /**
+     * @brief Handles acknowledgements from consumer group members
+     * 
+     * Called by BrokerSession when a client sends ACK. Forwards an AckEvent
+     * to TopicManagerActor, which tracks the messages each member has not
+     * processed yet.
+     * 
+     * @param session_id ID of the acknowledging session
+     * @param count Number of GROUP_MESSAGEs acknowledged
+     */
+    void handleAck(qb::uuid session_id, uint32_t count);
+
+    /**
+     * @brief Handles the hello of a peer broker node
+     * 
+     * Called by BrokerSession when the connected party is another broker
+     * (PEER_HELLO). Forwards a PeerHelloEvent to TopicManagerActor, which
+     * then sends the node's interest filter over this session.
+     * 
+     * @param session_id ID of the peer link's session
+     * @param node Name of the peer node
+     */
+    void handlePeerHello(qb::uuid session_id, const std::string& node);
     
     /**
      * @brief Handles message delivery requests from TopicManager
@@ -175,4 +236,26 @@ public:
      * @param evt Event containing the target session and message
      */
     void on(SendMessageEvent& evt);
+
+    /**
+     * @brief Passes publish credits to a session
+     * 
+     * A paused BrokerSession resumes parsing the PUBLISH frames it held.
+     * 
+     * @param evt Credits granted by TopicManager
+     */
+    void on(CreditEvent& evt);
+
+    /**
+     * @brief Polls the shared-memory sessions, once per core loop pass
+     *
+     * Registered while the actor has shm sessions. Reads their rings, writes their
+     * backlogs and, every SHM_LIVENESS_PERIOD passes, drops the sessions whose client
+     * exited (handleDisconnect()).
+     */
+    void onCallback() override;
+
+private:
+    void createShmSession(qb::io::tcp::socket&& control);
+    void sampleBacklog();
 }; 
\ No newline at end of file
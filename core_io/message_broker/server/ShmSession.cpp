@@ -0,0 +1,130 @@
+/**
+ * @file examples/core_io/message_broker/server/ShmSession.cpp
+ * @example Message Broker Server - Shared-Memory Client Session Implementation
+ * @brief Implements `ShmSession`, the server side of the shared-memory transport.
+ *
+ * @details
+ * - `poll()`: Reads up to `POLL_BATCH` frames from the client's ring and dispatches them
+ *   to the `ServerActor` handlers, then writes the backlog.
+ * - `on(broker::Message)`: Same routing as `BrokerSession::on(broker::Message)`, including
+ *   the `MessageContainer` and `string_view`s of a `PUBLISH` and its trace root span.
+ * - `operator<<`: Writes to the client's ring and wakes the client up if it sleeps.
+ * - `alive()`: Non-blocking peek on the control socket; 0 bytes means the client exited.
+ * - Admission control: a `PUBLISH` read without credit is held, and reading stops, until
+ *   `grant()`.
+ */
+
+#include "ShmSession.h"
+#include "ServerActor.h"
+#include <logging/Logger.h>
+#include <cerrno>
+#include <cstdlib>
+#include <sys/socket.h>
+
+ShmSession::ShmSession(ServerActor& server, qb::io::tcp::socket&& control,
+                       broker::shm::Channel&& channel)
+    : _server(server)
+    , _id(qb::generate_random_uuid())
+    , _control(std::move(control))
+    , _channel(std::move(channel)) {}
+
+bool ShmSession::poll() {
+    bool active = flush();
+    for (std::size_t i = 0; i < POLL_BATCH; ++i) {
+        if (!_held) {
+            broker::Message msg;
+            if (!_channel.toBroker().read(msg)) break;
+            _held = std::move(msg);
+        }
+        // Out of credit: keep the PUBLISH and leave the rest in the ring
+        if (_held->type == broker::MessageType::PUBLISH && !_credits) break;
+        on(std::move(*_held));
+        _held.reset();
+        active = true;
+    }
+    return active;
+}
+
+bool ShmSession::alive() {
+    char byte;
+    const auto n = ::recv(_control.native_handle(), &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n != 0 && !(n < 0 && errno != EAGAIN && errno != EWOULDBLOCK);
+}
+
+ShmSession& ShmSession::operator<<(const broker::MessageContainer& message) {
+    if (corrupt())
+        return *this;  // Dropped on the next poll
+    if (!_backlog.empty() ||
+        !_channel.toClient().write(message.type(), message.payload())) {
+        if (message.payload().size() > _channel.toClient().maxPayload()) {
+            QB_LOG_WARN("Shm session {}: dropped a message of {} bytes, larger than its ring",
+                        _id, message.payload().size());
+            return *this;
+        }
+        _backlog.push_back(message);
+        _backlog_bytes += message.payload().size();
+        return *this;
+    }
+    _channel.notifyClient();
+    return *this;
+}
+
+bool ShmSession::flush() {
+    bool written = false;
+    while (!_backlog.empty() &&
+           _channel.toClient().write(_backlog.front().type(), _backlog.front().payload())) {
+        _backlog_bytes -= _backlog.front().payload().size();
+        _backlog.pop_front();
+        written = true;
+    }
+    if (written) _channel.notifyClient();
+    return written;
+}
+
+void ShmSession::reply(broker::MessageType type, std::string payload) {
+    *this << broker::MessageContainer(type, std::move(payload));
+}
+
+void ShmSession::on(broker::Message msg) {
+    switch (msg.type) {
+        case broker::MessageType::SUBSCRIBE:
+            _server.handleSubscribe(_id, std::move(msg));
+            break;
+
+        case broker::MessageType::UNSUBSCRIBE:
+            _server.handleUnsubscribe(_id, std::move(msg));
+            break;
+
+        case broker::MessageType::ACK: {
+            const auto count = std::strtoul(msg.payload.c_str(), nullptr, 10);
+            _server.handleAck(_id, count ? static_cast<uint32_t>(count) : 1);
+            break;
+        }
+
+        case broker::MessageType::PUBLISH: {
+            std::string_view payload_view = msg.payload;
+            size_t space_pos = payload_view.find(' ');
+            if (space_pos == std::string_view::npos) {
+                reply(broker::MessageType::ERROR, "Invalid publish format. Use: PUB <topic> <message>");
+                break;
+            }
+            if (payload_view.size() > MAX_PUBLISH_PAYLOAD) {
+                reply(broker::MessageType::ERROR, "Publish larger than " + std::to_string(MAX_PUBLISH_PAYLOAD) + " bytes");
+                break;
+            }
+            --_credits;
+            tracing::Span span("ShmSession.publish", tracing::Tracer::instance().sample());
+            broker::MessageContainer container(std::move(msg));
+            std::string_view container_payload = container.payload();
+            _server.handlePublish(_id, std::move(container),
+                                  container_payload.substr(0, space_pos),
+                                  container_payload.substr(space_pos + 1),
+                                  span.propagate());
+            break;
+        }
+
+        default:
+            QB_LOG_WARN("Shm session {}: unexpected message type {}", _id, static_cast<int>(msg.type));
+            break;
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file examples/core_io/message_broker/server/ShmSession.h
+ * @example Message Broker Server - Shared-Memory Client Session
+ * @brief Defines `ShmSession`, the server side of a client using the shared-memory transport.
+ *
+ * @details
+ * A client that connects to the `--shm` socket gets a `broker::shm::Channel` (see
+ * `shared/ShmTransport.h`) instead of a `BrokerSession`. The `ServerActor` owning the
+ * session polls it from its core loop:
+ * - `poll()`: Reads the frames of the client's ring and passes them to the `ServerActor`
+ *   handlers, like `BrokerSession::on(broker::Message)` does (`SUBSCRIBE`, `UNSUBSCRIBE`,
+ *   `PUBLISH`, `ACK`; peer links use TCP). It then writes the frames that did not fit in
+ *   the client's ring earlier.
+ * - `operator<<`: Writes a message of `TopicManagerActor` to the client's ring. When the
+ *   ring is full the container is queued, without copying the payload, until the client
+ *   catches up; frames are never reordered.
+ * - `alive()`: Checks whether the client closed its control socket.
+ * - `corrupt()`: The client wrote inconsistent ring indexes or a malformed frame; the
+ *   `ServerActor` drops the session (the rings never read or write out of bounds).
+ * - `grant()`: Admission control, as for `BrokerSession`. Without credit, the session keeps
+ *   the `PUBLISH` it just read and stops reading its ring, so the ring fills up and the
+ *   client's `send()` waits.
+ */
+
+#pragma once
+
+#include <qb/io/async.h>
+#include <qb/uuid.h>
+#include "../shared/Protocol.h"
+#include "../shared/Events.h"
+#include "../shared/ShmTransport.h"
+#include <deque>
+#include <optional>
+
+class ServerActor;
+
+/**
+ * @brief Session of a client connected through a shared-memory channel
+ */
+class ShmSession {
+private:
+    ServerActor& _server;
+    const qb::uuid _id;
+    qb::io::tcp::socket _control;                 ///< Unix socket, kept to detect the client's exit
+    broker::shm::Channel _channel;
+    std::deque<broker::MessageContainer> _backlog; ///< Frames waiting for room in the client's ring
+    std::size_t _backlog_bytes = 0;
+    uint32_t _credits = PUBLISH_WINDOW;           ///< Publishes this session may still forward
+    std::optional<broker::Message> _held;         ///< PUBLISH read without credit
+
+    /// Frames read from the client's ring per poll, so one client cannot starve the others
+    static constexpr std::size_t POLL_BATCH = 64;
+
+public:
+    /**
+     * @param server ServerActor owning the session
+     * @param control Accepted Unix socket the channel was sent over
+     * @param channel Channel created for the client
+     */
+    ShmSession(ServerActor& server, qb::io::tcp::socket&& control, broker::shm::Channel&& channel);
+
+    qb::uuid id() const { return _id; }
+
+    /**
+     * @brief Processes the client's pending frames and flushes the backlog
+     * @return true if anything was read or written
+     */
+    bool poll();
+
+    /**
+     * @brief false once the client has closed its control socket
+     */
+    bool alive();
+
+    /// true once either ring holds indexes or frames that cannot be trusted
+    bool corrupt() const { return _channel.toBroker().corrupt() || _channel.toClient().corrupt(); }
+
+    /**
+     * @brief Writes a message to the client, or queues it if the ring is full
+     * @param message Container shared with the other deliveries
+     */
+    ShmSession& operator<<(const broker::MessageContainer& message);
+
+    /// Adds publish credits; the held PUBLISH goes out on the next poll()
+    void grant(uint32_t credits) { _credits += credits; }
+
+    /// Payload bytes waiting for room in the client's ring
+    std::size_t pendingBytes() const { return _backlog_bytes; }
+
+private:
+    void on(broker::Message msg);
+    bool flush();
+    void reply(broker::MessageType type, std::string payload);
+};
@@ -21,6 +21,12 @@
  *   This demonstrates efficient broadcasting by sharing message data via `MessageContainer`'s
  *   `std::shared_ptr` semantics, avoiding multiple copies of the payload.
  * - `on(DisconnectEvent&)`: Cleans up all subscriptions associated with the disconnected session ID.
+ * - Consumer groups: `joinGroup()` / `leaveGroup()` on a `SUBSCRIBE` / `UNSUBSCRIBE` whose payload
+ *   names a group, `selectMember()` for each publish, `on(AckEvent&)` for the outstanding counts.
+ *   Members receive `GROUP_MESSAGE`s, one shared container per publish for all groups.
+ * - `on(PeerHelloEvent&)`, `on(PeerInterestEvent&)`, `forwardToPeers()`, `refreshInterest()`:
+ *   Federation with other broker nodes. Interest filters are exchanged only when the set of
+ *   subscribed topics changes, and a publish is forwarded once per matching link.
  * - `sendToSession()` (two overloads): Helper methods to `push` a `SendMessageEvent` to the appropriate
  *   `ServerActor`. One overload takes message type and payload string, creating a new `MessageContainer`.
  *   The other takes a `const broker::MessageContainer&`, allowing shared message data to be passed.
@@ -31,11 +37,41 @@
  * - Efficient broadcasting using `broker::MessageContainer` to share message data among multiple `SendMessageEvent`s.
  * - Use of `std::string_view` to refer to parts of message payloads without copying.
  * - Complex state management (`_sessions`, `_subscriptions`, `_session_topics`).
- * - `qb::io::cout`: Thread-safe console output.
+ * - `qb::io::cout`: Thread-safe console output (start-up only).
+ * - `QB_LOG_*` (`common/logging`): asynchronous logging for the per-request messages, so logging
+ *   a broadcast costs a ring write instead of a locked, flushed console write.
+ *
+ * A sampled publish is traced with one `tracing::Span` for the fan-out and one flow per
+ * subscriber delivery (`span.propagate()`).
+ *
+ * Handlers and outgoing `SendMessageEvent`s are instrumented with `QB_PROFILE_HANDLER` and
+ * `QB_PROFILE_SEND`; both compile to nothing unless `QB_EXAMPLES_PROFILE` is enabled.
  */
 
 #include "TopicManagerActor.h"
+#include <logging/Logger.h>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace {
+
+/// Final mix of splitmix64: spreads the rendezvous weights of close inputs
+uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/// First word of a text, or the whole text
+std::string_view firstWord(std::string_view text) {
+    return text.substr(0, text.find(' '));
+}
+
+} // namespace
 
 /**
  * @brief Initializes the topic manager actor and registers event handlers
@@ -52,6 +88,11 @@ bool TopicManagerActor::onInit() {
     registerEvent<UnsubscribeEvent>(*this);
     registerEvent<PublishEvent>(*this);
     registerEvent<DisconnectEvent>(*this);
+    registerEvent<AckEvent>(*this);
+    registerEvent<PeerHelloEvent>(*this);
+    registerEvent<PeerInterestEvent>(*this);
+    registerEvent<BacklogEvent>(*this);
+    registerCallback(*this);
     qb::io::cout() << "TopicManagerActor initialized with ID: " << id() << std::endl;
     return true;
 }
@@ -70,6 +111,7 @@ bool TopicManagerActor::onInit() {
  * @param evt The subscription event containing session and topic details
  */
 void TopicManagerActor::on(SubscribeEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
     auto session_id = evt.session_id;
     auto topic_view = evt.topic;
     auto server_id = evt.getSource();
@@ -82,15 +124,32 @@ void TopicManagerActor::on(SubscribeEvent& evt) {
         _sessions[session_id] = SessionInfo{server_id};
     }
 
+    // "topic group [strategy]" joins a consumer group instead
+    const auto space = topic_view.find(' ');
+    if (space != std::string_view::npos) {
+        joinGroup(session_id, server_id, std::string(topic_view.substr(0, space)),
+                  topic_view.substr(space + 1));
+        return;
+    }
+
     // Add session to topic subscribers
-    _subscriptions[topic_str].insert(session_id);
+    auto& subscribers = _subscriptions[topic_str];
+    const bool new_topic = subscribers.empty();
+    subscribers.insert(session_id);
     
     // Add topic to session's subscriptions
     _session_topics[session_id].insert(topic_str);
 
+    // First subscriber: peers may now have to forward this topic
+    if (new_topic) refreshInterest();
+
     // Send confirmation
-    qb::io::cout() << "Client " << session_id << " subscribed to topic: " << topic_str << std::endl;
+    QB_LOG_INFO("Client {} subscribed to topic: {}", session_id, topic_str);
     sendResponse(session_id, server_id, "Subscribed to topic: " + topic_str);
+
+    // Bootstrap with the topic's last message, shared with its original deliveries
+    if (const auto* retained = _retained.get(topic_str))
+        sendToSession(session_id, server_id, *retained);
 }
 
 /**
@@ -107,6 +166,7 @@ void TopicManagerActor::on(SubscribeEvent& evt) {
  * @param evt The unsubscription event containing session and topic details
  */
 void TopicManagerActor::on(UnsubscribeEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
     auto session_id = evt.session_id;
     auto topic_view = evt.topic;
     auto server_id = evt.getSource();
@@ -120,6 +180,20 @@ void TopicManagerActor::on(UnsubscribeEvent& evt) {
         return;
     }
 
+    // "topic group" leaves a consumer group
+    const auto space = topic_view.find(' ');
+    if (space != std::string_view::npos) {
+        std::string topic(topic_view.substr(0, space));
+        std::string group(firstWord(topic_view.substr(space + 1)));
+        if (!leaveGroup(session_id, topic, group)) {
+            sendError(session_id, server_id, "Not a member of group " + group + " on topic: " + topic);
+            return;
+        }
+        QB_LOG_INFO("Client {} left group {} on topic: {}", session_id, group, topic);
+        sendResponse(session_id, server_id, "Left group " + group + " on topic: " + topic);
+        return;
+    }
+
     // Check if topic exists and session is subscribed
     auto topic_it = _subscriptions.find(topic_str);
     if (topic_it == _subscriptions.end() || 
@@ -137,10 +211,11 @@ void TopicManagerActor::on(UnsubscribeEvent& evt) {
     // Clean up empty topics
     if (topic_it->second.empty()) {
         _subscriptions.erase(topic_it);
+        refreshInterest();
     }
 
     // Send confirmation
-    qb::io::cout() << "Client " << session_id << " unsubscribed from topic: " << topic_str << std::endl;
+    QB_LOG_INFO("Client {} unsubscribed from topic: {}", session_id, topic_str);
     sendResponse(session_id, server_id, "Unsubscribed from topic: " + topic_str);
 }
 
@@ -158,6 +233,8 @@ void TopicManagerActor::on(UnsubscribeEvent& evt) {
  * @param evt The publish event containing the message
  */
 void TopicManagerActor::on(PublishEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
+    tracing::Span span("TopicManagerActor.publish", evt.trace);
     auto session_id = evt.session_id;
     auto topic_view = evt.topic;
     auto content_view = evt.content;
@@ -166,25 +243,60 @@ void TopicManagerActor::on(PublishEvent& evt) {
     // Convert string_view to std::string only when needed for storage/lookup
     std::string topic_str(topic_view);
 
-    // Check if topic has subscribers
+    // A publish forwarded by a peer is for local subscribers only: forwarding it
+    // again would loop in a mesh of nodes
+    const bool from_peer = evt.message_data.type() == broker::MessageType::PEER_PUBLISH;
+    if (!from_peer) consumeCredit(session_id, server_id);
+    std::size_t forwarded = 0;
+    if (!from_peer && !_peer_links.empty())
+        forwarded = forwardToPeers(topic_view, evt.message_data, span.propagate());
+
+    // Check if topic has subscribers or consumer groups
     auto topic_it = _subscriptions.find(topic_str);
-    if (topic_it == _subscriptions.end() || topic_it->second.empty()) {
-        // No subscribers, just acknowledge
-        sendResponse(session_id, server_id, "Message published to topic with no subscribers: " + topic_str);
+    auto groups_it = _groups.find(topic_str);
+    const bool has_subscribers = topic_it != _subscriptions.end() && !topic_it->second.empty();
+    if (!has_subscribers && groups_it == _groups.end() && !_retained.enabled()) {
+        // No subscribers anywhere, just acknowledge (peers get no response)
+        if (!from_peer && !forwarded)
+            sendResponse(session_id, server_id, "Message published to topic with no subscribers: " + topic_str);
         return;
     }
 
     // Format message for delivery - convert to string only for storage/broadcasting
     std::string formatted_message = topic_str + ": " + std::string(content_view);
+
+    // Consumer groups: one member per group, all groups sharing one container
+    if (groups_it != _groups.end()) {
+        broker::MessageContainer group_message(broker::MessageType::GROUP_MESSAGE, formatted_message);
+        const auto key = firstWord(content_view);
+        for (auto& [name, group] : groups_it->second) {
+            const auto& member_id = group.members[selectMember(group, key)];
+            auto member_it = _sessions.find(member_id);
+            if (member_it == _sessions.end()) continue;
+            ++member_it->second.outstanding;
+            sendToSession(member_id, member_it->second.server_id, group_message, span.propagate());
+        }
+    }
+    if (!has_subscribers && !_retained.enabled()) return;
     
     // Create a SINGLE shared message container that will be used by all subscribers
     // This is the key optimization - creating one shared message that will be
     // referenced by all subscriber events
     broker::MessageContainer shared_message(broker::MessageType::MESSAGE, formatted_message);
+
+    // Retained mode: the same container becomes the topic's last value
+    if (_retained.enabled()) {
+        _retained.put(topic_str, shared_message);
+        if (!has_subscribers) {
+            if (!from_peer && !forwarded && groups_it == _groups.end())
+                sendResponse(session_id, server_id, "Message retained for topic with no subscribers: " + topic_str);
+            return;
+        }
+    }
     
     // Broadcast to all subscribers
-    qb::io::cout() << "Broadcasting message to topic " << topic_str << " with "
-              << topic_it->second.size() << " subscribers" << std::endl;
+    QB_LOG_DEBUG("Broadcasting message to topic {} with {} subscribers",
+                topic_str, topic_it->second.size());
     
     for (const auto& subscriber_id : topic_it->second) {
         // Broadcast to all subscribers, including the publisher if they're subscribed
@@ -192,7 +304,8 @@ void TopicManagerActor::on(PublishEvent& evt) {
         if (subscriber_it != _sessions.end()) {
             // Send the message using the shared container
             // Each event will reference the same underlying message data
-            sendToSession(subscriber_id, subscriber_it->second.server_id, shared_message);
+            sendToSession(subscriber_id, subscriber_it->second.server_id, shared_message,
+                          span.propagate());
         }
     }
 
@@ -210,7 +323,18 @@ void TopicManagerActor::on(PublishEvent& evt) {
  * @param evt The disconnect event for the session
  */
 void TopicManagerActor::on(DisconnectEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
     auto session_id = evt.session_id;
+
+    // Incoming peer links never subscribe
+    if (_peer_sessions.erase(session_id)) {
+        QB_LOG_INFO("Peer session {} disconnected", session_id);
+        return;
+    }
+
+    // Credits die with the session
+    if (_publishers.erase(session_id))
+        _deferred.erase(session_id);
     
     // Check if session exists
     auto session_it = _sessions.find(session_id);
@@ -218,6 +342,7 @@ void TopicManagerActor::on(DisconnectEvent& evt) {
 
     // Get all topics the session was subscribed to
     auto topics_it = _session_topics.find(session_id);
+    bool removed_topic = false;
     if (topics_it != _session_topics.end()) {
         // Remove session from each topic's subscribers
         for (const auto& topic : topics_it->second) {
@@ -227,17 +352,320 @@ void TopicManagerActor::on(DisconnectEvent& evt) {
             // Remove topic if empty
             if (subscribers.empty()) {
                 _subscriptions.erase(topic);
+                removed_topic = true;
             }
         }
         
         // Clean up session's topics
         _session_topics.erase(topics_it);
     }
+
+    // Leave every consumer group (a copy: leaveGroup() updates _session_groups)
+    auto groups_it = _session_groups.find(session_id);
+    if (groups_it != _session_groups.end()) {
+        const auto memberships = groups_it->second;
+        for (const auto& [topic, group] : memberships)
+            leaveGroup(session_id, topic, group);
+    }
     
     // Remove session info
     _sessions.erase(session_it);
+    if (removed_topic) refreshInterest();
     
-    qb::io::cout() << "Client " << session_id << " disconnected and removed from all topics" << std::endl;
+    QB_LOG_INFO("Client {} disconnected and removed from all topics", session_id);
+}
+
+/**
+ * @brief Lowers the outstanding count of a group member
+ * 
+ * @param evt The acknowledgement of the session
+ */
+void TopicManagerActor::on(AckEvent& evt) {
+    QB_PROFILE_HANDLER(evt);
+    auto session_it = _sessions.find(evt.session_id);
+    if (session_it == _sessions.end()) return;
+    auto& outstanding = session_it->second.outstanding;
+    outstanding -= std::min<uint64_t>(outstanding, evt.count);
+}
+
+/**
+ * @brief Tracks the output backlog of the ServerActors
+ * 
+ * @param evt Watermark crossing reported by a ServerActor
+ */
+void TopicManagerActor::on(BacklogEvent& evt) {
+    if (evt.congested) {
+        _congested_servers.insert(evt.getSource());
+        QB_LOG_WARN("ServerActor {} congested ({} bytes pending), holding back publish credits",
+                    evt.getSource(), evt.bytes);
+        return;
+    }
+    _congested_servers.erase(evt.getSource());  // Held-back credits go out from the next loop passes
+}
+
+/**
+ * @brief Queue depth sampling
+ * 
+ * Hysteresis between QUEUE_LOW and QUEUE_HIGH, so that the state does not
+ * flip on every loop pass. A pass without publishes always ends congestion,
+ * which guarantees that held-back credits are eventually granted. While not
+ * overloaded, each pass releases one round of held-back credits.
+ */
+void TopicManagerActor::onCallback() {
+    const uint32_t depth = std::exchange(_publishes_this_pass, 0);
+    if (_queue_congested ? depth < QUEUE_LOW : depth > QUEUE_HIGH) {
+        _queue_congested = !_queue_congested;
+        if (_queue_congested)
+            QB_LOG_WARN("{} publishes queued in one loop pass, holding back publish credits", depth);
+    }
+    releaseCredits();
+}
+
+/**
+ * @brief Publish accounting of admission control
+ * 
+ * A session starts with PUBLISH_WINDOW credits of its own. Each of its
+ * publishes reaching this actor spent one; every CREDIT_BATCH of them,
+ * a batch is returned, now or when the actor is no longer overloaded.
+ */
+void TopicManagerActor::consumeCredit(qb::uuid session_id, qb::ActorId server_id) {
+    ++_publishes_this_pass;
+    auto& publisher = _publishers.try_emplace(session_id, PublisherCredit{server_id}).first->second;
+    if (++publisher.processed < CREDIT_BATCH)
+        return;
+    publisher.processed = 0;
+    if (!overloaded() && !publisher.deferred) {
+        auto& evt = push<CreditEvent>(publisher.server_id);
+        evt.session_id = session_id;
+        evt.credits = CREDIT_BATCH;
+        return;
+    }
+    ++publisher.deferred;
+    _deferred.insert(session_id);
+}
+
+/**
+ * @brief Grants held-back credits
+ * 
+ * One batch per session and per core loop pass: the credits granted now
+ * show up in the queue depth of the next passes, so the actor stops
+ * releasing as soon as it is overloaded again instead of granting every
+ * held-back batch at once.
+ */
+void TopicManagerActor::releaseCredits() {
+    if (overloaded())
+        return;
+    for (auto it = _deferred.begin(); it != _deferred.end();) {
+        auto& publisher = _publishers[*it];
+        auto& evt = push<CreditEvent>(publisher.server_id);
+        evt.session_id = *it;
+        evt.credits = CREDIT_BATCH;
+        it = --publisher.deferred ? std::next(it) : _deferred.erase(it);
+    }
+}
+
+/**
+ * @brief Adds a session to a consumer group
+ * 
+ * The group is created by its first member, with the strategy it names
+ * (round_robin by default). A later member naming another strategy is
+ * refused, so all members agree on how messages are shared.
+ */
+void TopicManagerActor::joinGroup(qb::uuid session_id, qb::ActorId server_id,
+                                  const std::string& topic, std::string_view spec) {
+    const std::string name(firstWord(spec));
+    const auto rest = spec.size() > name.size() ? firstWord(spec.substr(name.size() + 1)) : std::string_view{};
+
+    if (name.empty()) {
+        sendError(session_id, server_id, "Missing group name. Format: <topic> <group> [strategy]");
+        return;
+    }
+
+    GroupStrategy strategy = GroupStrategy::ROUND_ROBIN;
+    if (rest == "least_outstanding") strategy = GroupStrategy::LEAST_OUTSTANDING;
+    else if (rest == "sticky") strategy = GroupStrategy::STICKY;
+    else if (!rest.empty() && rest != "round_robin") {
+        sendError(session_id, server_id, "Unknown group strategy: " + std::string(rest) +
+                                         " (round_robin, least_outstanding, sticky)");
+        return;
+    }
+
+    auto& groups = _groups[topic];
+    auto group_it = groups.find(name);
+    if (group_it == groups.end()) {
+        group_it = groups.emplace(name, ConsumerGroup{strategy}).first;
+        refreshInterest();
+    } else if (!rest.empty() && group_it->second.strategy != strategy) {
+        sendError(session_id, server_id, "Group " + name + " on topic " + topic +
+                                         " already uses another strategy");
+        return;
+    }
+
+    auto& members = group_it->second.members;
+    if (std::find(members.begin(), members.end(), session_id) == members.end())
+        members.push_back(session_id);
+    _session_groups[session_id].emplace(topic, name);
+
+    QB_LOG_INFO("Client {} joined group {} on topic: {} ({} members)", session_id, name, topic,
+                members.size());
+    sendResponse(session_id, server_id, "Joined group " + name + " on topic: " + topic);
+}
+
+/**
+ * @brief Removes a session from a consumer group
+ * 
+ * Empty groups, and topics without groups, are deleted so that a publish
+ * only iterates over groups that have members.
+ */
+bool TopicManagerActor::leaveGroup(qb::uuid session_id, const std::string& topic,
+                                   const std::string& group) {
+    auto topic_it = _groups.find(topic);
+    if (topic_it == _groups.end()) return false;
+    auto group_it = topic_it->second.find(group);
+    if (group_it == topic_it->second.end()) return false;
+    auto& members = group_it->second.members;
+    auto member_it = std::find(members.begin(), members.end(), session_id);
+    if (member_it == members.end()) return false;
+
+    members.erase(member_it);
+    auto session_it = _session_groups.find(session_id);
+    if (session_it != _session_groups.end()) {
+        session_it->second.erase({topic, group});
+        if (session_it->second.empty()) _session_groups.erase(session_it);
+    }
+    if (members.empty()) {
+        topic_it->second.erase(group_it);
+        if (topic_it->second.empty()) _groups.erase(topic_it);
+        refreshInterest();
+    }
+    return true;
+}
+
+/**
+ * @brief Picks the member of a group that receives the next message
+ * 
+ * - ROUND_ROBIN: members in turn.
+ * - LEAST_OUTSTANDING: the member with the fewest unacknowledged messages,
+ *   scanning from the round-robin cursor so that ties rotate.
+ * - STICKY: rendezvous hashing of the key, so a key keeps its member and a
+ *   member joining or leaving only moves the keys it takes or held.
+ */
+std::size_t TopicManagerActor::selectMember(ConsumerGroup& group, std::string_view key) {
+    const auto& members = group.members;
+    const std::size_t size = members.size();
+    switch (group.strategy) {
+        case GroupStrategy::LEAST_OUTSTANDING: {
+            std::size_t best = group.next % size;
+            uint64_t best_outstanding = std::numeric_limits<uint64_t>::max();
+            for (std::size_t i = 0; i < size; ++i) {
+                const std::size_t index = (group.next + i) % size;
+                auto session_it = _sessions.find(members[index]);
+                const uint64_t outstanding = session_it != _sessions.end()
+                    ? session_it->second.outstanding : std::numeric_limits<uint64_t>::max();
+                if (outstanding < best_outstanding) {
+                    best = index;
+                    best_outstanding = outstanding;
+                }
+            }
+            group.next = best + 1;
+            return best;
+        }
+        case GroupStrategy::STICKY: {
+            const uint64_t key_hash = std::hash<std::string_view>{}(key);
+            std::size_t best = 0;
+            uint64_t best_weight = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                const uint64_t weight = mix(key_hash ^ std::hash<qb::uuid>{}(members[i]));
+                if (i == 0 || weight > best_weight) {
+                    best = i;
+                    best_weight = weight;
+                }
+            }
+            return best;
+        }
+        case GroupStrategy::ROUND_ROBIN:
+        default:
+            return group.next++ % size;
+    }
+}
+
+/**
+ * @brief Registers an incoming peer link
+ * 
+ * The peer gets the current interest filter right away, even if empty, so
+ * a node that restarts does not keep forwarding on stale interest.
+ * 
+ * @param evt The hello of the peer node
+ */
+void TopicManagerActor::on(PeerHelloEvent& evt) {
+    _peer_sessions[evt.session_id] = evt.getSource();
+    sendToSession(evt.session_id, evt.getSource(), broker::MessageType::PEER_INTEREST,
+                  _local_interest.serialize());
+    QB_LOG_INFO("Peer node {} linked (session {})", std::string(evt.node), evt.session_id);
+}
+
+/**
+ * @brief Records the interest filter of an outgoing peer link
+ * 
+ * Only links with a non-empty filter are kept, so a publish on a node
+ * whose peers have no subscribers costs a single empty() check.
+ * 
+ * @param evt The filter received by the PeerLinkActor (evt.getSource())
+ */
+void TopicManagerActor::on(PeerInterestEvent& evt) {
+    if (evt.filter.empty())
+        _peer_links.erase(evt.getSource());
+    else
+        _peer_links[evt.getSource()] = evt.filter;
+}
+
+/**
+ * @brief Forwards a local publish to every peer link that may have subscribers
+ * 
+ * The PEER_PUBLISH message is built once, on the first matching link, and
+ * shared by the events of all links.
+ * 
+ * @param topic Topic of the publish
+ * @param publish The client's PUBLISH message ("topic content")
+ * @param trace Trace context for the forwards (empty if not sampled)
+ * @return Number of links the publish was forwarded to
+ */
+std::size_t TopicManagerActor::forwardToPeers(std::string_view topic,
+                                              const broker::MessageContainer& publish,
+                                              const tracing::Context& trace) {
+    broker::MessageContainer forward;
+    std::size_t links = 0;
+    for (const auto& [link_id, filter] : _peer_links) {
+        if (!filter.mayContain(topic)) continue;
+        if (!forward)
+            forward = broker::MessageContainer(broker::MessageType::PEER_PUBLISH,
+                                               std::string(publish.payload()));
+        auto& evt = push<PeerPublishEvent>(link_id, forward);
+        QB_PROFILE_SEND(evt);
+        evt.trace = trace;
+        ++links;
+    }
+    return links;
+}
+
+/**
+ * @brief Rebuilds the local interest filter from the subscription table
+ * 
+ * Bloom filters cannot remove a topic, hence the rebuild. The filter is
+ * sent to the incoming peer links only if it changed.
+ */
+void TopicManagerActor::refreshInterest() {
+    broker::InterestFilter interest;
+    for (const auto& [topic, subscribers] : _subscriptions)
+        interest.add(topic);
+    for (const auto& [topic, groups] : _groups)
+        interest.add(topic);
+    if (interest == _local_interest) return;
+    _local_interest = interest;
+
+    const auto payload = _local_interest.serialize();
+    for (const auto& [session_id, server_id] : _peer_sessions)
+        sendToSession(session_id, server_id, broker::MessageType::PEER_INTEREST, payload);
 }
 
 /**
@@ -255,6 +683,7 @@ void TopicManagerActor::sendToSession(qb::uuid session_id, qb::ActorId server_id
                                       broker::MessageType type, const std::string& payload) {
     // Create event with optimized message handling
     auto& evt = push<SendMessageEvent>(server_id, session_id, type, payload);
+    QB_PROFILE_SEND(evt);
 }
 
 /**
@@ -266,12 +695,16 @@ void TopicManagerActor::sendToSession(qb::uuid session_id, qb::ActorId server_id
  * @param session_id Target session's unique identifier
  * @param server_id Server actor handling the session
  * @param shared_message A shared message container used across multiple recipients
+ * @param trace Trace context for the delivery (empty if not sampled)
  */
 void TopicManagerActor::sendToSession(qb::uuid session_id, qb::ActorId server_id,
-                                     const broker::MessageContainer& shared_message) {
+                                     const broker::MessageContainer& shared_message,
+                                     const tracing::Context& trace) {
     // Create event that references the shared message container
     // The underlying message data will be atomically shared
     auto& evt = push<SendMessageEvent>(server_id, session_id, shared_message);
+    QB_PROFILE_SEND(evt);
+    evt.trace = trace;
 }
 
 /**
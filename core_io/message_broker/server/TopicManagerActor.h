@@ -20,6 +20,29 @@
  *   (using a shared `broker::MessageContainer` for the message payload to achieve zero-copy
  *   for broadcast) for each, `push`ing it to the `ServerActor` managing that subscriber's session.
  * - Handling `DisconnectEvent`: Cleans up all subscriptions for the disconnected session.
+ * - Consumer groups (`SUBSCRIBE` payload `topic group [strategy]`): the members of a group
+ *   share the topic's stream, each message going to one member chosen round-robin, by
+ *   fewest outstanding (unacknowledged) messages, or by a rendezvous hash of the message key.
+ *   Plain subscribers of the topic still receive every message.
+ * - Federation (`--peer`):
+ *   - `PeerHelloEvent`: registers an incoming peer link and sends it the local interest
+ *     filter (`broker::InterestFilter` of the topics with local subscribers), then sends it
+ *     again whenever a topic gains its first or loses its last subscriber.
+ *   - `PeerInterestEvent`: records the filter of an outgoing `PeerLinkActor`.
+ *   - A local `PublishEvent` is also pushed, as one shared `PEER_PUBLISH` message, to each
+ *     link whose filter may contain the topic. A `PEER_PUBLISH` received from a peer is
+ *     delivered to local subscribers only, so no publish crosses a link twice.
+ * - Admission control: every `CREDIT_BATCH` publishes of a session, its credits are sent back
+ *   (`CreditEvent`) so that it can keep publishing. Grants are held back while the actor is
+ *   behind (more than `QUEUE_HIGH` publishes drained in one core loop pass, `qb::ICallback`)
+ *   or while a `ServerActor` reports an output backlog (`BacklogEvent`), then released one
+ *   batch per session per loop pass. A publisher then runs out of credit and its session
+ *   stops parsing `PUBLISH` frames. QB keeps reading the socket into the input buffer, so
+ *   a client that keeps sending is disconnected at `BrokerSession::MAX_HELD_INPUT`
+ *   (`PUBLISH_WINDOW` publishes of `MAX_PUBLISH_PAYLOAD`, about 16 MB).
+ * - Retained messages (`--retain BYTES`): the last `MESSAGE` container of each topic is kept
+ *   in a `RetainedStore` (LRU, bounded in bytes) and sent to a new subscriber right after
+ *   its confirmation, by reference, without formatting it again.
  *
  * This actor uses `std::string_view` in its event handlers (via `PublishEvent`, `SubscribeEvent`,
  * `UnsubscribeEvent`) that point to data within a `broker::MessageContainer` to achieve
@@ -44,8 +67,10 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <vector>
 #include "../shared/Protocol.h"
 #include "../shared/Events.h"
+#include "RetainedStore.h"
 
 /**
  * @brief Structure holding information about a connected session
@@ -57,6 +82,37 @@
  */
 struct SessionInfo {
     qb::ActorId server_id;  // ID of the server managing this session
+    uint64_t outstanding = 0;  // GROUP_MESSAGEs delivered and not acknowledged yet
+};
+
+/**
+ * @brief Publish credits of a session (admission control)
+ */
+struct PublisherCredit {
+    qb::ActorId server_id;    // Server managing the session, receives the CreditEvents
+    uint32_t processed = 0;   // Publishes processed since the last full batch
+    uint32_t deferred = 0;    // Batches of credits held back while overloaded
+};
+
+/**
+ * @brief How a consumer group picks the member that receives a message
+ */
+enum class GroupStrategy {
+    ROUND_ROBIN,         ///< Members in turn
+    LEAST_OUTSTANDING,   ///< Member with the fewest unacknowledged messages
+    STICKY               ///< Same key (first word of the message) -> same member
+};
+
+/**
+ * @brief Shared subscription: every message of the topic goes to one member
+ * 
+ * Members are sessions that subscribed with the same group name on the same
+ * topic. The first member chooses the strategy.
+ */
+struct ConsumerGroup {
+    GroupStrategy strategy = GroupStrategy::ROUND_ROBIN;
+    std::vector<qb::uuid> members;  // In join order
+    std::size_t next = 0;           // Round-robin cursor, also rotates least-outstanding ties
 };
 
 /**
@@ -83,7 +139,7 @@ struct SessionInfo {
  *    - Manages topic subscriptions
  *    - Handles cleanup on disconnection
  */
-class TopicManagerActor : public qb::Actor {
+class TopicManagerActor : public qb::Actor, public qb::ICallback {
 private:
     // Maps session_id to SessionInfo
     std::map<qb::uuid, SessionInfo> _sessions;
@@ -94,6 +150,43 @@ private:
     // Maps session_id to set of topics they're subscribed to (for quick cleanup)
     std::map<qb::uuid, std::set<std::string>> _session_topics;
 
+    // Maps topic to its consumer groups by group name
+    std::map<std::string, std::map<std::string, ConsumerGroup>> _groups;
+
+    // Maps session_id to the (topic, group) pairs it is a member of (for quick cleanup)
+    std::map<qb::uuid, std::set<std::pair<std::string, std::string>>> _session_groups;
+
+    // Federation: incoming peer links (session_id -> ServerActor) that receive our interest
+    std::map<qb::uuid, qb::ActorId> _peer_sessions;
+
+    // Federation: interest of the peer behind each outgoing PeerLinkActor (non-empty only)
+    std::map<qb::ActorId, broker::InterestFilter> _peer_links;
+
+    // Federation: last interest filter sent to the incoming peer links
+    broker::InterestFilter _local_interest;
+
+    // Last message of each topic, sent to new subscribers (disabled by default)
+    RetainedStore _retained;
+
+    // Admission control: credits of each publishing session
+    std::map<qb::uuid, PublisherCredit> _publishers;
+
+    // Admission control: sessions with credits held back, granted when no longer overloaded
+    std::set<qb::uuid> _deferred;
+
+    // Admission control: ServerActors whose output backlog is above their high watermark
+    std::set<qb::ActorId> _congested_servers;
+
+    // Admission control: publishes handled since the last core loop pass, and whether
+    // that queue depth is above QUEUE_HIGH (until it drops below QUEUE_LOW)
+    uint32_t _publishes_this_pass = 0;
+    bool _queue_congested = false;
+
+    /// Publishes drained in one loop pass above which credits are held back...
+    static constexpr uint32_t QUEUE_HIGH = 4096;
+    /// ...and below which they are granted again
+    static constexpr uint32_t QUEUE_LOW = 1024;
+
 public:
     /**
      * @brief Default constructor
@@ -103,6 +196,12 @@ public:
      */
     TopicManagerActor() = default;
 
+    /**
+     * @brief Constructor enabling retained messages
+     * @param retain_bytes Memory budget of the retained messages; 0 disables them
+     */
+    explicit TopicManagerActor(std::size_t retain_bytes) : _retained(retain_bytes) {}
+
     /**
      * @brief Initializes the topic manager actor
      * 
@@ -191,7 +290,110 @@ public:
      */
     void on(DisconnectEvent& evt);
 
+    /**
+     * @brief Handles acknowledgements of consumer group members
+     * 
+     * Lowers the session's outstanding count, used by least-outstanding groups.
+     * 
+     * @param evt Ack event containing the session ID and the number of messages
+     */
+    void on(AckEvent& evt);
+
+    /**
+     * @brief Registers an incoming peer link and sends it the local interest
+     * 
+     * @param evt Event containing the peer's session ID and node name
+     */
+    void on(PeerHelloEvent& evt);
+
+    /**
+     * @brief Records the interest of the peer behind an outgoing link
+     * 
+     * An empty filter removes the link from the forwarding candidates.
+     * 
+     * @param evt Event containing the peer's filter; its source is the PeerLinkActor
+     */
+    void on(PeerInterestEvent& evt);
+
+    /**
+     * @brief Records whether a ServerActor's output backlog is congested
+     * 
+     * Credits are held back while any ServerActor is congested, and released
+     * again from the loop passes after the last one drains.
+     * 
+     * @param evt Backlog state of the source ServerActor
+     */
+    void on(BacklogEvent& evt);
+
+    /**
+     * @brief Measures the queue depth, once per core loop pass
+     * 
+     * The publishes handled since the previous pass are those that were
+     * waiting in the actor's mailbox.
+     */
+    void onCallback() override;
+
 private:
+    /**
+     * @brief Counts a processed publish and returns a batch of credits when due
+     * 
+     * @param session_id Publishing session
+     * @param server_id Server managing the session
+     */
+    void consumeCredit(qb::uuid session_id, qb::ActorId server_id);
+
+    /**
+     * @brief Grants one batch of held-back credits per session, unless overloaded (once per loop pass)
+     */
+    void releaseCredits();
+
+    bool overloaded() const { return _queue_congested || !_congested_servers.empty(); }
+
+    /**
+     * @brief Adds a session to a consumer group, creating the group if needed
+     * 
+     * @param session_id Joining session
+     * @param server_id Server managing the session (for the response)
+     * @param topic Topic of the group
+     * @param spec "group [round_robin|least_outstanding|sticky]"
+     */
+    void joinGroup(qb::uuid session_id, qb::ActorId server_id,
+                   const std::string& topic, std::string_view spec);
+
+    /**
+     * @brief Removes a session from a consumer group, deleting the group when empty
+     * 
+     * @return false if the session was not a member
+     */
+    bool leaveGroup(qb::uuid session_id, const std::string& topic, const std::string& group);
+
+    /**
+     * @brief Picks the member of a group that receives the next message
+     * 
+     * @param group The consumer group (its cursor is advanced)
+     * @param key Message key, used by STICKY groups
+     * @return Index of the member in group.members
+     */
+    std::size_t selectMember(ConsumerGroup& group, std::string_view key);
+
+    /**
+     * @brief Forwards a local publish to the peer links that may have subscribers
+     * 
+     * @param topic Topic of the publish
+     * @param publish Message of the publish ("topic content")
+     * @param trace Trace context for the forwards (empty if not sampled)
+     * @return Number of links the publish was forwarded to
+     */
+    std::size_t forwardToPeers(std::string_view topic, const broker::MessageContainer& publish,
+                               const tracing::Context& trace);
+
+    /**
+     * @brief Rebuilds the local interest filter and sends it to the peer sessions if it changed
+     * 
+     * Called when a topic gains its first or loses its last local subscriber.
+     */
+    void refreshInterest();
+
     /**
      * @brief Sends a message to a specific session with optimized delivery
      * 
@@ -220,9 +422,11 @@ private:
      * @param session_id Target session ID
      * @param server_id Server managing the target session
      * @param shared_message Shared message container with atomic reference counting
+     * @param trace Trace context for the delivery (empty if not sampled)
      */
     void sendToSession(qb::uuid session_id, qb::ActorId server_id,
-                      const broker::MessageContainer& shared_message);
+                      const broker::MessageContainer& shared_message,
+                      const tracing::Context& trace = {});
 
     /**
      * @brief Sends an error message to a specific session
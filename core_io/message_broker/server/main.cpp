@@ -7,70 +7,164 @@
  * This file sets up and launches the server-side actor system for the message broker.
  * It demonstrates a multi-core deployment strategy:
  * 1.  Initializes the `qb::Main` engine.
- * 2.  Creates the `TopicManagerActor` on a dedicated core (core 2), which handles the
+ * 2.  Creates the `TopicManagerActor` on a dedicated core (default core 2), which handles the
  *     central logic of topic management and message routing.
- * 3.  Creates a pool of `ServerActor`s on another core (core 1). These actors manage
+ * 3.  Creates a pool of `ServerActor`s on another core (default core 1). These actors manage
  *     client I/O sessions and interface with the `TopicManagerActor`.
- * 4.  Creates an `AcceptActor` on a third core (core 0). This actor listens for
- *     incoming client connections on a specific port (12345) and distributes them
+ * 4.  Creates an `AcceptActor` on a third core (default core 0). This actor listens for
+ *     incoming client connections on a specific port (12345, or `--port N`) and distributes them
  *     to the `ServerActor` pool.
- * 5.  Starts the QB engine asynchronously and waits for user input (Enter key) to initiate
+ * 5.  Creates one `PeerLinkActor` per `--peer host:port` (default core 0), which federates this
+ *     node with another broker process: publishes are forwarded to the peer only for topics it
+ *     has subscribers for. `--node NAME` names this node in the peers' logs.
+ *     `--retain BYTES` (suffix K, M or G) keeps the last message of each topic, up to BYTES
+ *     in total, and sends it to new subscribers.
+ *     `--unix PATH` also accepts clients on a Unix domain socket, and `--shm PATH` on a Unix
+ *     socket that hands each client a shared-memory channel (`shared/ShmTransport.h`).
+ * 6.  Starts the QB engine asynchronously and waits for user input (Enter key) to initiate
  *     a graceful shutdown (`engine.stop()`, `engine.join()`).
  *
  * This architecture separates concerns: connection acceptance, session/IO handling,
  * and core application logic are handled by different sets of actors on different cores.
+ * The cores of the roles `topic_manager`, `server` and `acceptor` can be changed without
+ * recompiling (`common/placement`), e.g.
+ * `--place topic_manager=auto:hot --place server=auto:io` or `--placement broker.conf`.
  *
  * QB Features Demonstrated:
  * - `qb::Main`: Actor system engine.
  * - `engine.addActor<ActorType>(core_id, args...)`: Multi-core actor deployment.
- * - `engine.core(core_id).builder()`: Fluent API for actor creation on a core.
  * - `qb::ActorIdList`: For passing `ServerActor` IDs to `AcceptActor`.
  * - Asynchronous Engine Start & Graceful Shutdown.
  * - `qb::io::uri`: For specifying listen address.
+ *
+ * When built with `-DQB_EXAMPLES_PROFILE=ON`, a handler and queue profile is printed
+ * after shutdown (and written as JSON to `$QB_PROFILE_JSON` if set). Setting `QB_TRACE_FILE`
+ * records sampled publishes as a Chrome trace (`QB_TRACE_SAMPLE`, default 1 in 100).
  */
 
 #include <qb/main.h>
 #include "AcceptActor.h"
 #include "ServerActor.h"
 #include "TopicManagerActor.h"
+#include "PeerLinkActor.h"
+#include <profiling/Profiler.h>
+#include <tracing/Tracer.h>
+#include <logging/Logger.h>
+#include <placement/Placement.h>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
 
 int main(int argc, char* argv[]) {
     // Create the QB engine instance
     qb::Main engine;
 
+    // Federation options: --port N, --node NAME, --peer host:port (repeatable)
+    // Retained messages: --retain BYTES, e.g. 64M (disabled by default)
+    std::string port = "12345";
+    std::string node;
+    std::vector<std::string> peers;
+    std::size_t retain_bytes = 0;
+    // Co-located clients: --unix PATH (Unix socket), --shm PATH (shared-memory rings)
+    std::string unix_path;
+    std::string shm_path;
+    for (int i = 1; i + 1 < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--port") port = argv[++i];
+        else if (arg == "--node") node = argv[++i];
+        else if (arg == "--peer") peers.push_back(argv[++i]);
+        else if (arg == "--unix") unix_path = argv[++i];
+        else if (arg == "--shm") shm_path = argv[++i];
+        else if (arg == "--retain") {
+            char* unit = nullptr;
+            retain_bytes = std::strtoull(argv[++i], &unit, 10);
+            switch (*unit) {
+                case 'G': case 'g': retain_bytes <<= 10; [[fallthrough]];
+                case 'M': case 'm': retain_bytes <<= 10; [[fallthrough]];
+                case 'K': case 'k': retain_bytes <<= 10;
+            }
+        }
+    }
+    if (node.empty()) node = "broker-" + port;
+
     try {
-        // Step 1: Create TopicManagerActor (Core 2)
+        // Core of each actor role, overridable with --placement FILE / --place role=spec
+        auto placement = placement::Placement::fromArgs({
+            {"topic_manager", 1, "2"},
+            {"server", 2, "1"},
+            {"acceptor", 1, "0"},
+            {"peer", 1, "0"},
+        }, argc, argv);
+        qb::io::cout() << placement.describe();
+
+        // Step 1: Create TopicManagerActor (default core 2)
         // - Central component for state management
         // - Placed on separate core to handle broadcasts
-        auto topic_manager_id = engine.addActor<TopicManagerActor>(2);
+        auto topic_manager_id = engine.addActor<TopicManagerActor>(placement.core("topic_manager"),
+                                                                   retain_bytes);
 
-        // Step 2: Create ServerActors (Core 1)
+        // Step 2: Create ServerActors (default core 1)
         // - Multiple instances for connection handling
         // - Share topic_manager_id for message routing
-        // - Builder pattern for multiple actors
-        auto server_ids = engine.core(1).builder()
-            .addActor<ServerActor>(topic_manager_id)
-            .addActor<ServerActor>(topic_manager_id)
-            .idList();
+        qb::ActorIdList server_ids;
+        for (auto core : placement.cores("server"))
+            server_ids.push_back(engine.addActor<ServerActor>(core, topic_manager_id));
 
-        // Step 3: Create AcceptActor (Core 0)
-        // - Single listener on port 12345
+        // Step 3: Create AcceptActor (default core 0)
+        // - Single listener on port 12345 (--port)
         // - Shares server_ids for connection distribution
         // - Demonstrate QB's URI-based configuration
-        engine.core(0).builder()
-            .addActor<AcceptActor>(qb::io::uri{"tcp://0.0.0.0:12345"}, server_ids);
+        engine.addActor<AcceptActor>(placement.core("acceptor"), qb::io::uri{"tcp://0.0.0.0:" + port}, server_ids);
+
+        // Step 3a: Local transports (same core as the TCP acceptor)
+        // - A stale socket file of a previous run would make bind() fail
+        if (!unix_path.empty()) {
+            ::unlink(unix_path.c_str());
+            engine.addActor<AcceptActor>(placement.core("acceptor"), qb::io::uri{"unix://" + unix_path}, server_ids);
+        }
+        if (!shm_path.empty()) {
+            ::unlink(shm_path.c_str());
+            engine.addActor<AcceptActor>(placement.core("acceptor"), qb::io::uri{"unix://" + shm_path}, server_ids, true);
+        }
+
+        // Step 3b: Federation (default core 0)
+        // - One outgoing link per --peer, carrying this node's publishes to the peer
+        // - Peers connect to our client port, so no extra listener is needed
+        for (const auto& peer : peers)
+            engine.addActor<PeerLinkActor>(placement.core("peer"), node, qb::io::uri{"tcp://" + peer}, topic_manager_id);
+        placement.pin(engine);
 
         // Step 4: Log system configuration
         // - Display actor IDs for debugging
         // - Show listening port
         // - Confirm initialization
-        qb::io::cout() << "Message broker server started on port 12345" << std::endl;
+        qb::io::cout() << "Message broker server " << node << " started on port " << port << std::endl;
+        if (!unix_path.empty())
+            qb::io::cout() << "Accepting local clients on " << unix_path << std::endl;
+        if (!shm_path.empty())
+            qb::io::cout() << "Accepting shared-memory clients on " << shm_path << std::endl;
+        for (const auto& peer : peers)
+            qb::io::cout() << "Federated with peer " << peer << std::endl;
         qb::io::cout() << "TopicManager ID: " << topic_manager_id << std::endl;
         qb::io::cout() << "Server1 ID: " << server_ids[0] << std::endl;
         qb::io::cout() << "Server2 ID: " << server_ids[1] << std::endl;
 
-        // Step 5: Start the engine
+        // Step 5: Asynchronous logging and optional request tracing
+        // - QB_LOG_FILE / QB_LOG_LEVEL select the log file and level (default: stdout, info)
+        // - QB_TRACE_FILE=trace.json enables it, QB_TRACE_SAMPLE=N traces 1 publish in N
+        // - Open the file in chrome://tracing or https://ui.perfetto.dev
+        logging::Logger::instance().startFromEnv();
+        if (const char* trace_path = std::getenv("QB_TRACE_FILE")) {
+            const char* sample = std::getenv("QB_TRACE_SAMPLE");
+            const auto sample_every = static_cast<uint32_t>(sample ? std::strtoul(sample, nullptr, 10) : 100);
+            if (tracing::Tracer::instance().start(trace_path, sample_every))
+                qb::io::cout() << "Tracing 1 publish in " << sample_every << " to " << trace_path << std::endl;
+        }
+
+        // Step 6: Start the engine
         // - Asynchronous start for interactive shutdown
         // - Wait for user input to stop
         // - Demonstrate proper shutdown sequence
@@ -79,12 +173,25 @@ int main(int argc, char* argv[]) {
         qb::io::cout() << "Press Enter to stop the engine" << std::endl;
         std::cin.get();
         
-        // Step 6: Clean shutdown
+        // Step 7: Clean shutdown
         // - Stop engine gracefully
         // - Wait for all actors to finish
         // - Ensure proper cleanup
         engine.stop();
         engine.join();
+        tracing::Tracer::instance().stop();
+        logging::Logger::instance().stop();
+
+#ifdef QB_EXAMPLES_PROFILE
+        // Step 8: Profiling report (QB_EXAMPLES_PROFILE builds only)
+        // - Handler cost per actor/event type, queue wait and depth per core pair
+        // - JSON copy written to $QB_PROFILE_JSON when set
+        std::cout << profiling::Profiler::instance().table();
+        if (const char* json_path = std::getenv("QB_PROFILE_JSON")) {
+            std::ofstream(json_path) << profiling::Profiler::instance().json() << std::endl;
+            std::cout << "Profile written to " << json_path << std::endl;
+        }
+#endif
     }
     catch (const std::exception& e) {
         qb::io::cerr() << "Error: " << e.what() << std::endl;
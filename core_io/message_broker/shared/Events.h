@@ -28,6 +28,12 @@
  *     to be shared efficiently if broadcast to multiple clients via different `ServerActor`s.
  * 7.  `DisconnectEvent`: Sent by `ServerActor` to `TopicManagerActor` when a client disconnects.
  * 8.  `BrokerInputEvent`: Client-side event from `InputActor` to `ClientActor`, carrying the raw command string.
+ * 9.  `ClientReadyEvent`: Client-side event from `ClientActor` to `InputActor`, telling it whether
+ *     commands can currently be sent, so input is only consumed while connected.
+ * 10. `PeerHelloEvent`, `PeerInterestEvent`, `PeerPublishEvent`: Federation events between
+ *     `ServerActor`, `PeerLinkActor` and `TopicManagerActor` (see `Interest.h`).
+ * 11. `AckEvent`: Sent by `ServerActor` to `TopicManagerActor` when a consumer group member
+ *     acknowledges the messages it processed.
  *
  * QB Features Demonstrated:
  * - Custom `qb::Event`s for typed, asynchronous communication.
@@ -36,6 +42,12 @@
  * - `qb::string<N>` for fixed-size string event fields.
  * - `qb::uuid` for session identification.
  * - `qb::io::tcp::socket` carried by events.
+ *
+ * The events exchanged between `ServerActor` and `TopicManagerActor` carry
+ * `QB_PROFILE_STAMP` so that, in a `QB_EXAMPLES_PROFILE` build, their queue wait
+ * time is measured (see `common/profiling/Profiler.h`). The base is empty otherwise.
+ * `PublishEvent` and `SendMessageEvent` also carry a `tracing::Context`, so a sampled
+ * publish can be followed from the publisher's session to every subscriber's delivery.
  */
 
 #pragma once
@@ -44,6 +56,10 @@
 #include <qb/io/tcp/socket.h>
 #include <qb/string.h>
 #include "Protocol.h"
+#include "Interest.h"
+#include <profiling/Profiler.h>
+#include <tracing/Tracer.h>
+#include <audit/EventAudit.h>
 #include <memory>
 #include <string_view>
 #include <atomic>
@@ -187,7 +203,9 @@ public:
  */
 struct NewSessionEvent : public qb::Event {
     qb::io::tcp::socket socket;  ///< Connected client socket with RAII management
+    bool shared_memory = false;  ///< Accepted on the --shm socket: create a ShmSession
 };
+QB_AUDIT_EVENT(NewSessionEvent, socket, shared_memory);
 
 /**
  * @brief Event for topic subscription requests
@@ -202,7 +220,7 @@ struct NewSessionEvent : public qb::Event {
  * The event source (evt.getSource()) contains the ServerActor's ID,
  * enabling TopicManagerActor to route responses back to the correct client.
  */
-struct SubscribeEvent : public qb::Event {
+struct SubscribeEvent : public qb::Event, QB_PROFILE_STAMP {
     qb::uuid session_id;                     ///< Unique session identifier
     broker::MessageContainer message_data;   ///< Message container with shared ownership
     std::string_view topic;                  ///< View of topic from message payload
@@ -226,6 +244,7 @@ struct SubscribeEvent : public qb::Event {
      */
     SubscribeEvent() = default;
 };
+QB_AUDIT_HOT_EVENT(SubscribeEvent, 2 * audit::CACHE_LINE, session_id, message_data, topic);
 
 /**
  * @brief Event for topic unsubscription requests
@@ -240,7 +259,7 @@ struct SubscribeEvent : public qb::Event {
  * The event source (evt.getSource()) identifies the ServerActor
  * that was handling the client.
  */
-struct UnsubscribeEvent : public qb::Event {
+struct UnsubscribeEvent : public qb::Event, QB_PROFILE_STAMP {
     qb::uuid session_id;                     ///< Unique session identifier
     broker::MessageContainer message_data;   ///< Message container with shared ownership
     std::string_view topic;                  ///< View of topic from message payload
@@ -264,6 +283,7 @@ struct UnsubscribeEvent : public qb::Event {
      */
     UnsubscribeEvent() = default;
 };
+QB_AUDIT_HOT_EVENT(UnsubscribeEvent, 2 * audit::CACHE_LINE, session_id, message_data, topic);
 
 /**
  * @brief Event for publishing messages to topics
@@ -278,11 +298,12 @@ struct UnsubscribeEvent : public qb::Event {
  * Uses zero-copy techniques with shared ownership to efficiently
  * handle message content without unnecessary copying.
  */
-struct PublishEvent : public qb::Event {
+struct PublishEvent : public qb::Event, QB_PROFILE_STAMP {
     qb::uuid session_id;                     ///< Message sender's session ID
     broker::MessageContainer message_data;   ///< Message container with shared ownership
     std::string_view topic;                  ///< View of topic from message payload
     std::string_view content;                ///< View of message content
+    tracing::Context trace;                  ///< Sampled trace context (empty if not traced)
     
     /**
      * @brief Default constructor for QB event system
@@ -324,6 +345,7 @@ struct PublishEvent : public qb::Event {
           topic(t),
           content(c) {}
 };
+QB_AUDIT_HOT_EVENT(PublishEvent, 2 * audit::CACHE_LINE, session_id, message_data, topic, content, trace);
 
 /**
  * @brief Event for targeted message delivery
@@ -336,9 +358,10 @@ struct PublishEvent : public qb::Event {
  * Optimized to use shared ownership for message data to avoid
  * unnecessary copying during event routing.
  */
-struct SendMessageEvent : public qb::Event {
+struct SendMessageEvent : public qb::Event, QB_PROFILE_STAMP {
     qb::uuid session_id;                     ///< Target client's session ID
     broker::MessageContainer message_data;   ///< Message container with shared ownership
+    tracing::Context trace;                  ///< Sampled trace context (empty if not traced)
     
     /**
      * @brief Creates message delivery event
@@ -378,6 +401,7 @@ struct SendMessageEvent : public qb::Event {
         return message_data.message();
     }
 };
+QB_AUDIT_HOT_EVENT(SendMessageEvent, 2 * audit::CACHE_LINE, session_id, message_data, trace);
 
 /**
  * @brief Event for client disconnection handling
@@ -392,9 +416,118 @@ struct SendMessageEvent : public qb::Event {
  * The event source (evt.getSource()) identifies the ServerActor
  * that was handling the disconnected client.
  */
-struct DisconnectEvent : public qb::Event {
+struct DisconnectEvent : public qb::Event, QB_PROFILE_STAMP {
     qb::uuid session_id;     ///< ID of the disconnected session
 };
+QB_AUDIT_HOT_EVENT(DisconnectEvent, audit::CACHE_LINE, session_id);
+
+/**
+ * @brief Event for consumer group acknowledgements
+ * 
+ * Flow:
+ * 1. A group member processes GROUP_MESSAGEs and sends ACK
+ * 2. ServerActor creates AckEvent
+ * 3. TopicManagerActor lowers the member's outstanding count, which
+ *    least-outstanding groups use to pick the next member
+ */
+struct AckEvent : public qb::Event, QB_PROFILE_STAMP {
+    qb::uuid session_id;     ///< Acknowledging session
+    uint32_t count = 1;      ///< Number of messages acknowledged
+};
+QB_AUDIT_HOT_EVENT(AckEvent, audit::CACHE_LINE, session_id, count);
+
+/// Publishes a session may forward before the TopicManagerActor grants it more credit
+constexpr uint32_t PUBLISH_WINDOW = 256;
+/// Credits returned at once, after this many of the session's publishes were processed
+constexpr uint32_t CREDIT_BATCH = 64;
+/// Largest PUBLISH payload a session forwards; larger ones are answered with an ERROR
+constexpr uint32_t MAX_PUBLISH_PAYLOAD = 64 * 1024;
+
+/**
+ * @brief Event granting publish credits to a session (admission control)
+ * 
+ * Flow:
+ * 1. A session starts with PUBLISH_WINDOW credits and spends one per PUBLISH
+ *    forwarded to the TopicManagerActor
+ * 2. Every CREDIT_BATCH publishes of a session, TopicManagerActor sends the
+ *    credits back to its ServerActor, unless it is overloaded
+ * 3. A session without credit stops parsing PUBLISH frames until this event
+ */
+struct CreditEvent : public qb::Event, QB_PROFILE_STAMP {
+    qb::uuid session_id;     ///< Session receiving the credits
+    uint32_t credits = 0;    ///< Publishes it may forward
+};
+QB_AUDIT_HOT_EVENT(CreditEvent, audit::CACHE_LINE, session_id, credits);
+
+/**
+ * @brief Event reporting the output backlog of a ServerActor
+ * 
+ * Sent when the bytes waiting to be written to the ServerActor's clients cross
+ * the high (congested) or low (drained) watermark. TopicManagerActor holds
+ * back publish credits while any ServerActor is congested.
+ */
+struct BacklogEvent : public qb::Event {
+    bool congested = false;  ///< true above the high watermark
+    uint64_t bytes = 0;      ///< Pending output bytes when sampled
+};
+QB_AUDIT_EVENT(BacklogEvent, congested, bytes);
+
+/**
+ * @brief Event for an incoming peer link
+ * 
+ * Flow:
+ * 1. Another broker node connects and sends PEER_HELLO
+ * 2. ServerActor creates PeerHelloEvent
+ * 3. TopicManagerActor registers the session as a peer:
+ *    - Sends it the local interest filter (PEER_INTEREST)
+ *    - Sends it the filter again whenever it changes
+ * 
+ * PEER_PUBLISH messages of that session are then delivered to local
+ * subscribers only, never forwarded again.
+ */
+struct PeerHelloEvent : public qb::Event {
+    qb::uuid session_id;     ///< Session of the peer link
+    qb::string<64> node;     ///< Name of the peer node
+};
+QB_AUDIT_EVENT(PeerHelloEvent, session_id, node);
+
+/**
+ * @brief Event carrying the topic interest of a peer node
+ * 
+ * Flow:
+ * 1. PeerLinkActor receives PEER_INTEREST from the node it is connected to
+ * 2. Sends PeerInterestEvent to TopicManagerActor
+ * 3. TopicManagerActor forwards publishes to this link only for topics
+ *    that may match the filter
+ * 
+ * An empty filter (link down, or no subscriber on the peer) stops forwarding.
+ * The event source (evt.getSource()) identifies the PeerLinkActor.
+ */
+struct PeerInterestEvent : public qb::Event {
+    broker::InterestFilter filter;   ///< Topics the peer has subscribers for
+};
+QB_AUDIT_EVENT(PeerInterestEvent, filter);
+
+/**
+ * @brief Event for forwarding a local publish to a peer node
+ * 
+ * Flow:
+ * 1. TopicManagerActor receives a PublishEvent from a local client
+ * 2. Pushes one PeerPublishEvent to each PeerLinkActor whose filter matches the topic
+ * 3. PeerLinkActor writes it to its link as PEER_PUBLISH
+ * 
+ * The PEER_PUBLISH container is created once per publish and shared by all links.
+ */
+struct PeerPublishEvent : public qb::Event, QB_PROFILE_STAMP {
+    broker::MessageContainer message_data;   ///< PEER_PUBLISH message shared by all links
+    tracing::Context trace;                  ///< Sampled trace context (empty if not traced)
+
+    explicit PeerPublishEvent(const broker::MessageContainer& shared_container)
+        : message_data(shared_container) {}
+
+    PeerPublishEvent() = default;
+};
+QB_AUDIT_HOT_EVENT(PeerPublishEvent, 2 * audit::CACHE_LINE, message_data, trace);
 
 /**
  * @brief Event for client-side user input handling
@@ -412,4 +545,22 @@ struct DisconnectEvent : public qb::Event {
  */
 struct BrokerInputEvent : public qb::Event {
     qb::string<1024> command;    ///< User input command (max 1024 chars)
-}; 
\ No newline at end of file
+};
+QB_AUDIT_EVENT(BrokerInputEvent, command);
+
+/**
+ * @brief Event for client-side flow control of user input
+ * 
+ * Flow:
+ * 1. ClientActor connects to (or loses) the server
+ * 2. ClientActor sends ClientReadyEvent to InputActor
+ * 3. InputActor starts (or stops) reading stdin
+ * 
+ * Input that arrives while the client is not ready stays in the
+ * stdin pipe instead of being read and discarded, so a scripted
+ * command file piped into the client is replayed in full.
+ */
+struct ClientReadyEvent : public qb::Event {
+    bool ready;    ///< true when commands can be sent to the server
+};
+QB_AUDIT_EVENT(ClientReadyEvent, ready);
@@ -0,0 +1,98 @@
+/**
+ * @file examples/core_io/message_broker/shared/Interest.h
+ * @example Message Broker - Topic Interest Summary for Federation
+ * @brief Defines `broker::InterestFilter`, the Bloom filter a broker node advertises to its
+ *        peers so that they only forward the publishes it has subscribers for.
+ *
+ * @details
+ * A federated node summarizes the topics its local clients are subscribed to in a
+ * fixed-size Bloom filter (4096 bits, 4 hash functions) and sends it to every peer
+ * link in a `PEER_INTEREST` message. The publishing node tests the topic of each
+ * publish against the filter of each link:
+ * - No false negatives: a node with a subscriber for the topic always receives the publish.
+ * - False positives (about 1% at 400 subscribed topics) cost one forwarded message that
+ *   the receiving node drops, since it has no subscriber for it.
+ *
+ * A Bloom filter cannot remove a topic, so the owner rebuilds it from its subscription
+ * table whenever a topic gains its first or loses its last subscriber, and sends it again
+ * only if it changed. The wire format is the raw bit array (512 bytes).
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace broker {
+
+/**
+ * @brief Fixed-size Bloom filter over topic names
+ */
+class InterestFilter {
+public:
+    static constexpr std::size_t BITS = 4096;
+    static constexpr std::size_t HASHES = 4;
+    static constexpr std::size_t BYTES = BITS / 8;
+
+    /// Adds a topic to the summary
+    void add(std::string_view topic) {
+        const auto [h1, h2] = hash(topic);
+        for (std::size_t i = 0; i < HASHES; ++i) {
+            const std::size_t bit = (h1 + i * h2) % BITS;
+            _words[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    /// false if the topic was certainly not added; true if it probably was
+    bool mayContain(std::string_view topic) const {
+        const auto [h1, h2] = hash(topic);
+        for (std::size_t i = 0; i < HASHES; ++i) {
+            const std::size_t bit = (h1 + i * h2) % BITS;
+            if (!(_words[bit / 64] & (uint64_t(1) << (bit % 64))))
+                return false;
+        }
+        return true;
+    }
+
+    /// true if no topic was added: nothing needs to be forwarded to the owner
+    bool empty() const {
+        for (auto word : _words)
+            if (word) return false;
+        return true;
+    }
+
+    bool operator==(const InterestFilter& other) const { return _words == other._words; }
+    bool operator!=(const InterestFilter& other) const { return !(*this == other); }
+
+    /// Payload of a `PEER_INTEREST` message
+    std::string serialize() const {
+        return std::string(reinterpret_cast<const char*>(_words.data()), BYTES);
+    }
+
+    /// Reads a `PEER_INTEREST` payload; false (and the filter unchanged) if its size is wrong
+    bool parse(std::string_view payload) {
+        if (payload.size() != BYTES)
+            return false;
+        std::memcpy(_words.data(), payload.data(), BYTES);
+        return true;
+    }
+
+private:
+    std::array<uint64_t, BITS / 64> _words{};
+
+    /// FNV-1a, split into the two halves used for double hashing
+    static std::pair<std::size_t, std::size_t> hash(std::string_view topic) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (unsigned char c : topic) {
+            h ^= c;
+            h *= 0x100000001b3ull;
+        }
+        return {static_cast<std::size_t>(h & 0xffffffff), static_cast<std::size_t>((h >> 32) | 1)};
+    }
+};
+
+} // namespace broker
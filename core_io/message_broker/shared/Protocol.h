@@ -13,6 +13,8 @@
  * - Magic (uint16_t `0x514D` 'QM'): Identifies QB Message Broker protocol.
  * - Version (uint8_t `0x01`): Protocol version.
  * - Type (uint8_t `broker::MessageType`): Defines message type (SUBSCRIBE, PUBLISH, MESSAGE, etc.).
+ *   The `PEER_*` types are only exchanged between federated brokers (see `PeerLinkActor`).
+ *   `GROUP_MESSAGE` / `ACK` are the deliveries and acknowledgements of consumer groups.
  * - Length (uint32_t): Size of the string payload.
  * The header (8 bytes) is followed by the UTF-8 string payload.
  *
@@ -99,7 +101,12 @@ enum class MessageType : uint8_t {
     PUBLISH,           ///< Client -> Server: Publish message to a topic
     MESSAGE,           ///< Server -> Client: Message from a topic
     RESPONSE,          ///< Server -> Client: Response to a command
-    ERROR              ///< Server -> Client: Error notification
+    ERROR,             ///< Server -> Client: Error notification
+    PEER_HELLO,        ///< Broker -> Broker: Opens a peer link, payload is the node name
+    PEER_INTEREST,     ///< Broker -> Broker: Topic interest of the accepting node (InterestFilter bytes)
+    PEER_PUBLISH,      ///< Broker -> Broker: Forwarded publish ("topic message"), delivered locally only
+    GROUP_MESSAGE,     ///< Server -> Client: Message of a consumer group, to be acknowledged with ACK
+    ACK                ///< Client -> Server: Number of GROUP_MESSAGEs processed (decimal payload)
 };
 
 /**
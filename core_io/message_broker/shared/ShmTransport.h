@@ -0,0 +1,446 @@
+/**
+ * @file examples/core_io/message_broker/shared/ShmTransport.h
+ * @example Message Broker - Shared-Memory Transport for Co-located Clients
+ * @brief Defines `broker::shm::Ring`, `broker::shm::Channel` and `broker::shm::Client`, the
+ *        shared-memory transport between the broker and clients running on the same host.
+ *
+ * @details
+ * A client of a broker started with `--shm PATH` connects to the Unix domain socket `PATH`.
+ * The broker answers with two file descriptors (`SCM_RIGHTS`), then the connection is only
+ * kept open so that each side notices when the other one exits:
+ * - A `memfd` holding two single-producer/single-consumer byte rings, one per direction.
+ * - An `eventfd` the broker signals when it writes to the client's ring while the client
+ *   is waiting for messages.
+ *
+ * The rings carry the frames of `BrokerProtocol` unchanged (8-byte `MessageHeader` followed
+ * by the payload), so both ends use the same message types as the TCP clients. Each side
+ * publishes a frame by advancing its write index after copying it, so a reader never sees
+ * a partial frame.
+ *
+ * The broker reads its ring from the core loop of the `ServerActor` that owns the session
+ * (`qb::ICallback`), so client-to-broker frames need no wakeup. A client blocks on the
+ * `eventfd` only after announcing it in the ring (`reader_waiting`), so the broker makes a
+ * system call only for a client that is actually asleep.
+ *
+ * Linux only (`memfd_create`, `eventfd`).
+ */
+
+#pragma once
+
+#include "Protocol.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <poll.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace broker::shm {
+
+/// Size of each ring when the broker does not choose one (power of two)
+constexpr std::size_t DEFAULT_RING_BYTES = std::size_t(1) << 20;
+
+/**
+ * @brief Control block of one ring, at the start of its region of the segment
+ *
+ * Indexes count bytes since the creation of the ring and never wrap; the position in the
+ * data area is `index & (capacity - 1)`. The indexes are on separate cache lines so that
+ * the writer and the reader do not invalidate each other's line on every frame.
+ */
+struct RingHeader {
+    alignas(64) std::atomic<uint64_t> head;            ///< Bytes written (writer only)
+    alignas(64) std::atomic<uint64_t> tail;            ///< Bytes read (reader only)
+    alignas(64) std::atomic<uint32_t> reader_waiting;  ///< 1 while the reader sleeps
+};
+
+/**
+ * @brief First bytes of the segment, written once by the broker
+ */
+struct SegmentHeader {
+    uint32_t magic;        ///< PROTOCOL_MAGIC, checked by the client
+    uint32_t ring_bytes;   ///< Data bytes of each ring
+};
+
+/**
+ * @brief View of one SPSC ring of frames in the shared segment
+ */
+class Ring {
+public:
+    static constexpr std::size_t HEADER_SIZE = sizeof(MessageHeader);
+
+    Ring() = default;
+    Ring(RingHeader* header, char* data, std::size_t capacity)
+        : _header(header), _data(data), _mask(capacity - 1) {}
+
+    std::size_t capacity() const { return _mask + 1; }
+
+    /// Largest payload a frame of this ring can carry
+    std::size_t maxPayload() const { return capacity() - HEADER_SIZE; }
+
+    bool empty() const {
+        return _header->head.load(std::memory_order_acquire) ==
+               _header->tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief true once the other end published inconsistent indexes or a malformed frame
+     *
+     * The indexes live in memory the other process can write. They are checked before use,
+     * and the ring stops reading and writing for good when they cannot be trusted.
+     */
+    bool corrupt() const { return _corrupt; }
+
+    /**
+     * @brief Writes one frame (writer side)
+     * @return false if the ring has no room for the frame, or is corrupt; nothing is written
+     */
+    bool write(MessageType type, std::string_view payload) {
+        if (_corrupt)
+            return false;
+        const std::size_t size = HEADER_SIZE + payload.size();
+        const uint64_t head = _header->head.load(std::memory_order_relaxed);
+        const uint64_t tail = _header->tail.load(std::memory_order_acquire);
+        const uint64_t used = head - tail;
+        if (used > capacity()) {  // the reader moved tail past head, or too far back
+            _corrupt = true;
+            return false;
+        }
+        if (capacity() - used < size)
+            return false;
+
+        const MessageHeader frame{PROTOCOL_MAGIC, PROTOCOL_VERSION, static_cast<uint8_t>(type),
+                                  static_cast<uint32_t>(payload.size())};
+        copyIn(head, &frame, HEADER_SIZE);
+        copyIn(head + HEADER_SIZE, payload.data(), payload.size());
+        _header->head.store(head + size, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Reads one frame (reader side)
+     * @return false if the ring is empty or corrupt (see corrupt())
+     */
+    bool read(Message& msg) {
+        if (_corrupt)
+            return false;
+        const uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+        const uint64_t head = _header->head.load(std::memory_order_acquire);
+        const uint64_t used = head - tail;
+        if (!used)
+            return false;
+        // Frames are published whole: less than a header, or more than the ring, is corrupt
+        if (used > capacity() || used < HEADER_SIZE) {
+            _corrupt = true;
+            return false;
+        }
+
+        MessageHeader frame;
+        copyOut(tail, &frame, HEADER_SIZE);
+        if (frame.magic != PROTOCOL_MAGIC || frame.version != PROTOCOL_VERSION ||
+            frame.length > maxPayload() || frame.length > used - HEADER_SIZE) {
+            _corrupt = true;
+            return false;
+        }
+        msg.type = static_cast<MessageType>(frame.type);
+        msg.payload.resize(frame.length);
+        copyOut(tail + HEADER_SIZE, msg.payload.data(), frame.length);
+        _header->tail.store(tail + HEADER_SIZE + frame.length, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Reader side: announces that the reader is about to sleep
+     * @return false if frames arrived meanwhile; the reader must not sleep then
+     */
+    bool prepareWait() {
+        _header->reader_waiting.store(1, std::memory_order_seq_cst);
+        if (!empty()) {
+            _header->reader_waiting.store(0, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /// Writer side, after write(): true if the reader sleeps and must be woken up
+    bool takeWaiter() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return _header->reader_waiting.load(std::memory_order_relaxed) &&
+               _header->reader_waiting.exchange(0, std::memory_order_acq_rel);
+    }
+
+private:
+    RingHeader* _header = nullptr;
+    char* _data = nullptr;
+    std::size_t _mask = 0;
+    bool _corrupt = false;
+
+    void copyIn(uint64_t index, const void* src, std::size_t size) {
+        const std::size_t pos = index & _mask;
+        const std::size_t first = std::min(size, capacity() - pos);
+        std::memcpy(_data + pos, src, first);
+        std::memcpy(_data, static_cast<const char*>(src) + first, size - first);
+    }
+
+    void copyOut(uint64_t index, void* dst, std::size_t size) const {
+        const std::size_t pos = index & _mask;
+        const std::size_t first = std::min(size, capacity() - pos);
+        std::memcpy(dst, _data + pos, first);
+        std::memcpy(static_cast<char*>(dst) + first, _data, size - first);
+    }
+};
+
+/**
+ * @brief Mapping of a shared segment and its eventfd, owned by either end
+ *
+ * Layout: `SegmentHeader`, then for each direction (client to broker, broker to client)
+ * a `RingHeader` followed by `ring_bytes` of data, each region 64-byte aligned.
+ */
+class Channel {
+public:
+    Channel() = default;
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+    Channel(Channel&& other) noexcept { *this = std::move(other); }
+    Channel& operator=(Channel&& other) noexcept {
+        std::swap(_base, other._base);
+        std::swap(_size, other._size);
+        std::swap(_memfd, other._memfd);
+        std::swap(_wakefd, other._wakefd);
+        std::swap(_to_broker, other._to_broker);
+        std::swap(_to_client, other._to_client);
+        return *this;
+    }
+    ~Channel() {
+        if (_base) ::munmap(_base, _size);
+        if (_memfd >= 0) ::close(_memfd);
+        if (_wakefd >= 0) ::close(_wakefd);
+    }
+
+    /**
+     * @brief Broker side: creates the segment and the eventfd
+     * @param ring_bytes Data bytes of each ring, rounded up to a power of two
+     * @return false on system error (errno is set)
+     */
+    bool create(std::size_t ring_bytes = DEFAULT_RING_BYTES) {
+        std::size_t capacity = 64;
+        while (capacity < ring_bytes) capacity <<= 1;
+        _memfd = ::memfd_create("qb-broker-shm", MFD_CLOEXEC);
+        _wakefd = ::eventfd(0, EFD_CLOEXEC);
+        if (_memfd < 0 || _wakefd < 0 || ::ftruncate(_memfd, segmentSize(capacity)) != 0)
+            return false;
+        if (!map(segmentSize(capacity)))
+            return false;
+        auto* segment = static_cast<SegmentHeader*>(_base);
+        segment->magic = PROTOCOL_MAGIC;
+        segment->ring_bytes = static_cast<uint32_t>(capacity);
+        setupRings(capacity);  // ftruncate zero-filled the ring headers
+        return true;
+    }
+
+    /**
+     * @brief Client side: maps a segment received from the broker
+     * @param memfd Segment, owned by the channel from now on
+     * @param wakefd Broker-to-client eventfd, owned by the channel from now on
+     * @return false if the segment cannot be mapped or is not a broker segment
+     */
+    bool attach(int memfd, int wakefd) {
+        _memfd = memfd;
+        _wakefd = wakefd;
+        SegmentHeader segment;
+        if (::pread(_memfd, &segment, sizeof(segment), 0) != static_cast<ssize_t>(sizeof(segment)) ||
+            segment.magic != PROTOCOL_MAGIC || !segment.ring_bytes ||
+            (segment.ring_bytes & (segment.ring_bytes - 1)))
+            return false;
+        if (!map(segmentSize(segment.ring_bytes)))
+            return false;
+        setupRings(segment.ring_bytes);
+        return true;
+    }
+
+    Ring& toBroker() { return _to_broker; }
+    Ring& toClient() { return _to_client; }
+    const Ring& toBroker() const { return _to_broker; }
+    const Ring& toClient() const { return _to_client; }
+    int memfd() const { return _memfd; }
+    int wakefd() const { return _wakefd; }
+
+    /// Broker side: wakes the client up if it sleeps on its ring
+    void notifyClient() {
+        if (_to_client.takeWaiter())
+            ::eventfd_write(_wakefd, 1);
+    }
+
+    /**
+     * @brief Client side: sleeps until the broker writes to the client's ring
+     * @param timeout_ms Maximum wait, -1 for none
+     * @return false on timeout
+     */
+    bool waitForBroker(int timeout_ms) {
+        if (!_to_client.prepareWait())
+            return true;
+        pollfd pfd{_wakefd, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, timeout_ms);
+        eventfd_t count;
+        if (ready > 0) ::eventfd_read(_wakefd, &count);
+        else _to_client.takeWaiter();  // timed out: nobody will clear the flag
+        return ready > 0 || !_to_client.empty();
+    }
+
+private:
+    void* _base = nullptr;
+    std::size_t _size = 0;
+    int _memfd = -1;
+    int _wakefd = -1;
+    Ring _to_broker;
+    Ring _to_client;
+
+    static constexpr std::size_t REGION = (sizeof(RingHeader) + 63) / 64 * 64;
+
+    static std::size_t segmentSize(std::size_t capacity) {
+        return 64 + 2 * (REGION + capacity);
+    }
+
+    bool map(std::size_t size) {
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _memfd, 0);
+        if (base == MAP_FAILED)
+            return false;
+        _base = base;
+        _size = size;
+        return true;
+    }
+
+    void setupRings(std::size_t capacity) {
+        char* region = static_cast<char*>(_base) + 64;
+        _to_broker = Ring(reinterpret_cast<RingHeader*>(region), region + REGION, capacity);
+        region += REGION + capacity;
+        _to_client = Ring(reinterpret_cast<RingHeader*>(region), region + REGION, capacity);
+    }
+};
+
+/**
+ * @brief Sends the segment and eventfd of a channel over a Unix domain socket
+ * @return false if the message could not be sent
+ */
+inline bool sendChannel(int socket, const Channel& channel) {
+    const int fds[2] = {channel.memfd(), channel.wakefd()};
+    char byte = 'S';
+    iovec iov{&byte, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    return ::sendmsg(socket, &msg, MSG_NOSIGNAL) == 1;
+}
+
+/**
+ * @brief Receives the segment and eventfd sent by sendChannel()
+ * @return false if the broker did not send two descriptors
+ */
+inline bool receiveChannel(int socket, Channel& channel) {
+    char byte;
+    iovec iov{&byte, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(2 * sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (::recvmsg(socket, &msg, MSG_CMSG_CLOEXEC) != 1)
+        return false;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(2 * sizeof(int)))
+        return false;
+    int fds[2];
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    return channel.attach(fds[0], fds[1]);
+}
+
+/**
+ * @brief Blocking client of the shared-memory transport
+ *
+ * Sends and receives `broker::Message`s like a TCP client, from one thread.
+ */
+class Client {
+public:
+    Client() = default;
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+    ~Client() { close(); }
+
+    /**
+     * @brief Connects to a broker's `--shm` socket and maps the channel it sends
+     * @param path Path of the Unix domain socket
+     * @return false if the broker cannot be reached
+     */
+    bool connect(const std::string& path) {
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path))
+            return false;
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        _control = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (_control < 0 || ::connect(_control, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            !receiveChannel(_control, _channel)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Writes a message to the broker's ring, waiting while it is full
+     * @return false if the payload can never fit in the ring, or the ring is corrupt
+     */
+    bool send(MessageType type, std::string_view payload) {
+        auto& ring = _channel.toBroker();
+        if (payload.size() > ring.maxPayload())
+            return false;
+        while (!ring.write(type, payload)) {
+            if (ring.corrupt())
+                return false;
+            ::sched_yield();  // The broker drains the ring from its core loop
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads the next message of the broker, sleeping until one arrives
+     * @param timeout_ms Maximum wait, -1 for none
+     * @return false on timeout, or if the broker's ring is corrupt
+     */
+    bool receive(Message& msg, int timeout_ms = -1) {
+        while (!_channel.toClient().read(msg)) {
+            if (_channel.toClient().corrupt() || !_channel.waitForBroker(timeout_ms))
+                return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (_control >= 0) ::close(_control);
+        _control = -1;
+        _channel = Channel();
+    }
+
+private:
+    int _control = -1;
+    Channel _channel;
+};
+
+} // namespace broker::shm
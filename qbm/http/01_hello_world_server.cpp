@@ -17,6 +17,7 @@
 #include <iostream>
 #include <qb/main.h>
 #include <http/http.h>
+#include <placement/Placement.h>
 
 // Define our HTTP server actor
 class HelloWorldServer : public qb::Actor
@@ -68,13 +69,16 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
         // Initialize the QB Actor framework
         qb::Main engine;
+        // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+        auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
         
-        // Add our HTTP server actor to core 0
-        auto server_id = engine.addActor<HelloWorldServer>(0);
+        // Add our HTTP server actor (default core 0)
+        auto server_id = engine.addActor<HelloWorldServer>(placement.core("http"));
+        placement.pin(engine);
         
         if (!server_id.is_valid()) {
             std::cerr << "Failed to create server actor" << std::endl;
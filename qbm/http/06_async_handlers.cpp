@@ -19,6 +19,7 @@
 #include <random>
 #include <qb/main.h>
 #include <http/http.h>
+#include <placement/Placement.h>
 
 // Async HTTP Server Actor demonstrating various async patterns
 class AsyncServerActor : public qb::Actor, public qb::http::Server<> {
@@ -481,13 +482,16 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
         // Initialize the QB Actor framework
         qb::Main engine;
+        // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+        auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
         
-        // Add our HTTP server actor to core 0
-        auto server_id = engine.addActor<AsyncServerActor>(0);
+        // Add our HTTP server actor (default core 0)
+        auto server_id = engine.addActor<AsyncServerActor>(placement.core("http"));
+        placement.pin(engine);
         
         if (!server_id.is_valid()) {
             std::cerr << "Failed to create server actor" << std::endl;
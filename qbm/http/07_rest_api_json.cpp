@@ -25,6 +25,7 @@
 #include <http/middleware/security_headers.h>
 #include <http/middleware/rate_limit.h>
 #include <http/middleware/error_handling.h>
+#include <placement/Placement.h>
 
 // Book model for our REST API
 struct Book {
@@ -751,10 +752,14 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     qb::Main engine;
+    // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+    auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
     
-    engine.addActor<RestApiServer>(0);
+    engine.addActor<RestApiServer>(placement.core("http"));
+    
+    placement.pin(engine);
     engine.start(false);
     engine.join();
     
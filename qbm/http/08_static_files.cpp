@@ -28,6 +28,7 @@
 #include <http/middleware/logging.h>
 #include <http/middleware/security_headers.h>
 #include <http/headers.h>  // Pour parse_header_attributes
+#include <placement/Placement.h>
 
 // File metadata structure
 struct FileMetadata {
@@ -672,11 +673,14 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     qb::Main engine;
+    // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+    auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
     
     // Add the static file server actor
-    engine.addActor<StaticFileServer>(0);
+    engine.addActor<StaticFileServer>(placement.core("http"));
+    placement.pin(engine);
     
     // Start the engine
     engine.start();
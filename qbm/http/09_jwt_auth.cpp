@@ -26,6 +26,7 @@
 #include <http/auth/manager.h>
 #include <http/auth/options.h>
 #include <http/auth/user.h>
+#include <placement/Placement.h>
 
 // Simple user database simulation
 struct UserAccount {
@@ -769,10 +770,14 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     qb::Main engine;
+    // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+    auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
     
-    engine.addActor<JwtAuthServer>(0);
+    engine.addActor<JwtAuthServer>(placement.core("http"));
+    
+    placement.pin(engine);
     engine.start();
     engine.join();
     
@@ -28,6 +28,7 @@
 #include <http/validation/schema_validator.h>
 #include <http/validation/parameter_validator.h>
 #include <http/validation/sanitizer.h>
+#include <placement/Placement.h>
 
 class ValidationServer : public qb::Actor, public qb::http::Server<> {
 private:
@@ -1093,10 +1094,14 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     qb::Main engine;
+    // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+    auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
     
-    engine.addActor<ValidationServer>(0);
+    engine.addActor<ValidationServer>(placement.core("http"));
+    
+    placement.pin(engine);
     engine.start();
     engine.join();
     
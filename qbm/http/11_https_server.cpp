@@ -25,6 +25,7 @@
 #include <http/middleware/logging.h>
 #include <http/middleware/security_headers.h>
 #include <http/middleware/error_handling.h>
+#include <placement/Placement.h>
 
 class HttpsServer : public qb::Actor, public qb::http::ssl::Server<> {
 private:
@@ -608,10 +609,14 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     qb::Main engine;
+    // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+    auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
     
-    engine.addActor<HttpsServer>(0);
+    engine.addActor<HttpsServer>(placement.core("http"));
+    
+    placement.pin(engine);
     engine.start();
     engine.join();
     
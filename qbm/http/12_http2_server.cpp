@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include <chrono>
 #include <random>
+#include <placement/Placement.h>
 
 using qb::json;
 
@@ -363,12 +364,15 @@ private:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
     // qb::io::log::setLevel(qb::io::log::Level::DEBUG);
     qb::Main engine;
+    // Server core, overridable with --place http=CORE or --placement FILE (common/placement)
+    auto placement = placement::Placement::fromArgs({{"http", 1, "0"}}, argc, argv);
     
     try {
-        engine.addActor<Http2StaticServer>(0);
+        engine.addActor<Http2StaticServer>(placement.core("http"));
+        placement.pin(engine);
         engine.start(false);
         engine.join();
         
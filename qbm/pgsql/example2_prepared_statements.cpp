@@ -72,7 +72,7 @@ private:
                            "email TEXT UNIQUE"
                            ");")
                 .prepare(PREPARE_INSERT_USER,
-                           "INSERT INTO users (name, email) VALUES ($1, $2) RETURNING id;",
+                           "INSERT INTO users (name, email) VALUES ($1, $2) RETURNING id, name, email;",
                            {qb::pg::oid::text, qb::pg::oid::text}) // Using lowercase oids as seen in some contexts
                 .prepare(PREPARE_SELECT_USER_BY_ID,
                            "SELECT id, name, email FROM users WHERE id = $1;",
@@ -97,80 +97,81 @@ private:
 
     void runApplicationLogic() {
         qb::io::cout() << "\nRunning application logic..." << std::endl;
-        
+
+        // The statements below are independent of each other, so they are all issued
+        // back-to-back on the connection and their results come back in order:
+        // the batch costs one network round-trip instead of one per statement.
         insertUser("Alice Wonderland", "alice@example.com");
-        // Chain a kill event after a delay to allow operations to finish for the example
-        // This is a simplistic way for an example to auto-terminate.
-        // In real apps, shutdown logic would be more robust.
-        qb::io::async::callback([this](){
-            insertUser("Bob The Builder", std::nullopt);
-            qb::io::async::callback([this](){
-                insertUser("Charlie Chaplin", "charlie@example.com");
-                 qb::io::async::callback([this](){
-                    selectUser(999); // Try selecting a non-existent user
-                    qb::io::async::callback([this](){
-                        qb::io::cout() << "Example operations complete. Signaling shutdown." << std::endl;
-                        this->push<qb::KillEvent>(this->id());
-                    }, 1.0); // Delay after last operation
-                }, 0.5);
-            }, 0.5);
-        }, 0.5);
+        insertUser("Bob The Builder", std::nullopt);
+        insertUser("Charlie Chaplin", "charlie@example.com");
+        selectUser(999); // Try selecting a non-existent user
+    }
+
+    // Called when one of the pipelined operations completes (successfully or not).
+    void operationDone() {
+        if (--_pending_operations == 0) {
+            qb::io::cout() << "Example operations complete. Signaling shutdown." << std::endl;
+            this->push<qb::KillEvent>(this->id());
+        }
+    }
+
+    void printUser(const qb::pg::results& res) {
+        const auto& row = res[0];
+        User user;
+        user.id = row["id"].as<int>();
+        user.name = row["name"].as<std::string>();
+        user.email = row["email"].as<std::optional<std::string>>();
+
+        qb::io::cout() << "Selected User ---- ID: " << user.id
+                      << ", Name: " << user.name
+                      << ", Email: " << (user.email ? user.email.value() : "N/A")
+                      << " ----" << std::endl;
     }
 
     void insertUser(const std::string& name, std::optional<std::string> email) {
         qb::io::cout() << "Attempting to insert user: " << name << ", Email: " << (email ? email.value() : "NULL") << std::endl;
-
-        _db_connection->begin(
-            [this, name, email](qb::pg::transaction& tr) {
-                tr.execute(PREPARE_INSERT_USER, {name, email},
-                    [this, name](qb::pg::transaction& /*tr_inner*/, qb::pg::results&& res) {
-                        if (!res.empty() && res[0].size() > 0) {
-                            int new_user_id = res[0][0].as<int>();
-                            qb::io::cout() << "Successfully inserted user '" << name << "' with ID: " << new_user_id << std::endl;
-                            selectUser(new_user_id); 
-                        } else {
-                             qb::io::cerr() << "Insert user '" << name << "' did not return an ID." << std::endl;
-                        }
-                    },
-                    [this, name](qb::pg::error::db_error const & err) { // Corrected error callback signature
-                        qb::io::cerr() << "Failed to insert user '" << name << "': " << err.what() << std::endl;
-                        qb::io::cerr() << "SQLSTATE: " << err.code << std::endl;
-                         if (std::string(err.code) == "23505") { // unique_violation
-                            qb::io::cerr() << "Detail: This might be due to a duplicate email." << std::endl;
-                        }
-                    }
-                );
+        ++_pending_operations;
+
+        // A single INSERT needs no explicit transaction, and RETURNING gives back the
+        // full row so no follow-up SELECT round-trip is needed.
+        _db_connection->execute(PREPARE_INSERT_USER, {name, email},
+            [this, name](qb::pg::results&& res) {
+                if (!res.empty() && res[0].size() > 0) {
+                    qb::io::cout() << "Successfully inserted user '" << name << "' with ID: " << res[0]["id"].as<int>() << std::endl;
+                    printUser(res);
+                } else {
+                     qb::io::cerr() << "Insert user '" << name << "' did not return an ID." << std::endl;
+                }
+                operationDone();
             },
             [this, name](qb::pg::error::db_error const & err) { // Corrected error callback signature
-                qb::io::cerr() << "Failed to begin transaction for inserting user '" << name << "': " << err.what() << std::endl;
+                qb::io::cerr() << "Failed to insert user '" << name << "': " << err.what() << std::endl;
                 qb::io::cerr() << "SQLSTATE: " << err.code << std::endl;
+                 if (std::string(err.code) == "23505") { // unique_violation
+                    qb::io::cerr() << "Detail: This might be due to a duplicate email." << std::endl;
+                }
+                operationDone();
             }
         );
     }
 
     void selectUser(int user_id) {
         qb::io::cout() << "Attempting to select user with ID: " << user_id << std::endl;
+        ++_pending_operations;
 
         _db_connection->execute(PREPARE_SELECT_USER_BY_ID, {user_id},
             [this, user_id](qb::pg::results&& res) { 
                 if (!res.empty()) {
-                    const auto& row = res[0];
-                    User user;
-                    user.id = row["id"].as<int>();
-                    user.name = row["name"].as<std::string>();
-                    user.email = row["email"].as<std::optional<std::string>>();
-
-                    qb::io::cout() << "Selected User ---- ID: " << user.id
-                                  << ", Name: " << user.name
-                                  << ", Email: " << (user.email ? user.email.value() : "N/A")
-                                  << " ----" << std::endl;
+                    printUser(res);
                 } else {
                     qb::io::cout() << "User with ID " << user_id << " not found." << std::endl;
                 }
+                operationDone();
             },
             [this, user_id](qb::pg::error::db_error const & err) { // Corrected error callback signature
                 qb::io::cerr() << "Failed to select user with ID " << user_id << ": " << err.what() << std::endl;
                 qb::io::cerr() << "SQLSTATE: " << err.code << std::endl;
+                operationDone();
             }
         );
     }
@@ -193,6 +194,7 @@ private:
     }
 
     std::unique_ptr<qb::pg::tcp::database> _db_connection;
+    int _pending_operations = 0;
 };
 
 int main(int argc, char* argv[]) {
@@ -14,6 +14,9 @@
 #include <limits> // For numeric_limits
 #include <iomanip> // For std::fixed, std::setprecision
 #include <cctype> // For std::isprint
+#include <chrono> // For the decode benchmark timings
+#include <tuple>
+#include <utility> // For std::index_sequence
 
 // IMPORTANT: Replace with your actual PostgreSQL connection string
 // Changed format to match working examples
@@ -47,6 +50,63 @@ const char* DATA_TYPES_TABLE_SQL =
 
 const char* PREPARE_INSERT_DATA_TYPES = "insert_data_types_stmt_v4";
 const char* PREPARE_SELECT_DATA_TYPES_BY_ID = "select_data_types_stmt_v4";
+const char* PREPARE_DECODE_SAMPLES = "decode_samples_stmt_v4";
+
+// Decode benchmark settings
+constexpr int DECODE_BENCH_ROWS = 100000; // Rows produced by generate_series
+constexpr int DECODE_BENCH_PASSES = 5;    // Decode passes over the same result set per strategy
+
+// --- Compile-time row-to-struct mapper ---
+
+template <typename T>
+struct member_pointer_traits;
+
+template <typename C, typename M>
+struct member_pointer_traits<M C::*> {
+    using class_type = C;
+    using member_type = M;
+};
+
+/**
+ * Maps a result row onto a struct at compile time. Each template argument is a
+ * pointer to the member that receives the field at the same position, e.g.
+ * RowMapper<&Sample::id, &Sample::price>::map(row) decodes column 0 as the type of
+ * Sample::id and column 1 as the type of Sample::price: no column-name lookup, no
+ * intermediate strings, and a type mismatch is a compile error on the struct side.
+ */
+template <auto First, auto... Rest>
+struct RowMapper {
+    using members = std::tuple<decltype(First), decltype(Rest)...>;
+    using type = typename member_pointer_traits<decltype(First)>::class_type;
+    static constexpr std::size_t field_count = 1 + sizeof...(Rest);
+
+    template <typename Row>
+    static type map(const Row& row) {
+        type out{};
+        assign(row, out, std::make_index_sequence<field_count>{});
+        return out;
+    }
+
+private:
+    template <typename Row, std::size_t... I>
+    static void assign(const Row& row, type& out, std::index_sequence<I...>) {
+        constexpr members pointers{First, Rest...};
+        ((out.*std::get<I>(pointers) =
+              row[I].template as<typename member_pointer_traits<std::tuple_element_t<I, members>>::member_type>()),
+         ...);
+    }
+};
+
+struct DecodedSample {
+    int id;
+    double price;
+    qb::Timestamp ts;
+    qb::uuid ref;
+    std::string amount; // NUMERIC is kept exact as text, as in the insert above
+};
+
+using DecodedSampleMapper = RowMapper<&DecodedSample::id, &DecodedSample::price, &DecodedSample::ts,
+                                      &DecodedSample::ref, &DecodedSample::amount>;
 
 class DataTypesActor : public qb::Actor {
 public:
@@ -108,6 +168,12 @@ private:
                 .prepare(PREPARE_SELECT_DATA_TYPES_BY_ID,
                          "SELECT * FROM data_types_test WHERE id = $1;",
                          {qb::pg::oid::int4})
+                .prepare(PREPARE_DECODE_SAMPLES,
+                         "SELECT g AS id, (g * 1.5)::float8 AS price, "
+                         "now() + g * interval '1 second' AS ts, md5(g::text)::uuid AS ref, "
+                         "(g / 7.0)::numeric(12, 3) AS amount "
+                         "FROM generate_series(1, $1) AS g;",
+                         {qb::pg::oid::int4})
                 .success([this](auto &) {
                     qb::io::cout() << "Data types schema and statements initialized." << std::endl;
                     insertAndSelectData();
@@ -235,8 +301,7 @@ private:
                 auto nullable_val = row["nullable_text_col"].as<std::optional<std::string>>();
                 qb::io::cout() << "Nullable Text: " << (nullable_val ? nullable_val.value() : "NULL") << std::endl;
                 
-                // Signal shutdown after we're done
-                qb::io::async::callback([this](){ this->push<qb::KillEvent>(this->id()); }, 0.5);
+                runDecodeBenchmark();
             },
             [this, id](qb::pg::error::db_error const & err) {
                 qb::io::cerr() << "Error selecting data types row ID " << id << ": " << err.what() << std::endl;
@@ -247,6 +312,72 @@ private:
         );
     }
 
+    // Fetches DECODE_BENCH_ROWS rows once, then times three ways of decoding them.
+    void runDecodeBenchmark() {
+        qb::io::cout() << "\n--- Decode Throughput Benchmark (" << DECODE_BENCH_ROWS << " rows x "
+                       << DECODE_BENCH_PASSES << " passes) ---" << std::endl;
+
+        _db_connection->execute(PREPARE_DECODE_SAMPLES, {DECODE_BENCH_ROWS},
+            [this](qb::pg::results&& res) {
+                const auto rows = res.size();
+                std::size_t checksum = 0;
+
+                // 1. By column name, every field materialized as a string
+                benchmarkDecode("by name, as<std::string>", rows, [&]() {
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        const auto& row = res[i];
+                        checksum += row["id"].as<std::string>().size() + row["price"].as<std::string>().size()
+                                  + row["ts"].as<std::string>().size() + row["ref"].as<std::string>().size()
+                                  + row["amount"].as<std::string>().size();
+                    }
+                });
+
+                // 2. By position, decoded straight into the target C++ types
+                benchmarkDecode("by index, typed as<T>", rows, [&]() {
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        const auto& row = res[i];
+                        checksum += static_cast<std::size_t>(row[0].as<int>())
+                                  + static_cast<std::size_t>(row[1].as<double>())
+                                  + static_cast<std::size_t>(row[2].as<qb::Timestamp>().count())
+                                  + (row[3].as<qb::uuid>().is_nil() ? 0u : 1u)
+                                  + row[4].as<std::string>().size();
+                    }
+                });
+
+                // 3. Compile-time RowMapper into a struct
+                benchmarkDecode("RowMapper<DecodedSample>", rows, [&]() {
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        const auto sample = DecodedSampleMapper::map(res[i]);
+                        checksum += static_cast<std::size_t>(sample.id) + sample.amount.size();
+                    }
+                });
+
+                qb::io::cout() << "(checksum " << checksum << ")" << std::endl;
+                this->push<qb::KillEvent>(this->id());
+            },
+            [this](qb::pg::error::db_error const & err) {
+                qb::io::cerr() << "Decode benchmark query failed: " << err.what() << std::endl;
+                qb::io::cerr() << "SQLSTATE: " << err.code << std::endl;
+                this->push<qb::KillEvent>(this->id());
+            }
+        );
+    }
+
+    template <typename Func>
+    void benchmarkDecode(const char* strategy, std::size_t rows, Func&& decode_pass) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < DECODE_BENCH_PASSES; ++pass)
+            decode_pass();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const double decoded_rows = static_cast<double>(rows) * DECODE_BENCH_PASSES;
+        qb::io::cout() << std::left << std::setw(28) << strategy << std::right
+                       << std::fixed << std::setprecision(0) << decoded_rows / elapsed.count() << " rows/sec, "
+                       << std::setprecision(1)
+                       << elapsed.count() * 1e9 / (decoded_rows * DecodedSampleMapper::field_count) << " ns/field"
+                       << std::endl;
+    }
+
     void cleanupDatabase() {
         qb::io::cout() << "Cleaning up data_types_test table..." << std::endl;
         auto status = _db_connection->begin(
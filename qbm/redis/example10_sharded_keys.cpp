@@ -0,0 +1,429 @@
+/**
+ * @file examples/qbm/redis/example10_sharded_keys.cpp
+ * @example qbm-redis: Key Sharding Across Several Redis Nodes
+ *
+ * @brief This example spreads keys over several standalone redis-server instances
+ * (e.g. local processes on ports 6379, 6380, 6381) instead of the single `REDIS_URI`
+ * used by the other examples, so caches and queues can scale out with node count.
+ *
+ * @details
+ * The building blocks are:
+ * 1.  `hash_slot(key)`:
+ *     -   The Redis Cluster key-to-slot function: CRC16 (XMODEM) of the key modulo 16384,
+ *         honoring `{hash tags}` so related keys can be forced onto the same node.
+ *     -   Slots are assigned to nodes in contiguous, equally sized ranges.
+ * 2.  `HashRing`:
+ *     -   Consistent hashing with virtual nodes for standalone deployments: adding a node
+ *         only moves about 1/N of the keys.
+ * 3.  `ShardedRedis`:
+ *     -   One `qb::redis::tcp::client` per node; every command is routed to the node that
+ *         owns its key and sent with the callback-based asynchronous API, so each node
+ *         connection is an independent pipeline.
+ *     -   Multi-key commands (`mget`, `mset`, `del`) are split by owning node into one
+ *         `MGET` / `MSET` / `DEL` per node, issued on all nodes at once, and the per-node
+ *         replies are reassembled in the caller's key order before the single completion
+ *         callback fires.
+ * 4.  `ShardBenchActor` (one per core):
+ *     -   Keeps a window of SET / GET / 8-key MGET operations in flight and reports ops/sec
+ *         and how the keys were distributed across nodes.
+ *
+ * Run it with one, two, three... node URIs to see throughput scale with the node count.
+ *
+ * QB/QBM Redis Features Demonstrated:
+ * - `qb::redis::tcp::client` against several servers from one actor.
+ * - Asynchronous commands with reply callbacks (`get(cb, key)`, `set(cb, key, value)`,
+ *   `mget(cb, keys)`, `mset(cb, pairs)`, `del(cb, keys)`).
+ * - `qb::Actor`, `qb::Main`, `qb::Event`, multi-core deployment.
+ */
+
+#include <redis/redis.h>
+#include <qb/actor.h>
+#include <qb/main.h>
+#include <qb/io.h>
+#include <qb/io/async.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Default nodes when none are given on the command line
+const char* DEFAULT_NODES = "tcp://localhost:6379,tcp://localhost:6380,tcp://localhost:6381";
+
+constexpr uint16_t CLUSTER_SLOTS = 16384;
+
+// CRC16-CCITT (XMODEM), the checksum Redis Cluster uses for key slots
+uint16_t crc16(const char* data, std::size_t len) {
+    uint16_t crc = 0;
+    for (std::size_t i = 0; i < len; ++i) {
+        crc ^= static_cast<uint16_t>(static_cast<unsigned char>(data[i])) << 8;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+// Redis Cluster HASH_SLOT: only the part between the first '{' and the next '}' is hashed, if non-empty
+uint16_t hash_slot(const std::string& key) {
+    const auto open = key.find('{');
+    if (open != std::string::npos) {
+        const auto close = key.find('}', open + 1);
+        if (close != std::string::npos && close != open + 1)
+            return crc16(key.data() + open + 1, close - open - 1) % CLUSTER_SLOTS;
+    }
+    return crc16(key.data(), key.size()) % CLUSTER_SLOTS;
+}
+
+uint64_t fnv1a64(const std::string& data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Consistent hash ring with virtual nodes
+class HashRing {
+private:
+    std::map<uint64_t, std::size_t> _ring;
+
+public:
+    HashRing(std::size_t nodes, std::size_t virtual_nodes = 160) {
+        for (std::size_t node = 0; node < nodes; ++node)
+            for (std::size_t v = 0; v < virtual_nodes; ++v)
+                _ring.emplace(fnv1a64("node-" + std::to_string(node) + "#" + std::to_string(v)), node);
+    }
+
+    std::size_t node_for(const std::string& key) const {
+        auto it = _ring.lower_bound(fnv1a64(key));
+        return it == _ring.end() ? _ring.begin()->second : it->second;
+    }
+};
+
+enum class ShardingMode { HASH_SLOT, CONSISTENT_HASH };
+
+// Routes keys to nodes and splits multi-key commands into per-node pipelines
+class ShardedRedis {
+private:
+    std::vector<std::unique_ptr<qb::redis::tcp::client>> _nodes;
+    ShardingMode _mode;
+    HashRing _ring;
+    std::vector<uint64_t> _commands_per_node;
+
+public:
+    using MGetCallback = std::function<void(bool, std::vector<std::optional<std::string>>&&)>;
+    using DoneCallback = std::function<void(bool)>;
+
+    ShardedRedis(const std::vector<std::string>& uris, ShardingMode mode)
+        : _mode(mode), _ring(uris.size()), _commands_per_node(uris.size(), 0) {
+        for (const auto& uri : uris)
+            _nodes.push_back(std::make_unique<qb::redis::tcp::client>(qb::io::uri(uri)));
+    }
+
+    bool connect() {
+        for (std::size_t i = 0; i < _nodes.size(); ++i) {
+            if (!_nodes[i]->connect()) {
+                qb::io::cerr() << "ShardedRedis: failed to connect to node #" << i << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t node_for(const std::string& key) const {
+        if (_mode == ShardingMode::HASH_SLOT)
+            return static_cast<std::size_t>(hash_slot(key)) * _nodes.size() / CLUSTER_SLOTS;
+        return _ring.node_for(key);
+    }
+
+    const std::vector<uint64_t>& commands_per_node() const { return _commands_per_node; }
+
+    void set(const std::string& key, const std::string& value, DoneCallback done) {
+        auto& node = route(key);
+        node.set([done = std::move(done)](auto&& reply) { done(reply.ok()); }, key, value);
+    }
+
+    void get(const std::string& key, std::function<void(bool, std::optional<std::string>&&)> done) {
+        auto& node = route(key);
+        node.get([done = std::move(done)](auto&& reply) {
+            const auto& value = reply.result();
+            done(reply.ok(), value ? std::optional<std::string>(std::string(*value)) : std::nullopt);
+        }, key);
+    }
+
+    // MGET across nodes: one MGET per node, results reassembled in key order
+    void mget(const std::vector<std::string>& keys, MGetCallback done) {
+        struct Gather {
+            std::vector<std::optional<std::string>> values;
+            std::size_t remaining;
+            bool ok = true;
+            MGetCallback done;
+        };
+        const auto groups = group_by_node(keys.size(), [&](std::size_t i) -> const std::string& { return keys[i]; });
+        auto gather = std::make_shared<Gather>(Gather{std::vector<std::optional<std::string>>(keys.size()),
+                                                      nodes_used(groups), true, std::move(done)});
+        if (!gather->remaining) {
+            gather->done(true, std::move(gather->values));
+            return;
+        }
+        for (std::size_t node = 0; node < groups.size(); ++node) {
+            const auto& positions = groups[node];
+            if (positions.empty())
+                continue;
+            std::vector<std::string> node_keys;
+            node_keys.reserve(positions.size());
+            for (auto i : positions)
+                node_keys.push_back(keys[i]);
+            ++_commands_per_node[node];
+            _nodes[node]->mget([gather, positions](auto&& reply) {
+                const auto& values = reply.result();
+                gather->ok = gather->ok && reply.ok() && values.size() == positions.size();
+                for (std::size_t j = 0; j < values.size() && j < positions.size(); ++j)
+                    if (values[j])
+                        gather->values[positions[j]] = std::string(*values[j]);
+                if (--gather->remaining == 0)
+                    gather->done(gather->ok, std::move(gather->values));
+            }, node_keys);
+        }
+    }
+
+    // MSET across nodes: one MSET per node, completes when every node has acknowledged its share
+    void mset(const std::vector<std::pair<std::string, std::string>>& pairs, DoneCallback done) {
+        const auto groups = group_by_node(pairs.size(), [&](std::size_t i) -> const std::string& { return pairs[i].first; });
+        forEachNode(groups, std::move(done), [&](std::size_t node, const std::vector<std::size_t>& positions, auto on_reply) {
+            std::vector<std::pair<std::string, std::string>> node_pairs;
+            node_pairs.reserve(positions.size());
+            for (auto i : positions)
+                node_pairs.push_back(pairs[i]);
+            _nodes[node]->mset(std::move(on_reply), node_pairs);
+        });
+    }
+
+    // DEL across nodes: one multi-key DEL per node
+    void del(const std::vector<std::string>& keys, DoneCallback done) {
+        const auto groups = group_by_node(keys.size(), [&](std::size_t i) -> const std::string& { return keys[i]; });
+        forEachNode(groups, std::move(done), [&](std::size_t node, const std::vector<std::size_t>& positions, auto on_reply) {
+            std::vector<std::string> node_keys;
+            node_keys.reserve(positions.size());
+            for (auto i : positions)
+                node_keys.push_back(keys[i]);
+            _nodes[node]->del(std::move(on_reply), node_keys);
+        });
+    }
+
+private:
+    qb::redis::tcp::client& route(const std::string& key) {
+        const auto node = node_for(key);
+        ++_commands_per_node[node];
+        return *_nodes[node];
+    }
+
+    // Positions of the keys owned by each node, in the caller's order
+    template <typename KeyAt>
+    std::vector<std::vector<std::size_t>> group_by_node(std::size_t count, KeyAt&& key_at) const {
+        std::vector<std::vector<std::size_t>> groups(_nodes.size());
+        for (std::size_t i = 0; i < count; ++i)
+            groups[node_for(key_at(i))].push_back(i);
+        return groups;
+    }
+
+    static std::size_t nodes_used(const std::vector<std::vector<std::size_t>>& groups) {
+        std::size_t used = 0;
+        for (const auto& positions : groups)
+            used += !positions.empty();
+        return used;
+    }
+
+    // Issues one command per node that owns keys; `done` fires once all of them replied
+    template <typename Issue>
+    void forEachNode(const std::vector<std::vector<std::size_t>>& groups, DoneCallback done, Issue&& issue) {
+        struct Countdown {
+            std::size_t remaining;
+            bool ok;
+            DoneCallback done;
+        };
+        auto countdown = std::make_shared<Countdown>(Countdown{nodes_used(groups), true, std::move(done)});
+        if (!countdown->remaining) {
+            countdown->done(true);
+            return;
+        }
+        for (std::size_t node = 0; node < groups.size(); ++node) {
+            if (groups[node].empty())
+                continue;
+            ++_commands_per_node[node];
+            issue(node, groups[node], [countdown](auto&& reply) {
+                countdown->ok = countdown->ok && reply.ok();
+                if (--countdown->remaining == 0)
+                    countdown->done(countdown->ok);
+            });
+        }
+    }
+};
+
+struct ShardReportEvent : qb::Event {
+    uint64_t ops;
+    uint64_t errors;
+    std::vector<uint64_t> commands_per_node;
+
+    ShardReportEvent(uint64_t o, uint64_t e, std::vector<uint64_t> per_node)
+        : ops(o), errors(e), commands_per_node(std::move(per_node)) {}
+};
+
+// Drives SET / GET / MGET traffic through a ShardedRedis
+class ShardBenchActor : public qb::Actor {
+private:
+    ShardedRedis _redis;
+    qb::ActorId _reporter;
+    std::size_t _window;
+    double _duration;
+    bool _running = true;
+    uint64_t _issued = 0;
+    uint64_t _ops = 0;
+    uint64_t _errors = 0;
+
+public:
+    ShardBenchActor(std::vector<std::string> uris, ShardingMode mode, qb::ActorId reporter,
+                    std::size_t window, double duration)
+        : _redis(uris, mode), _reporter(reporter), _window(window), _duration(duration) {}
+
+    bool onInit() override {
+        registerEvent<qb::KillEvent>(*this);
+        if (!_redis.connect())
+            return false;
+
+        // Seed the keys read by GET/MGET so the reads hit
+        std::vector<std::pair<std::string, std::string>> seed;
+        for (int i = 0; i < 1000; ++i)
+            seed.emplace_back(key(i), "value-" + std::to_string(i));
+        _redis.mset(seed, [this](bool ok) {
+            if (!ok)
+                qb::io::cerr() << "ShardBench: seeding failed" << std::endl;
+            for (std::size_t i = 0; i < _window; ++i)
+                issue();
+            qb::io::async::callback([this]() {
+                _running = false;
+                push<ShardReportEvent>(_reporter, _ops, _errors, _redis.commands_per_node());
+            }, _duration);
+        });
+        return true;
+    }
+
+    void on(const qb::KillEvent&) {
+        kill();
+    }
+
+private:
+    std::string key(uint64_t i) const {
+        return "shard:" + std::to_string(getIndex()) + ":" + std::to_string(i % 1000);
+    }
+
+    void done(bool ok) {
+        ok ? ++_ops : ++_errors;
+        if (_running)
+            issue();
+    }
+
+    void issue() {
+        const auto n = ++_issued;
+        switch (n % 4) {
+            case 0: {
+                std::vector<std::string> keys;
+                for (uint64_t k = 0; k < 8; ++k)
+                    keys.push_back(key(n * 7 + k));
+                _redis.mget(keys, [this](bool ok, std::vector<std::optional<std::string>>&&) { done(ok); });
+                break;
+            }
+            case 1:
+                _redis.set(key(n), std::to_string(n), [this](bool ok) { done(ok); });
+                break;
+            default:
+                _redis.get(key(n), [this](bool ok, std::optional<std::string>&&) { done(ok); });
+                break;
+        }
+    }
+};
+
+class ShardReporterActor : public qb::Actor {
+private:
+    std::size_t _expected;
+    std::size_t _received = 0;
+    double _duration;
+    uint64_t _ops = 0;
+    uint64_t _errors = 0;
+    std::vector<uint64_t> _per_node;
+
+public:
+    ShardReporterActor(std::size_t actors, std::size_t nodes, double duration)
+        : _expected(actors), _duration(duration), _per_node(nodes, 0) {}
+
+    bool onInit() override {
+        registerEvent<ShardReportEvent>(*this);
+        return true;
+    }
+
+    void on(const ShardReportEvent& event) {
+        _ops += event.ops;
+        _errors += event.errors;
+        for (std::size_t i = 0; i < _per_node.size() && i < event.commands_per_node.size(); ++i)
+            _per_node[i] += event.commands_per_node[i];
+        if (++_received < _expected)
+            return;
+
+        auto cout = qb::io::cout();
+        cout << "\n=== Sharded Redis benchmark (" << _per_node.size() << " node(s)) ===" << std::endl
+             << "Operations : " << _ops << " (" << _errors << " errors)" << std::endl
+             << "Throughput : " << static_cast<uint64_t>(_ops / _duration) << " ops/sec" << std::endl
+             << "Commands per node:";
+        for (std::size_t i = 0; i < _per_node.size(); ++i)
+            cout << " #" << i << "=" << _per_node[i];
+        cout << std::endl;
+        broadcast<qb::KillEvent>();
+        kill();
+    }
+};
+
+std::vector<std::string> split_uris(const std::string& list) {
+    std::vector<std::string> uris;
+    std::stringstream ss(list);
+    std::string uri;
+    while (std::getline(ss, uri, ','))
+        if (!uri.empty())
+            uris.push_back(uri);
+    return uris;
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: example10_sharded_keys [node_uri,node_uri,...] [slot|ring] [cores] [seconds]
+    const auto uris = split_uris(argc > 1 ? argv[1] : DEFAULT_NODES);
+    const auto mode = (argc > 2 && std::string(argv[2]) == "ring") ? ShardingMode::CONSISTENT_HASH : ShardingMode::HASH_SLOT;
+    const std::size_t cores = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 2;
+    const double duration = argc > 4 ? std::strtod(argv[4], nullptr) : 5.0;
+    constexpr std::size_t WINDOW = 64; // Operations in flight per actor
+
+    if (uris.empty() || !cores) {
+        qb::io::cerr() << "No Redis node given" << std::endl;
+        return 1;
+    }
+
+    // Initialize the async system
+    qb::io::async::init();
+    qb::io::cout() << "Sharding " << (mode == ShardingMode::HASH_SLOT ? "by hash slot" : "by consistent hash")
+                   << " across " << uris.size() << " node(s)" << std::endl;
+
+    qb::Main engine;
+    const auto reporter = engine.addActor<ShardReporterActor>(0, cores, uris.size(), duration);
+    for (std::size_t core = 0; core < cores; ++core)
+        engine.addActor<ShardBenchActor>(static_cast<qb::CoreId>(core), uris, mode, reporter, WINDOW, duration);
+
+    engine.start();
+    engine.join();
+
+    qb::io::cout() << "Sharded keys example finished." << std::endl;
+    return engine.hasError() ? 1 : 0;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file examples/qbm/redis/example11_pubsub_fanout.cpp
+ * @example qbm-redis: Per-Core Pub/Sub Hub with Local Fan-Out
+ *
+ * @brief In `example5_pubsub_example.cpp` every `SubscriberActor` owns a `cb_consumer`
+ * connection, so N local subscribers of one channel receive N copies over N sockets.
+ * This example puts one subscriber connection on each core and fans messages out to the
+ * interested local actors as shared, immutable payloads.
+ *
+ * @details
+ * The system is composed of the following actors:
+ * 1.  `PubSubHubActor` (one per core):
+ *     -   Owns the core's only `qb::redis::tcp::cb_consumer`.
+ *     -   Subscribes to a channel (or pattern) on Redis once, when its first local subscriber
+ *         arrives, and unsubscribes when the last one leaves (reference counted).
+ *     -   Pattern subscriptions are matched locally with a Redis-compatible glob matcher:
+ *         for each publication the hub computes all local recipients (exact channel
+ *         subscribers plus every actor whose pattern matches the channel) and delivers
+ *         exactly one copy to each, even though Redis sends one copy per matching
+ *         subscription of the connection.
+ *     -   The payload is allocated once per publication and shared by every recipient
+ *         (`std::shared_ptr<const PubSubPayload>`), never copied per actor.
+ * 2.  `LocalSubscriberActor` (many per core):
+ *     -   Sends a `HubSubscribeEvent` to the hub of its core and counts the
+ *         `HubMessageEvent`s it receives.
+ * 3.  `PublisherActor`:
+ *     -   Publishes a burst of messages to exact and pattern-matched channels, then stops the
+ *         system; each hub reports how many publications it fanned out into how many deliveries.
+ *
+ * QB/QBM Redis Features Demonstrated:
+ * - `qb::redis::tcp::cb_consumer` with `subscribe()`, `psubscribe()`, `unsubscribe()`,
+ *   `punsubscribe()`, and a message callback.
+ * - `qb::redis::tcp::client::publish()`.
+ * - `qb::Actor`, `qb::Main`, `qb::Event`, shared immutable event payloads, multi-core deployment.
+ */
+
+#include <redis/redis.h>
+#include <qb/actor.h>
+#include <qb/main.h>
+#include <qb/io.h>
+#include <qb/io/async.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Redis Configuration - must be in initializer list format
+#define REDIS_URI {"tcp://localhost:6379"}
+
+/**
+ * Redis-compatible glob matching (the rules of PSUBSCRIBE / KEYS):
+ * `*` any sequence, `?` any character, `[abc]`, `[^abc]`, `[a-z]` classes, `\x` escapes.
+ */
+bool glob_match(const char* pattern, const char* string) {
+    while (*pattern) {
+        switch (*pattern) {
+            case '*':
+                while (pattern[1] == '*')
+                    ++pattern;
+                if (!pattern[1])
+                    return true;
+                for (; *string; ++string)
+                    if (glob_match(pattern + 1, string))
+                        return true;
+                return false;
+            case '?':
+                if (!*string)
+                    return false;
+                ++string;
+                break;
+            case '[': {
+                if (!*string)
+                    return false;
+                ++pattern;
+                const bool negate = *pattern == '^';
+                if (negate)
+                    ++pattern;
+                bool matched = false;
+                while (*pattern && *pattern != ']') {
+                    if (*pattern == '\\' && pattern[1]) {
+                        ++pattern;
+                        matched |= *pattern == *string;
+                    } else if (pattern[1] == '-' && pattern[2] && pattern[2] != ']') {
+                        char lo = pattern[0], hi = pattern[2];
+                        if (lo > hi)
+                            std::swap(lo, hi);
+                        matched |= *string >= lo && *string <= hi;
+                        pattern += 2;
+                    } else {
+                        matched |= *pattern == *string;
+                    }
+                    ++pattern;
+                }
+                if (matched == negate)
+                    return false;
+                if (!*pattern)
+                    return false; // Unterminated class
+                ++string;
+                break;
+            }
+            case '\\':
+                if (pattern[1])
+                    ++pattern;
+                [[fallthrough]];
+            default:
+                if (*pattern != *string)
+                    return false;
+                ++string;
+                break;
+        }
+        ++pattern;
+    }
+    return !*string;
+}
+
+// One publication, shared by every local recipient
+struct PubSubPayload {
+    std::string channel;
+    std::string message;
+};
+
+// Local actor -> hub
+struct HubSubscribeEvent : qb::Event {
+    std::string topic; // Channel name, or glob pattern when `pattern` is set
+    bool pattern;
+    HubSubscribeEvent(std::string t, bool p) : topic(std::move(t)), pattern(p) {}
+};
+
+struct HubUnsubscribeEvent : qb::Event {
+    std::string topic;
+    bool pattern;
+    HubUnsubscribeEvent(std::string t, bool p) : topic(std::move(t)), pattern(p) {}
+};
+
+// Hub -> local actor
+struct HubMessageEvent : qb::Event {
+    std::shared_ptr<const PubSubPayload> payload;
+    explicit HubMessageEvent(std::shared_ptr<const PubSubPayload> p) : payload(std::move(p)) {}
+};
+
+// Per-core hub: one Redis subscriber connection, local fan-out
+class PubSubHubActor : public qb::Actor {
+private:
+    qb::redis::tcp::cb_consumer _consumer{REDIS_URI, [this](auto&& msg) { onRedisMessage(msg); }};
+    std::unordered_map<std::string, std::vector<qb::ActorId>> _channels;
+    std::map<std::string, std::vector<qb::ActorId>> _patterns; // Ordered: the smallest match is canonical
+    uint64_t _publications = 0;
+    uint64_t _deliveries = 0;
+
+public:
+    bool onInit() override {
+        registerEvent<HubSubscribeEvent>(*this);
+        registerEvent<HubUnsubscribeEvent>(*this);
+        registerEvent<qb::KillEvent>(*this);
+
+        if (!_consumer.connect()) {
+            qb::io::cerr() << "PubSubHub: failed to connect to Redis" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void on(const HubSubscribeEvent& event) {
+        auto& subscribers = event.pattern ? _patterns[event.topic] : _channels[event.topic];
+        if (subscribers.empty()) {
+            // First local subscriber: the only remote subscription for this topic on this core
+            if (event.pattern)
+                _consumer.psubscribe(event.topic);
+            else
+                _consumer.subscribe(event.topic);
+        }
+        subscribers.push_back(event.getSource());
+    }
+
+    void on(const HubUnsubscribeEvent& event) {
+        if (event.pattern)
+            release(_patterns, event.topic, event.getSource(), true);
+        else
+            release(_channels, event.topic, event.getSource(), false);
+    }
+
+    void on(const qb::KillEvent&) {
+        qb::io::cout() << "PubSubHub [" << id() << "] core " << getIndex() << ": " << _publications
+                       << " publications fanned out into " << _deliveries << " local deliveries" << std::endl;
+        kill();
+    }
+
+private:
+    template <typename Map>
+    void release(Map& topics, const std::string& topic, qb::ActorId subscriber, bool pattern) {
+        auto it = topics.find(topic);
+        if (it == topics.end())
+            return;
+        auto& list = it->second;
+        list.erase(std::remove(list.begin(), list.end(), subscriber), list.end());
+        if (list.empty()) {
+            topics.erase(it);
+            if (pattern)
+                _consumer.punsubscribe(topic);
+            else
+                _consumer.unsubscribe(topic);
+        }
+    }
+
+    // The publication reaches this connection once per matching remote subscription:
+    // only the canonical copy is fanned out (the plain message if the channel itself is
+    // subscribed, otherwise the copy of the smallest matching pattern).
+    template <typename Message>
+    void onRedisMessage(const Message& msg) {
+        const std::string channel(msg.channel);
+        const std::string via_pattern(msg.pattern);
+
+        const auto exact = _channels.find(channel);
+        std::vector<const std::vector<qb::ActorId>*> pattern_matches;
+        const std::string* canonical_pattern = nullptr;
+        for (const auto& [pattern, subscribers] : _patterns) {
+            if (glob_match(pattern.c_str(), channel.c_str())) {
+                if (!canonical_pattern)
+                    canonical_pattern = &pattern;
+                pattern_matches.push_back(&subscribers);
+            }
+        }
+
+        const bool canonical = exact != _channels.end()
+            ? via_pattern.empty()
+            : (canonical_pattern && via_pattern == *canonical_pattern);
+        if (!canonical)
+            return;
+
+        auto payload = std::make_shared<const PubSubPayload>(PubSubPayload{channel, std::string(msg.message)});
+        ++_publications;
+
+        std::set<qb::ActorId> delivered;
+        auto deliver = [&](const std::vector<qb::ActorId>& subscribers) {
+            for (const auto& subscriber : subscribers) {
+                if (delivered.insert(subscriber).second) {
+                    push<HubMessageEvent>(subscriber, payload);
+                    ++_deliveries;
+                }
+            }
+        };
+        if (exact != _channels.end())
+            deliver(exact->second);
+        for (const auto* subscribers : pattern_matches)
+            deliver(*subscribers);
+    }
+};
+
+// Subscribes through the hub of its core
+class LocalSubscriberActor : public qb::Actor {
+private:
+    qb::ActorId _hub;
+    std::string _topic;
+    bool _pattern;
+    uint64_t _received = 0;
+
+public:
+    LocalSubscriberActor(qb::ActorId hub, std::string topic, bool pattern)
+        : _hub(hub), _topic(std::move(topic)), _pattern(pattern) {}
+
+    bool onInit() override {
+        registerEvent<HubMessageEvent>(*this);
+        registerEvent<qb::KillEvent>(*this);
+        push<HubSubscribeEvent>(_hub, _topic, _pattern);
+        return true;
+    }
+
+    void on(const HubMessageEvent&) {
+        ++_received;
+    }
+
+    void on(const qb::KillEvent&) {
+        push<HubUnsubscribeEvent>(_hub, _topic, _pattern);
+        kill();
+    }
+};
+
+// Publishes a burst, then stops the system once the deliveries have drained
+class PublisherActor : public qb::Actor {
+private:
+    qb::redis::tcp::client _redis{REDIS_URI};
+    std::size_t _messages;
+
+public:
+    explicit PublisherActor(std::size_t messages) : _messages(messages) {}
+
+    bool onInit() override {
+        registerEvent<qb::KillEvent>(*this);
+        if (!_redis.connect()) {
+            qb::io::cerr() << "Publisher failed to connect to Redis" << std::endl;
+            return false;
+        }
+        // Give the hubs time to establish their subscriptions
+        qb::io::async::callback([this]() { publish(); }, 1.0);
+        return true;
+    }
+
+    void on(const qb::KillEvent&) {
+        kill();
+    }
+
+private:
+    void publish() {
+        static const char* channels[] = {"news", "sensor.temperature", "sensor.humidity"};
+        for (std::size_t i = 0; i < _messages; ++i)
+            _redis.publish(channels[i % 3], "message #" + std::to_string(i));
+        qb::io::cout() << "Published " << _messages << " messages" << std::endl;
+
+        // Each hub prints its publication and delivery counts when it stops
+        qb::io::async::callback([this]() {
+            broadcast<qb::KillEvent>();
+            kill();
+        }, 1.0);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    // Usage: example11_pubsub_fanout [cores] [subscribers_per_core] [messages]
+    const std::size_t cores = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2;
+    const std::size_t subscribers_per_core = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    const std::size_t messages = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 300;
+
+    // Initialize the async system
+    qb::io::async::init();
+    qb::io::cout() << "Starting Redis Pub/Sub fan-out example: " << cores << " core(s), "
+                   << subscribers_per_core << " local subscribers per core, "
+                   << cores << " Redis subscriber connection(s) instead of " << cores * subscribers_per_core << std::endl;
+
+    qb::Main engine;
+    engine.addActor<PublisherActor>(0, messages);
+    for (std::size_t core = 0; core < cores; ++core) {
+        const auto core_id = static_cast<qb::CoreId>(core);
+        const auto hub = engine.addActor<PubSubHubActor>(core_id);
+        for (std::size_t s = 0; s < subscribers_per_core; ++s) {
+            // A third of the subscribers use a pattern, the rest an exact channel
+            if (s % 3 == 0)
+                engine.addActor<LocalSubscriberActor>(core_id, hub, "sensor.*", true);
+            else if (s % 3 == 1)
+                engine.addActor<LocalSubscriberActor>(core_id, hub, "news", false);
+            else
+                engine.addActor<LocalSubscriberActor>(core_id, hub, "sensor.temperature", false);
+        }
+    }
+
+    engine.start();
+    engine.join();
+
+    qb::io::cout() << "Redis Pub/Sub fan-out example completed" << std::endl;
+    return engine.hasError() ? 1 : 0;
+}
@@ -16,21 +16,26 @@
  *     -   Caches the result using `_redis.setex()` with a TTL.
  *     -   Atomically increments its processing metrics in a Redis Hash ("worker:metrics") using a Lua script via `_redis.eval()`.
  *     -   Publishes a job completion message to a Redis Pub/Sub channel ("job:completed") using `_redis.publish()`.
- *     -   Logs its significant actions (init, job completion, shutdown) to a Redis Stream ("system:logs") using `_redis.xadd()`.
+ *     -   Logs its significant actions (init, job completion, shutdown) as `LogEvent`s to the `LogShipperActor` of its core.
  * 2.  `CacheManagerActor`:
  *     -   Intended to manage cache entries (set with TTL, delete).
  *     -   Handles `CacheEvent`s for SET and DELETE operations.
  *     -   Publishes cache update/invalidation notifications to Pub/Sub channels.
  *     -   (Conceptual Pub/Sub subscription for invalidations shown, full handling not implemented in its `onCallback`).
- * 3.  `LogAggregatorActor`:
- *     -   Periodically reads new entries from the "system:logs" Redis Stream using `_redis.xread()`.
- *     -   Processes and displays these log entries.
- *     -   Can also receive `LogEvent`s from other actors to write directly to the stream.
- * 4.  `ClientActor` (multiple instances possible):
+ * 3.  `LogShipperActor` (one per core):
+ *     -   Buffers the `LogEvent`s of the actors on its core; logging never waits on Redis.
+ *     -   Once per event-loop pass, ships the buffer to the "system:logs" Redis Stream as one
+ *         pipeline of asynchronous `xadd()` calls, with a bound on buffered and in-flight entries.
+ * 4.  `LogAggregatorActor`:
+ *     -   Reads the "system:logs" Redis Stream on a dedicated connection with asynchronous
+ *         `xread()` calls of up to 1000 entries, re-armed as soon as a full batch arrives.
+ *     -   Maintains rolling aggregates incrementally (per-level counts, per-component rates)
+ *         and reports them periodically; only WARNING/ERROR entries are echoed one by one.
+ * 5.  `ClientActor` (multiple instances possible):
  *     -   Submits new jobs by `RPUSH`ing them to the "jobs:queue" Redis List.
  *     -   Tracks submitted jobs and can poll Redis Hashes ("job:status", "job:results") for completion.
  *     -   (Alternatively, could subscribe to "job:completed" Pub/Sub channel for notifications).
- * 5.  `CoordinatorActor`:
+ * 6.  `CoordinatorActor`:
  *     -   Initializes and orchestrates the entire system: creates other actors.
  *     -   Its `ActorId` (`g_coordinator_id`) is globally accessible for other actors to send notifications.
  *     -   Manages client and worker registration (conceptually, by tracking their IDs).
@@ -54,6 +59,11 @@
  * - Multi-core actor deployment.
  * - Complex inter-actor and actor-Redis communication patterns.
  * - `qb::string<N>`, `qb::json` (implicitly for stream results), `qb::io::cout()`.
+ *
+ * Several callbacks use synchronous Redis commands (`brpop` with a 1 s timeout) and
+ * `sleep_for`, which block every actor of their core. Every `onCallback()` is watched by the
+ * stall detector (`common/watchdog`): run with `QB_WATCHDOG_MS=50` to get each stall reported
+ * with a stack sample while the system keeps running.
  */
 
 #include <redis/redis.h>
@@ -61,6 +71,10 @@
 #include <qb/main.h>
 #include <qb/io/async.h>
 #include <qb/json.h>
+#include <watchdog/Watchdog.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 #undef ERROR
 #undef DELETE
 
@@ -158,6 +172,7 @@ std::string level_to_string(LogEvent::Level level) {
 
 // Global IDs to track specific actors
 qb::ActorId g_coordinator_id;
+std::vector<qb::ActorId> g_log_shippers; // One LogShipperActor per core, indexed by core id
 
 // =============== Actor Definitions ===============
 
@@ -222,26 +237,15 @@ public:
         }
     }
     
-    // Log an action to Redis streams
+    // Log an action: handed to the log shipper of this core, which batches it into the stream
     void log_action(const std::string& action) {
-        try {
-            // Create log entry
-            std::vector<std::pair<std::string, std::string>> log_entry = {
-                {"worker_id", _worker_id},
-                {"action", action},
-                {"timestamp", std::to_string(std::time(nullptr))}
-            };
-            
-            // Add to log stream, using "*" for auto-generated ID
-            _redis.xadd("system:logs", log_entry);
-        } catch (const std::exception& e) {
-            // Just print but don't fail on logging errors
-            qb::io::cerr() << "Error logging to Redis: " << e.what() << std::endl;
-        }
+        push<LogEvent>(g_log_shippers[getIndex()], LogEvent::Level::INFO,
+                       "worker:" + std::string(_worker_id.c_str()), action);
     }
     
     // Poll for jobs in the queue
     void onCallback() override {
+        QB_WATCHDOG_SCOPE("onCallback");
         if (!_connected || _jobs_processed >= _max_jobs) {
             if (_jobs_processed >= _max_jobs) {
                 qb::io::cout() << "WorkerActor [" << _worker_id << "] reached max jobs, shutting down" << std::endl;
@@ -483,6 +487,7 @@ public:
     }
     
     void onCallback() override {
+        QB_WATCHDOG_SCOPE("onCallback");
         // This callback would handle redis subscription messages
         // For simplicity, we don't implement full subscription handling here
     }
@@ -536,15 +541,134 @@ public:
     }
 };
 
+// Per-core log shipper: buffers LogEvents from the actors of its core and writes them
+// to the log stream in batches. All XADDs of a batch are sent back-to-back on one
+// connection (one pipeline, one network round trip) without waiting for the replies.
+class LogShipperActor : public qb::Actor, public qb::ICallback {
+private:
+    static constexpr std::size_t MAX_BUFFERED = 65536;   // New entries are dropped (and counted) beyond this
+    static constexpr std::size_t MAX_IN_FLIGHT = 4096;   // XADDs awaiting their reply
+    
+    qb::redis::tcp::client _redis;
+    bool _connected = false;
+    bool _stopping = false;
+    std::string _log_stream_key = "system:logs";
+    std::vector<std::vector<std::pair<std::string, std::string>>> _buffer;
+    std::size_t _in_flight = 0;
+    
+    // Shipping statistics
+    uint64_t _shipped = 0;
+    uint64_t _failed = 0;
+    uint64_t _dropped = 0;
+    uint64_t _batches = 0;
+    
+public:
+    LogShipperActor()
+        : _redis(qb::io::uri(REDIS_URI))
+    {
+        // Redis client is initialized in the constructor using member initializer
+    }
+    
+    ~LogShipperActor() noexcept override = default;
+    
+    bool onInit() override {
+        registerEvent<LogEvent>(*this);
+        registerEvent<ShutdownEvent>(*this);
+        registerCallback(*this);
+        
+        try {
+            if (!_redis.connect()) {
+                qb::io::cerr() << "LogShipperActor failed to connect to Redis on core " << getIndex() << std::endl;
+                return false;
+            }
+            _connected = true;
+            qb::io::cout() << "LogShipperActor initialized on core " << getIndex() << std::endl;
+            return true;
+        } catch (const std::exception& e) {
+            qb::io::cerr() << "LogShipperActor initialization error: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    // Buffer only: no Redis I/O happens on the sender's behalf
+    void on(const LogEvent& event) {
+        if (_buffer.size() >= MAX_BUFFERED) {
+            ++_dropped;
+            return;
+        }
+        _buffer.push_back({
+            {"component", event.component},
+            {"level", level_to_string(event.level)},
+            {"message", event.message},
+            {"timestamp", std::to_string(std::time(nullptr))}
+        });
+    }
+    
+    // Ship everything buffered during the last loop pass as one pipelined batch
+    void onCallback() override {
+        QB_WATCHDOG_SCOPE("onCallback");
+        flush();
+        if (_stopping && _buffer.empty() && !_in_flight) {
+            qb::io::cout() << "LogShipperActor [core " << getIndex() << "] shipped " << _shipped
+                 << " entries in " << _batches << " batches (" << _failed << " failed, "
+                 << _dropped << " dropped)" << std::endl;
+            unregisterCallback(*this);
+            kill();
+        }
+    }
+    
+    void flush() {
+        if (!_connected || _buffer.empty() || _in_flight >= MAX_IN_FLIGHT)
+            return;
+        
+        const std::size_t count = std::min(_buffer.size(), MAX_IN_FLIGHT - _in_flight);
+        for (std::size_t i = 0; i < count; ++i) {
+            ++_in_flight;
+            _redis.xadd([this](auto&& reply) {
+                --_in_flight;
+                if (reply.ok())
+                    ++_shipped;
+                else
+                    ++_failed;
+            }, _log_stream_key, _buffer[i]);
+        }
+        _buffer.erase(_buffer.begin(), _buffer.begin() + count);
+        ++_batches;
+    }
+    
+    // Keep running a little longer: the actors of this core still log their shutdown
+    void on(const ShutdownEvent&) {
+        if (_stopping) return;
+        qb::io::async::callback([this]() { _stopping = true; }, 0.5);
+    }
+};
+
 // Log aggregator actor for centralized logging
-class LogAggregatorActor : public qb::Actor, public qb::ICallback {
+// Reads the log stream on its own connection, in large batches, and keeps rolling
+// aggregates (per-level counts, per-component rates) updated entry by entry.
+class LogAggregatorActor : public qb::Actor {
 private:
-    // Redis client
+    static constexpr std::size_t READ_COUNT = 1000;  // Entries per XREAD
+    static constexpr double IDLE_WAIT = 0.05;        // Seconds before re-reading an idle stream
+    static constexpr double REPORT_PERIOD = 1.0;     // Seconds between aggregate reports
+    
+    // Dedicated connection: only the stream reads go through it
     qb::redis::tcp::client _redis;
     bool _connected = false;
+    bool _stopping = false;
     std::string _log_stream_key = "system:logs";
     std::string _last_id = "0";  // Start from the beginning
     
+    // Rolling aggregates
+    std::unordered_map<std::string, uint64_t> _level_counts;
+    struct ComponentStats {
+        uint64_t total = 0;
+        uint64_t at_last_report = 0;
+    };
+    std::unordered_map<std::string, ComponentStats> _component_stats;
+    uint64_t _total_entries = 0;
+    uint64_t _entries_at_last_report = 0;
+    
 public:
     LogAggregatorActor() 
         : _redis(qb::io::uri(REDIS_URI))
@@ -557,10 +681,8 @@ public:
     bool onInit() override {
         qb::io::cout() << "LogAggregatorActor initialized on core " << getIndex() << std::endl;
         
-        // Register for events and callbacks
-        registerEvent<LogEvent>(*this);
+        // Register for events
         registerEvent<ShutdownEvent>(*this);
-        registerCallback(*this);
         
         // Connect to Redis
         try {
@@ -575,18 +697,19 @@ public:
             
             // Initialize the log stream with a special entry
             std::vector<std::pair<std::string, std::string>> init_entry = {
-                {"source", "system"},
+                {"component", "system"},
                 {"level", "INFO"},
                 {"message", "Log system initialized"},
                 {"timestamp", std::to_string(std::time(nullptr))}
             };
             
-            // Add initialization entry to the stream - exactly like example7
             auto stream_id = _redis.xadd(_log_stream_key, init_entry);
             
             qb::io::cout() << "LogAggregatorActor initialized log stream with ID: " 
                  << stream_id.to_string() << std::endl;
             
+            readNext();
+            scheduleReport();
             return true;
         } catch (const std::exception& e) {
             qb::io::cerr() << "LogAggregatorActor initialization error: " << e.what() << std::endl;
@@ -594,159 +717,113 @@ public:
         }
     }
     
-    // Poll for new log entries and process them
-    void onCallback() override {
-        if (!_connected) return;
+    // One XREAD is always outstanding: a full batch re-arms the read at once, an empty
+    // one waits IDLE_WAIT on the event loop (the equivalent of XREAD BLOCK, but the
+    // actor keeps serving events while it waits).
+    void readNext() {
+        if (_stopping) return;
         
-        try {
-            // Read from the log stream exactly like example7
-            auto results = _redis.xread({_log_stream_key}, {_last_id}, 10);
-            
-            // If results are empty, nothing to do
-            if (results.empty() || results.is_null()) {
-                return;
+        _redis.xread([this](auto&& reply) {
+            std::size_t consumed = 0;
+            if (reply.ok()) {
+                consumed = consume(reply.result());
+            } else {
+                qb::io::cerr() << "LogAggregatorActor error reading stream" << std::endl;
             }
             
-            // Debug output
-            // qb::io::cout() << "COMPLETE JSON DUMP: " << results.dump(2) << std::endl;
-            // qb::io::cout() << "Stream results type: " << results.type_name() << std::endl;
+            if (consumed == READ_COUNT)
+                readNext();
+            else
+                qb::io::async::callback([this]() { readNext(); }, IDLE_WAIT);
+        }, {_log_stream_key}, {_last_id}, READ_COUNT);
+    }
+    
+    // Fold a batch of entries into the aggregates; returns the number of entries read
+    std::size_t consume(const qb::json& results) {
+        std::size_t consumed = 0;
+        if (!results.is_array())
+            return consumed;
+        
+        // Results are [{stream: [{id: {fields}}, ...]}]
+        for (const auto& stream_obj : results) {
+            auto stream = stream_obj.find(_log_stream_key);
+            if (stream == stream_obj.end())
+                continue;
             
-            // Process the results exactly like example7 StreamConsumerActor does
-            if (results.is_array() && !results.empty()) {
-                // Process each stream in the response
-                for (const auto& stream_obj : results) {
-                    // Iterate through stream keys and entries
-                    for (auto it = stream_obj.begin(); it != stream_obj.end(); ++it) {
-                        // Get stream name
-                        std::string stream_name = it.key();
-                        
-                        // Skip if not our stream
-                        if (stream_name != _log_stream_key) continue;
-                        
-                        // Get messages array
-                        const auto& messages = it.value();
-                        
-                        // Process each message
-                        for (const auto& msg_entry : messages) {
-                            // Each msg_entry is like {"id":{fields}}
-                            for (auto msg_it = msg_entry.begin(); msg_it != msg_entry.end(); ++msg_it) {
-                                // Get message ID
-                                std::string message_id = msg_it.key();
-                                
-                                // Update last seen ID
-                                _last_id = message_id;
-                                
-                                // Get fields
-                                const auto& fields = msg_it.value();
-                                
-                                // Skip if not an object
-                                if (!fields.is_object()) continue;
-                                
-                                // Extract fields
-                                std::string component = "unknown";
-                                std::string level = "INFO";
-                                std::string message = "";
-                                
-                                if (fields.contains("component")) {
-                                    std::string comp = fields["component"].dump();
-                                    // Remove quotes if present
-                                    if (comp.front() == '"' && comp.back() == '"') {
-                                        comp = comp.substr(1, comp.size() - 2);
-                                    }
-                                    component = comp;
-                                } else if (fields.contains("worker_id")) {
-                                    std::string worker = fields["worker_id"].dump();
-                                    if (worker.front() == '"' && worker.back() == '"') {
-                                        worker = worker.substr(1, worker.size() - 2);
-                                    }
-                                    component = "worker:" + worker;
-                                } else if (fields.contains("source")) {
-                                    std::string src = fields["source"].dump();
-                                    if (src.front() == '"' && src.back() == '"') {
-                                        src = src.substr(1, src.size() - 2);
-                                    }
-                                    component = src;
-                                }
-                                
-                                if (fields.contains("level")) {
-                                    std::string lvl = fields["level"].dump();
-                                    if (lvl.front() == '"' && lvl.back() == '"') {
-                                        lvl = lvl.substr(1, lvl.size() - 2);
-                                    }
-                                    level = lvl;
-                                }
-                                
-                                if (fields.contains("message")) {
-                                    std::string msg = fields["message"].dump();
-                                    if (msg.front() == '"' && msg.back() == '"') {
-                                        msg = msg.substr(1, msg.size() - 2);
-                                    }
-                                    message = msg;
-                                } else if (fields.contains("action")) {
-                                    std::string act = fields["action"].dump();
-                                    if (act.front() == '"' && act.back() == '"') {
-                                        act = act.substr(1, act.size() - 2);
-                                    }
-                                    message = act;
-                                }
-                                
-                                // Display log message
-                                qb::io::cout() << "[LOG] [" << level << "] [" << component << "] " 
-                                     << message << " (ID: " << message_id << ")" << std::endl;
-                            }
-                        }
+            for (const auto& msg_entry : *stream) {
+                for (auto msg_it = msg_entry.begin(); msg_it != msg_entry.end(); ++msg_it) {
+                    _last_id = msg_it.key();
+                    ++consumed;
+                    
+                    const auto& fields = msg_it.value();
+                    if (!fields.is_object())
+                        continue;
+                    
+                    const std::string level = field(fields, "level", "INFO");
+                    const std::string component = field(fields, "component", "unknown");
+                    
+                    ++_total_entries;
+                    ++_level_counts[level];
+                    ++_component_stats[component].total;
+                    
+                    // Only problems are echoed one by one; everything else shows up in the report
+                    if (level == "WARNING" || level == "ERROR") {
+                        qb::io::cout() << "[LOG] [" << level << "] [" << component << "] " 
+                             << field(fields, "message", "") << " (ID: " << _last_id << ")" << std::endl;
                     }
                 }
             }
-        } catch (const std::exception& e) {
-            qb::io::cerr() << "LogAggregatorActor error reading stream: " << e.what() << std::endl;
         }
+        return consumed;
     }
     
-    void on(const LogEvent& event) {
-        if (!_connected) return;
+    static std::string field(const qb::json& fields, const char* name, const char* fallback) {
+        auto it = fields.find(name);
+        if (it == fields.end())
+            return fallback;
+        return it->is_string() ? it->template get<std::string>() : it->dump();
+    }
+    
+    void scheduleReport() {
+        qb::io::async::callback([this]() {
+            if (_stopping) return;
+            report();
+            scheduleReport();
+        }, REPORT_PERIOD);
+    }
+    
+    // Rates are derived from the counters kept so far, nothing is re-scanned
+    void report() {
+        if (_total_entries == _entries_at_last_report)
+            return;
         
-        try {
-            // Create log entry fields exactly like in example7
-            std::vector<std::pair<std::string, std::string>> log_entry = {
-                {"component", event.component},
-                {"level", level_to_string(event.level)},
-                {"message", event.message},
-                {"timestamp", std::to_string(std::time(nullptr))}
-            };
-            
-            // Add to log stream - pattern from example7
-            auto id = _redis.xadd(_log_stream_key, log_entry);
-            
-            qb::io::cout() << "LogAggregatorActor: Added log to stream with ID: " 
-                 << id.to_string() << std::endl;
-        } catch (const std::exception& e) {
-            qb::io::cerr() << "LogAggregatorActor error adding to stream: " << e.what() << std::endl;
+        qb::io::cout() << "[LOG] " << (_total_entries - _entries_at_last_report) / REPORT_PERIOD
+             << " entries/s, " << _total_entries << " total |";
+        for (const auto& [level, count] : _level_counts)
+            qb::io::cout() << " " << level << "=" << count;
+        qb::io::cout() << std::endl;
+        
+        for (auto& [component, stats] : _component_stats) {
+            if (stats.total == stats.at_last_report)
+                continue;
+            qb::io::cout() << "[LOG]   " << component << ": "
+                 << (stats.total - stats.at_last_report) / REPORT_PERIOD << " entries/s ("
+                 << stats.total << " total)" << std::endl;
+            stats.at_last_report = stats.total;
         }
+        _entries_at_last_report = _total_entries;
     }
     
     void on(const ShutdownEvent&) {
+        if (_stopping) return;
         qb::io::cout() << "LogAggregatorActor shutting down" << std::endl;
         
-        try {
-            // Add a final log entry
-            std::vector<std::pair<std::string, std::string>> log_entry = {
-                {"source", "system"},
-                {"level", "INFO"},
-                {"message", "Log system shutting down"},
-                {"timestamp", std::to_string(std::time(nullptr))}
-            };
-            
-            _redis.xadd(_log_stream_key, log_entry);
-        } catch (...) {
-            // Ignore errors during shutdown
-        }
-        
-        // Unregister callback
-        unregisterCallback(*this);
-        
-        // Clean up
-        kill();
+        // Let the shippers drain their last batches into the stream before the final report
+        qb::io::async::callback([this]() {
+            _stopping = true;
+            report();
+            kill();
+        }, 1.0);
     }
 };
 
@@ -813,6 +890,7 @@ public:
     }
     
     void onCallback() override {
+        QB_WATCHDOG_SCOPE("onCallback");
         if (_shutting_down) return;
         
         // Submit jobs if we haven't reached the total
@@ -981,9 +1059,6 @@ private:
 
     // For metrics display
     unsigned int _display_counter = 0;
-    
-    // Log aggregator ID for sending logs
-    qb::ActorId _log_aggregator_id;
 
 public:
     CoordinatorActor(int num_clients = 2) : _expected_clients(num_clients) {}
@@ -1049,6 +1124,7 @@ public:
     }
     
     void onCallback() override {
+        QB_WATCHDOG_SCOPE("onCallback");
         if (!_connected) return;
         
         // Limit metrics display frequency
@@ -1102,11 +1178,9 @@ public:
         qb::io::cout() << "Coordinator received job creation notification of type: " 
              << event.job_type << std::endl;
         
-        // Log the job creation if log aggregator is set
-        if (_log_aggregator_id != qb::ActorId()) {
-            push<LogEvent>(_log_aggregator_id, LogEvent::Level::INFO, "coordinator", 
-                      "New job created of type " + event.job_type);
-        }
+        // Log the job creation through the log shipper of this core
+        push<LogEvent>(g_log_shippers[getIndex()], LogEvent::Level::INFO, "coordinator", 
+                  "New job created of type " + event.job_type);
     }
     
     void on(const JobCompletedEvent& event) {
@@ -1115,12 +1189,10 @@ public:
         qb::io::cout() << "Coordinator received job completion notification for " 
              << event.job_id << " (success: " << (event.success ? "true" : "false") << ")" << std::endl;
         
-        // Log the job completion if log aggregator is set
-        if (_log_aggregator_id != qb::ActorId()) {
-            push<LogEvent>(_log_aggregator_id, LogEvent::Level::INFO, "coordinator", 
-                      "Job " + event.job_id + " completed with status: " + 
-                      (event.success ? "success" : "failure"));
-        }
+        // Log the job completion through the log shipper of this core
+        push<LogEvent>(g_log_shippers[getIndex()], LogEvent::Level::INFO, "coordinator", 
+                  "Job " + event.job_id + " completed with status: " + 
+                  (event.success ? "success" : "failure"));
     }
     
     void on(const ShutdownEvent&) {
@@ -1149,9 +1221,7 @@ public:
         qb::io::cout() << "Coordinator initiating system shutdown" << std::endl;
         
         // Log the shutdown
-        if (_log_aggregator_id != qb::ActorId()) {
-            push<LogEvent>(_log_aggregator_id, LogEvent::Level::INFO, "coordinator", "System shutdown initiated");
-        }
+        push<LogEvent>(g_log_shippers[getIndex()], LogEvent::Level::INFO, "coordinator", "System shutdown initiated");
         
         // Wait a moment to let final logs be processed
         std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -1200,11 +1270,6 @@ public:
             qb::io::cerr() << "Error displaying statistics: " << e.what() << std::endl;
         }
     }
-
-    // Set the log aggregator ID for sending logs
-    void setLogAggregatorId(qb::ActorId id) {
-        _log_aggregator_id = id;
-    }
 };
 
 // Main function to set up the example
@@ -1217,6 +1282,12 @@ int main(int, char**) {
     // Create the engine
     qb::Main engine;
     
+    // One log shipper per core, created first so its id is known to the other actors
+    g_log_shippers.resize(3);
+    for (qb::CoreId core = 0; core < 3; ++core) {
+        g_log_shippers[core] = engine.addActor<LogShipperActor>(core);
+    }
+    
     // Create actors on specific cores
     // Core 0 - coordinator and system services
     engine.addActor<CoordinatorActor>(0);
@@ -1231,9 +1302,13 @@ int main(int, char**) {
     engine.addActor<ClientActor>(2, "client1", 50);
     engine.addActor<ClientActor>(2, "client2", 50);
     
+    // Report callbacks that block a core (brpop, sleeps) when QB_WATCHDOG_MS is set
+    watchdog::Watchdog::instance().startFromEnv();
+    
     // Run the example - the actors will find each other via g_coordinator_id
     engine.start();
     engine.join();
+    watchdog::Watchdog::instance().stop();
     
     qb::io::cout() << "Complex Redis Actor System Example completed" << std::endl;
     
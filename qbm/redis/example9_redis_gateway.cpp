@@ -0,0 +1,363 @@
+/**
+ * @file examples/qbm/redis/example9_redis_gateway.cpp
+ * @example qbm-redis: Per-Core Redis Gateway with Command Coalescing
+ *
+ * @brief This example replaces the "one `qb::redis::tcp::client` per actor" pattern used
+ * by the other examples with a per-core gateway actor that multiplexes the commands of
+ * many actors onto a few pipelined connections.
+ *
+ * @details
+ * The system is composed of the following actors:
+ * 1.  `RedisGatewayActor` (one per core):
+ *     -   Owns a small, fixed set of `qb::redis::tcp::client` connections.
+ *     -   Receives `RedisCommandEvent`s from any actor on its core and queues them.
+ *     -   Once per event-loop pass (`qb::ICallback::onCallback()`), flushes everything queued
+ *         during that pass: commands are spread round-robin over the connections using the
+ *         callback-based asynchronous API of `qbm-redis`, so each connection gets one write
+ *         carrying many pipelined commands instead of one write per command.
+ *     -   Replies arrive in order on each connection; each reply is routed back to the actor
+ *         that sent the command as a `RedisReplyEvent`, matched by ticket.
+ * 2.  `GatewayClientActor` (many per core):
+ *     -   Keeps a fixed window of commands (`INCR`, `SET`, `GET`) outstanding through the gateway
+ *         and never touches a Redis connection itself.
+ * 3.  `DirectClientActor` (many per core, baseline):
+ *     -   The pattern of the other examples: its own `qb::redis::tcp::client` and one
+ *         synchronous command at a time.
+ * 4.  `BenchReporterActor`:
+ *     -   Collects the per-client operation counts and prints ops/sec and the number of
+ *         connections the process opened to redis-server.
+ *
+ * Running both modes with the same number of client actors shows the connection count
+ * dropping from one per actor to a few per core, and the throughput gained from pipelining.
+ *
+ * QB/QBM Redis Features Demonstrated:
+ * - `qb::Actor`, `qb::Main`, `qb::Event`, `qb::ICallback` (once-per-loop-pass flush).
+ * - `qb::redis::tcp::client` asynchronous commands with reply callbacks
+ *   (`client.incr(cb, key)`, `client.set(cb, key, value)`, `client.get(cb, key)`).
+ * - Event-based request/reply between actors on the same core.
+ * - Multi-core deployment, `qb::io::cout()`.
+ */
+
+#include <redis/redis.h>
+#include <qb/actor.h>
+#include <qb/main.h>
+#include <qb/io.h>
+#include <qb/io/async.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Redis Configuration - must be in initializer list format
+#define REDIS_URI {"tcp://localhost:6379"}
+
+// Commands supported by the gateway
+enum class RedisOp { GET, SET, INCR, DEL };
+
+// Actor -> gateway: one Redis command
+struct RedisCommandEvent : qb::Event {
+    uint64_t ticket;
+    RedisOp op;
+    std::string key;
+    std::string value; // SET only
+
+    RedisCommandEvent(uint64_t t, RedisOp o, std::string k, std::string v = {})
+        : ticket(t), op(o), key(std::move(k)), value(std::move(v)) {}
+};
+
+// Gateway -> actor: the reply of one command
+struct RedisReplyEvent : qb::Event {
+    uint64_t ticket;
+    bool ok;
+    std::string value;   // GET result (empty when the key is missing)
+    long long integer;   // INCR / DEL result
+
+    RedisReplyEvent(uint64_t t, bool o, std::string v, long long i)
+        : ticket(t), ok(o), value(std::move(v)), integer(i) {}
+};
+
+// Client -> reporter: operations completed during the run
+struct BenchReportEvent : qb::Event {
+    uint64_t ops;
+    uint64_t errors;
+    BenchReportEvent(uint64_t o, uint64_t e) : ops(o), errors(e) {}
+};
+
+// Per-core gateway multiplexing many actors onto a few pipelined connections
+class RedisGatewayActor : public qb::Actor, public qb::ICallback {
+private:
+    struct PendingCommand {
+        qb::ActorId requester;
+        uint64_t ticket;
+        RedisOp op;
+        std::string key;
+        std::string value;
+    };
+
+    std::vector<std::unique_ptr<qb::redis::tcp::client>> _connections;
+    std::vector<PendingCommand> _pending; // Commands received during the current loop pass
+    std::size_t _next_connection = 0;
+    std::size_t _connection_count;
+    uint64_t _flushes = 0;
+    uint64_t _commands = 0;
+
+public:
+    explicit RedisGatewayActor(std::size_t connections)
+        : _connection_count(connections) {}
+
+    bool onInit() override {
+        registerEvent<RedisCommandEvent>(*this);
+        registerEvent<qb::KillEvent>(*this);
+
+        for (std::size_t i = 0; i < _connection_count; ++i) {
+            auto client = std::make_unique<qb::redis::tcp::client>(qb::io::uri REDIS_URI);
+            if (!client->connect()) {
+                qb::io::cerr() << "RedisGateway: connection #" << i << " failed" << std::endl;
+                return false;
+            }
+            _connections.push_back(std::move(client));
+        }
+        registerCallback(*this);
+
+        qb::io::cout() << "RedisGatewayActor [" << id() << "] on core " << getIndex()
+                       << " with " << _connections.size() << " connection(s)" << std::endl;
+        return true;
+    }
+
+    void on(RedisCommandEvent& event) {
+        _pending.push_back({event.getSource(), event.ticket, event.op, std::move(event.key), std::move(event.value)});
+    }
+
+    // Called once per event-loop pass: everything queued since the last pass leaves together.
+    void onCallback() override {
+        if (_pending.empty())
+            return;
+
+        ++_flushes;
+        _commands += _pending.size();
+        for (auto& command : _pending) {
+            auto& redis = *_connections[_next_connection];
+            _next_connection = (_next_connection + 1) % _connections.size();
+            issue(redis, std::move(command));
+        }
+        _pending.clear();
+    }
+
+    void on(const qb::KillEvent&) {
+        if (_flushes)
+            qb::io::cout() << "RedisGateway [" << id() << "] sent " << _commands << " commands in "
+                           << _flushes << " flushes (" << (_commands / _flushes) << " per flush)" << std::endl;
+        unregisterCallback(*this);
+        kill();
+    }
+
+private:
+    void issue(qb::redis::tcp::client& redis, PendingCommand&& command) {
+        const auto requester = command.requester;
+        const auto ticket = command.ticket;
+
+        switch (command.op) {
+            case RedisOp::GET:
+                redis.get([this, requester, ticket](auto&& reply) {
+                    const auto& value = reply.result();
+                    push<RedisReplyEvent>(requester, ticket, reply.ok(), value ? std::string(*value) : std::string(), 0LL);
+                }, command.key);
+                break;
+            case RedisOp::SET:
+                redis.set([this, requester, ticket](auto&& reply) {
+                    push<RedisReplyEvent>(requester, ticket, reply.ok(), std::string(), 0LL);
+                }, command.key, command.value);
+                break;
+            case RedisOp::INCR:
+                redis.incr([this, requester, ticket](auto&& reply) {
+                    push<RedisReplyEvent>(requester, ticket, reply.ok(), std::string(),
+                                          reply.ok() ? static_cast<long long>(reply.result()) : 0LL);
+                }, command.key);
+                break;
+            case RedisOp::DEL:
+                redis.del([this, requester, ticket](auto&& reply) {
+                    push<RedisReplyEvent>(requester, ticket, reply.ok(), std::string(),
+                                          reply.ok() ? static_cast<long long>(reply.result()) : 0LL);
+                }, command.key);
+                break;
+        }
+    }
+};
+
+// Keeps a window of commands outstanding through the gateway of its core
+class GatewayClientActor : public qb::Actor {
+private:
+    qb::ActorId _gateway;
+    qb::ActorId _reporter;
+    std::size_t _window;
+    double _duration;
+    std::string _key;
+    bool _running = true;
+    uint64_t _next_ticket = 0;
+    uint64_t _ops = 0;
+    uint64_t _errors = 0;
+
+public:
+    GatewayClientActor(qb::ActorId gateway, qb::ActorId reporter, std::size_t window, double duration, std::string key)
+        : _gateway(gateway), _reporter(reporter), _window(window), _duration(duration), _key(std::move(key)) {}
+
+    bool onInit() override {
+        registerEvent<RedisReplyEvent>(*this);
+        registerEvent<qb::KillEvent>(*this);
+
+        for (std::size_t i = 0; i < _window; ++i)
+            submit();
+        qb::io::async::callback([this]() {
+            _running = false;
+            push<BenchReportEvent>(_reporter, _ops, _errors);
+        }, _duration);
+        return true;
+    }
+
+    void on(const RedisReplyEvent& event) {
+        if (event.ok)
+            ++_ops;
+        else
+            ++_errors;
+        if (_running)
+            submit();
+    }
+
+    void on(const qb::KillEvent&) {
+        kill();
+    }
+
+private:
+    void submit() {
+        const auto ticket = ++_next_ticket;
+        switch (ticket % 3) {
+            case 0: push<RedisCommandEvent>(_gateway, ticket, RedisOp::INCR, _key + ":counter"); break;
+            case 1: push<RedisCommandEvent>(_gateway, ticket, RedisOp::SET, _key + ":value", std::to_string(ticket)); break;
+            default: push<RedisCommandEvent>(_gateway, ticket, RedisOp::GET, _key + ":value"); break;
+        }
+    }
+};
+
+// Baseline: its own connection and one synchronous command at a time
+class DirectClientActor : public qb::Actor, public qb::ICallback {
+private:
+    qb::redis::tcp::client _redis{REDIS_URI};
+    qb::ActorId _reporter;
+    double _duration;
+    std::string _key;
+    bool _running = true;
+    uint64_t _ops = 0;
+
+public:
+    DirectClientActor(qb::ActorId reporter, double duration, std::string key)
+        : _reporter(reporter), _duration(duration), _key(std::move(key)) {}
+
+    bool onInit() override {
+        registerEvent<qb::KillEvent>(*this);
+        if (!_redis.connect()) {
+            qb::io::cerr() << "DirectClient: failed to connect to Redis" << std::endl;
+            return false;
+        }
+        registerCallback(*this);
+        qb::io::async::callback([this]() {
+            _running = false;
+            unregisterCallback(*this);
+            push<BenchReportEvent>(_reporter, _ops, 0);
+        }, _duration);
+        return true;
+    }
+
+    void onCallback() override {
+        if (!_running)
+            return;
+        switch (++_ops % 3) {
+            case 0: _redis.incr(_key + ":counter"); break;
+            case 1: _redis.set(_key + ":value", std::to_string(_ops)); break;
+            default: _redis.get(_key + ":value"); break;
+        }
+    }
+
+    void on(const qb::KillEvent&) {
+        kill();
+    }
+};
+
+// Sums the reports and stops the engine
+class BenchReporterActor : public qb::Actor {
+private:
+    std::size_t _expected;
+    std::size_t _received = 0;
+    std::size_t _connections;
+    double _duration;
+    const char* _mode;
+    uint64_t _ops = 0;
+    uint64_t _errors = 0;
+
+public:
+    BenchReporterActor(std::size_t clients, std::size_t connections, double duration, const char* mode)
+        : _expected(clients), _connections(connections), _duration(duration), _mode(mode) {}
+
+    bool onInit() override {
+        registerEvent<BenchReportEvent>(*this);
+        return true;
+    }
+
+    void on(const BenchReportEvent& event) {
+        _ops += event.ops;
+        _errors += event.errors;
+        if (++_received < _expected)
+            return;
+
+        qb::io::cout() << "\n=== Redis " << _mode << " benchmark ===" << std::endl
+                       << "Client actors      : " << _expected << std::endl
+                       << "Redis connections  : " << _connections << std::endl
+                       << "Operations         : " << _ops << " (" << _errors << " errors)" << std::endl
+                       << "Throughput         : " << static_cast<uint64_t>(_ops / _duration) << " ops/sec" << std::endl;
+        broadcast<qb::KillEvent>();
+        kill();
+    }
+};
+
+int main(int argc, char* argv[]) {
+    // Usage: example9_redis_gateway [gateway|direct] [cores] [clients_per_core] [connections_per_core] [seconds]
+    const std::string mode = argc > 1 ? argv[1] : "gateway";
+    const std::size_t cores = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+    const std::size_t clients_per_core = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 200;
+    // At least one connection per gateway; the report shows the count actually opened
+    const std::size_t connections_per_core = std::max<std::size_t>(1, argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 2);
+    const double duration = argc > 5 ? std::strtod(argv[5], nullptr) : 5.0;
+    constexpr std::size_t WINDOW = 4; // Outstanding commands per gateway client
+
+    // Initialize the async system
+    qb::io::async::init();
+
+    const bool use_gateway = mode != "direct";
+    const auto total_clients = cores * clients_per_core;
+
+    qb::Main engine;
+    const auto reporter = engine.addActor<BenchReporterActor>(
+        0, total_clients, use_gateway ? cores * connections_per_core : total_clients, duration,
+        use_gateway ? "gateway" : "direct");
+
+    for (std::size_t core = 0; core < cores; ++core) {
+        const auto core_id = static_cast<qb::CoreId>(core);
+        if (use_gateway) {
+            const auto gateway = engine.addActor<RedisGatewayActor>(core_id, connections_per_core);
+            for (std::size_t c = 0; c < clients_per_core; ++c)
+                engine.addActor<GatewayClientActor>(core_id, gateway, reporter, WINDOW, duration,
+                                                    "gw:" + std::to_string(core) + ":" + std::to_string(c));
+        } else {
+            for (std::size_t c = 0; c < clients_per_core; ++c)
+                engine.addActor<DirectClientActor>(core_id, reporter, duration,
+                                                   "direct:" + std::to_string(core) + ":" + std::to_string(c));
+        }
+    }
+
+    engine.start();
+    engine.join();
+
+    qb::io::cout() << "Redis gateway example finished." << std::endl;
+    return engine.hasError() ? 1 : 0;
+}
@@ -26,6 +26,7 @@
 #include <http/middleware/static_files.h>
 #include <http/middleware/cors.h>
 #include <http/middleware/logging.h>
+#include <placement/Placement.h>
 
 // Forward declarations
 class HttpServer;
@@ -599,13 +600,19 @@ int main(int argc, char* argv[]) {
     qb::Main engine;
     
     auto [static_root, port] = parse_command_line_arguments(argc, argv);
+    // Cores of the two servers, overridable with --place role=CORE or --placement FILE
+    auto placement = placement::Placement::fromArgs({
+        {"chat", 1, "0"},
+        {"http", 1, "0"},
+    }, argc, argv);
     
     std::cout << "QB Separated HTTP/WebSocket Chat Server Configuration:\n";
     std::cout << "  Port: " << port << "\n";
     std::cout << "  Static files: " << static_root << "\n\n";
     
-    auto chat_server_id = engine.addActor<ChatServer>(0);
-    engine.addActor<HttpServer>(0, static_root, port, chat_server_id);
+    auto chat_server_id = engine.addActor<ChatServer>(placement.core("chat"));
+    engine.addActor<HttpServer>(placement.core("http"), static_root, port, chat_server_id);
+    placement.pin(engine);
     
     engine.start();
     print_server_info(port);
@@ -637,6 +644,8 @@ std::pair<std::string, uint16_t> parse_command_line_arguments(int argc, char* ar
             std::cout << "Options:\n";
             std::cout << "  --port PORT          Set server port (default: 8080)\n";
             std::cout << "  --static-root PATH   Set static files directory (default: ./resources/chat)\n";
+            std::cout << "  --place ROLE=SPEC    Core of the chat or http server, e.g. chat=1 (default: 0)\n";
+            std::cout << "  --placement FILE     Read role = spec lines from FILE\n";
             std::cout << "  --help, -h           Show this help message\n";
             exit(0);
         }